@@ -0,0 +1,406 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../controller/controlChannel.hpp"
+#include "../controller/gameJournal.hpp"
+#include "../controller/replayVerifier.hpp"
+#include "../controller/tournament.hpp"
+#include "../retro_games/gameEngine.hpp"
+#include "../retro_games/snake/snakeArena.hpp"
+#include "../retro_games/snake/snakeBot.hpp"
+#include "../retro_games/snake/snakeLogic.hpp"
+#include "../retro_games/tetris/tetrisBot.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+#include "../retro_games/tetris/tetrisVersus.hpp"
+#include "../retro_games/vectorEnv.hpp"
+
+using namespace s21;
+using namespace std::chrono;
+
+// Throughput of engines and tools. Numbers depend on machine and build,
+// so they are printed here and are not checked by tests.
+
+static int64_t elapsedNs(steady_clock::time_point start) {
+  return duration_cast<nanoseconds>(steady_clock::now() - start).count();
+}
+
+static void saveLoad() {
+  TetrisLogic game;
+  game.userInput(UserAction_t::Start, false);
+  GameState_t state;
+  const int count = 100000;
+
+  auto start = steady_clock::now();
+  for (int i = 0; i < count; i++) {
+    game.saveState(state);
+    game.loadState(state);
+  }
+  std::cout << "save and load: " << elapsedNs(start) / count << " ns"
+            << std::endl;
+}
+
+// journal of several checkpoints is replayed into new game
+static void journalRestore() {
+  std::string path =
+      "/tmp/retro_games_" + std::to_string(getpid()) + "_bench.db";
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Action,
+                                  UserAction_t::Right, UserAction_t::Down};
+  {
+    GameJournal journal;
+    if (!journal.open(path, 64)) return;
+    TetrisLogic game;
+    game.setSeed(3);
+    journal.checkpoint(game);
+    journal.userInput(game, UserAction_t::Start, false);
+    for (int i = 0; i < 500; i++) {
+      if (i % 3 == 0) {
+        journal.userInput(game, actions[(i / 3) % 4], false);
+      }
+      journal.gameTick(game);
+    }
+  }
+
+  GameJournal reopened;
+  TetrisLogic restored;
+  bool isRestored = reopened.open(path, 64);
+  auto start = steady_clock::now();
+  isRestored = isRestored && reopened.restore(restored);
+  int64_t time = elapsedNs(start);
+  reopened.close();
+  unlink(path.c_str());
+  if (isRestored) {
+    std::cout << "journal restore: " << time / 1000 << " us" << std::endl;
+  }
+}
+
+// one game of bot until it is over or out of actions
+static void tetrisBot() {
+  TetrisBot bot;
+  TetrisLogic game;
+  game.setSeed(11);
+  UserAction_t action;
+  int count = 0;
+
+  auto start = steady_clock::now();
+  while (count < 20000 && bot.nextAction(game, action)) {
+    if (action == UserAction_t::Start && count > 0) break;
+    game.userInput(action, false);
+    count++;
+  }
+  std::cout << "tetris bot: " << count << " actions, score "
+            << game.getGameInfo().score << ", " << elapsedNs(start) / 1000000
+            << " ms" << std::endl;
+}
+
+// fastest level of snake ticks every 100 ms, move must take much less
+static void snakeBot() {
+  SnakeBot bot;
+  SnakeLogic game;
+  game.setSeed(17);
+  UserAction_t action;
+  int games = 0;
+  int bestScore = 0;
+  int actions = 0;
+
+  auto start = steady_clock::now();
+  for (; actions < 20000 && games < 3 && bot.nextAction(game, action);
+       actions++) {
+    if (action == UserAction_t::Start && actions > 0) games++;
+    game.userInput(action, false);
+    bestScore = std::max(bestScore, game.getGameInfo().score);
+  }
+  std::cout << "snake bot: " << actions << " moves, best score " << bestScore
+            << ", " << elapsedNs(start) / 1000 / std::max(actions, 1)
+            << " us per move" << std::endl;
+}
+
+// solver goes by cycle until snake fills the field
+static void snakeSolver() {
+  SnakeBot bot(SnakeBot::Mode::CYCLE);
+  SnakeLogic game;
+  game.setSeed(1);
+  UserAction_t action;
+  game.userInput(UserAction_t::Start, false);
+  int moves = 0;
+
+  auto start = steady_clock::now();
+  for (; moves < 100000 && game.getCurrentGameStatus() == GameStatus::GAME &&
+         bot.nextAction(game, action);
+       moves++) {
+    game.userInput(action, false);
+  }
+  std::cout << "snake solver: " << moves << " moves to full field, "
+            << elapsedNs(start) / 1000000 << " ms" << std::endl;
+}
+
+// random actions in batch of games on all cores
+static void vectorEnv() {
+  const int count = 256;
+  const int steps = 200;
+  VectorEnv<TetrisLogic> env(count);
+  std::vector<uint64_t> seeds(count);
+  for (int i = 0; i < count; i++) {
+    seeds[i] = 1000 + i;
+  }
+  env.reset(seeds.data());
+
+  RandomGenerator random(1);
+  std::vector<UserAction_t> actions(count);
+  std::vector<uint8_t> observations(count * FIELD_HEIGHT * FIELD_WIDTH);
+  int dones = 0;
+  auto start = steady_clock::now();
+  for (int step = 0; step < steps; step++) {
+    for (auto& action : actions) {
+      action = static_cast<UserAction_t>(
+          static_cast<int>(UserAction_t::Left) + random.next(6));
+    }
+    env.step(actions.data());
+    env.observe(observations.data());
+    for (int i = 0; i < count; i++) {
+      dones += env.getDones()[i];
+    }
+  }
+  int64_t us = std::max<int64_t>(1, elapsedNs(start) / 1000);
+  std::cout << "vector env: " << count * steps << " steps, "
+            << static_cast<int64_t>(count) * steps * 1000000 / us
+            << " steps per second, " << dones << " games ended" << std::endl;
+}
+
+// command and its ack through shared memory, loop of controller sleeps
+// 10 ms between iterations and is woken by commands
+static void controlRoundTrip() {
+  std::string name = "/retro_games_bench_" + std::to_string(getpid());
+  ControlChannel channel;
+  ControlClient client;
+  if (!channel.open(name) || !client.open(name)) return;
+  TetrisLogic game;
+  std::atomic<bool> isRunning = true;
+  std::thread loop([&]() {
+    ControlCommand command;
+    while (isRunning) {
+      channel.wait(10);
+      while (channel.poll(command)) {
+        game.userInput(static_cast<UserAction_t>(command.action), false);
+        ControlAck ack = {};
+        ack.sequence = command.sequence;
+        ack.applied = 1;
+        channel.acknowledge(ack);
+      }
+    }
+  });
+
+  const int count = 2000;
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right};
+  uint32_t sequence;
+  ControlAck ack;
+  bool isAcked = client.send(UserAction_t::Start, false, sequence) &&
+                 client.waitAck(sequence, ack);
+  auto start = steady_clock::now();
+  for (int i = 0; i < count && isAcked; i++) {
+    isAcked = client.send(actions[i % 2], false, sequence) &&
+              client.waitAck(sequence, ack);
+  }
+  int64_t time = elapsedNs(start);
+  isRunning = false;
+  loop.join();
+  if (isAcked) {
+    std::cout << "control round trip: " << time / 1000 / count << " us"
+              << std::endl;
+  }
+}
+
+// replays of random sessions are verified on all cores
+static void replayVerify() {
+  std::string directory =
+      "/tmp/retro_games_" + std::to_string(getpid()) + "_bench_replays";
+  std::filesystem::create_directory(directory);
+  const UserAction_t actions[] = {UserAction_t::Left,   UserAction_t::Right,
+                                  UserAction_t::Up,     UserAction_t::Down,
+                                  UserAction_t::Action, UserAction_t::HardDrop};
+  const int count = 400;
+  for (int i = 0; i < count; i++) {
+    GameType type = i % 2 ? GameType::TETRIS : GameType::SNAKE;
+    GameEngine game(type);
+    ReplayRecorder recorder;
+    RandomGenerator random(100 + i);
+    recorder.start(*game.get(), type, 100 + i);
+    for (int step = 0; step < 2000; step++) {
+      UserAction_t action = actions[random.next(6)];
+      if (game.getCurrentGameStatus() != GameStatus::GAME) {
+        action = UserAction_t::Start;
+      }
+      if (random.next(3)) {
+        game.userInput(action, false);
+        recorder.userInput(*game.get(), action, false);
+      } else {
+        game.gameTick();
+        recorder.gameTick(*game.get());
+      }
+    }
+    recorder.save(*game.get(), directory + "/" + std::to_string(i) +
+                                   REPLAY_EXTENSION);
+  }
+
+  std::vector<std::string> paths = ReplayVerifier::listReplays(directory);
+  auto start = steady_clock::now();
+  std::vector<ReplayResult> results = ReplayVerifier().verify(paths);
+  double seconds = elapsedNs(start) / 1e9;
+  std::filesystem::remove_all(directory);
+  std::cout << "replays verified: "
+            << static_cast<int>(results.size() / seconds * 60)
+            << " per minute" << std::endl;
+}
+
+// snake goes up to first row, then along rows and down to next row at
+// walls, so it does not meet its body while rows are left
+static int playRows(SnakeLogic& game, int ticks) {
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  int x = 0, y = 0;
+  int moves = 0;
+  for (; moves < ticks && game.getCurrentGameStatus() == GameStatus::GAME;
+       moves++) {
+    game.getFocus(x, y);
+    auto head = static_cast<SnakeLogic::Field>(gameInfo.field[y][x]);
+    bool isAlong = head == SnakeLogic::Field::HEAD_LEFT ||
+                   head == SnakeLogic::Field::HEAD_RIGHT;
+    if (head == SnakeLogic::Field::HEAD_UP && y > 0) {
+      game.gameTick();
+    } else if (!isAlong) {
+      game.userInput(x < gameInfo.width / 2 ? UserAction_t::Right
+                                            : UserAction_t::Left,
+                     false);
+    } else if ((head == SnakeLogic::Field::HEAD_LEFT && x == 0) ||
+               (head == SnakeLogic::Field::HEAD_RIGHT &&
+                x == gameInfo.width - 1)) {
+      game.userInput(UserAction_t::Down, false);
+    } else {
+      game.gameTick();
+    }
+  }
+  return moves;
+}
+
+// time of move does not grow with board
+static void snakeLargeBoard() {
+  const int sizes[][2] = {{100, 100}, {2000, 2000}};
+  for (const auto& size : sizes) {
+    int ticks = std::min(20000, size[0] * size[1] / 2);
+    SnakeLogic game(size[0], size[1]);
+    game.setSeed(4);
+    game.userInput(UserAction_t::Start, false);
+
+    auto start = steady_clock::now();
+    int moves = playRows(game, ticks);
+    std::cout << "snake board " << size[0] << "x" << size[1] << ": "
+              << moves << " moves, " << elapsedNs(start) / std::max(moves, 1)
+              << " ns per move" << std::endl;
+  }
+}
+
+// dozens of bots on one grid
+static void snakeArena() {
+  SnakeArena game(48, 48, 200, 200);
+  game.setSeed(5);
+  game.setBot(0, true);
+  game.userInput(UserAction_t::Start, false);
+
+  const int ticks = 5000;
+  int done = 0;
+  auto start = steady_clock::now();
+  for (; done < ticks && game.getCurrentGameStatus() == GameStatus::GAME;
+       done++) {
+    game.gameTick();
+  }
+  int64_t time = elapsedNs(start);
+  std::cout << "arena 48 snakes 200x200: " << done << " ticks, "
+            << game.getAliveCount() << " alive, " << time / std::max(done, 1)
+            << " ns per tick" << std::endl;
+}
+
+// match of bots on four boards runs by ticks alone
+static void tetrisVersus() {
+  TetrisVersus match(4);
+  match.setBot(0, std::make_unique<TetrisBot>(1));
+  match.setSeed(9);
+  match.userInput(UserAction_t::Start, false);
+  const int ticks = 400;
+  int done = 0;
+
+  auto start = steady_clock::now();
+  for (; done < ticks && !match.isFinished(); done++) {
+    match.gameTick();
+  }
+  int64_t time = elapsedNs(start);
+  int sent = 0;
+  for (int i = 0; i < match.getBoardsCount(); i++) {
+    sent += match.getSentLines(i);
+  }
+  std::cout << "versus of 4 bots: " << time / 1000 / std::max(done, 1)
+            << " us per tick, sent " << sent << " rows" << std::endl;
+}
+
+// round robin of three tetris policies on all cores
+static void tournament() {
+  auto policy = [](const std::string& name, TetrisWeights weights) {
+    return TournamentPolicy{
+        name, [weights]() { return std::make_unique<TetrisBot>(1, weights); }};
+  };
+  TournamentOptions options;
+  options.seeds = {1, 2, 3, 4};
+  options.maxTicks = 300;
+  Tournament tournament({policy("default", {}), policy("blind", {0, 0, 0, 0}),
+                         policy("flat", {-0.8, 0.76, -0.36, -0.35})},
+                        options);
+
+  auto start = steady_clock::now();
+  tournament.run();
+  std::cout << "tetris round robin: " << elapsedNs(start) / 1000000
+            << " ms for " << tournament.getGames().size() << " games"
+            << std::endl;
+}
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+};
+
+static const Benchmark benchmarks[] = {
+    {"save_load", saveLoad},
+    {"journal_restore", journalRestore},
+    {"tetris_bot", tetrisBot},
+    {"snake_bot", snakeBot},
+    {"snake_solver", snakeSolver},
+    {"vector_env", vectorEnv},
+    {"control_round_trip", controlRoundTrip},
+    {"replay_verify", replayVerify},
+    {"snake_large_board", snakeLargeBoard},
+    {"snake_arena", snakeArena},
+    {"tetris_versus", tetrisVersus},
+    {"tournament", tournament},
+};
+
+int main(int argc, char** argv) {
+  GameLogic::setHighScoreStorage(false);
+  bool isFound = false;
+  // all benchmarks, or only the named one
+  for (const Benchmark& benchmark : benchmarks) {
+    if (argc < 2 || !strcmp(argv[1], benchmark.name)) {
+      benchmark.run();
+      isFound = true;
+    }
+  }
+  if (!isFound) {
+    std::cerr << "usage: " << argv[0] << " [name]" << std::endl;
+    return 1;
+  }
+  return 0;
+}
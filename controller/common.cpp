@@ -1,19 +1,27 @@
 #include "common.hpp"
 
+#include <cmath>
+
 using namespace s21;
 
+int s21::getDelay(int level, int initialDelay) {
+  const double k = pow(0.1, 1.0 / 9.0);  // reduction ratio
+  return static_cast<int>(initialDelay * pow(k, level - 1));
+}
+
 bool GameInfo_t::operator!=(const GameInfo_t& rhs) const {
   bool notEqual = false;
 
   if (score != rhs.score || high_score != rhs.high_score ||
-      level != rhs.level || speed != rhs.speed || pause != rhs.pause) {
+      level != rhs.level || speed != rhs.speed || pause != rhs.pause ||
+      width != rhs.width || height != rhs.height) {
     notEqual = true;
   }
 
-  for (int i = 0; i < FIELD_HEIGHT && !notEqual; ++i) {
+  for (int i = 0; i < height && !notEqual; ++i) {
     if (field != nullptr && rhs.field != nullptr) {
       if (field[i] != nullptr && rhs.field[i] != nullptr) {
-        for (int j = 0; j < FIELD_WIDTH && !notEqual; ++j) {
+        for (int j = 0; j < width && !notEqual; ++j) {
           if (field[i][j] != rhs.field[i][j]) {
             notEqual = true;
           }
@@ -57,7 +65,7 @@ GameInfo_t& GameInfo_t::operator=(const GameInfo_t& rhs) {
 
     // free memory if alloc
     if (field != nullptr) {
-      for (int i = 0; i < FIELD_HEIGHT; ++i) {
+      for (int i = 0; i < height; ++i) {
         delete[] field[i];
       }
       delete[] field;
@@ -70,13 +78,15 @@ GameInfo_t& GameInfo_t::operator=(const GameInfo_t& rhs) {
     }
 
     // alloc and copy memory
+    width = rhs.width;
+    height = rhs.height;
     if (rhs.field == nullptr) {
       field = nullptr;
     } else {
-      field = new int*[FIELD_HEIGHT];
-      for (int i = 0; i < FIELD_HEIGHT; ++i) {
-        field[i] = new int[FIELD_WIDTH];
-        for (int j = 0; j < FIELD_WIDTH; ++j) {
+      field = new int*[height];
+      for (int i = 0; i < height; ++i) {
+        field[i] = new int[width];
+        for (int j = 0; j < width; ++j) {
           field[i][j] = rhs.field[i][j];
         }
       }
@@ -104,12 +114,14 @@ GameInfo_t::GameInfo_t(const GameInfo_t& rhs) {
   level = rhs.level;
   speed = rhs.speed;
   pause = rhs.pause;
+  width = rhs.width;
+  height = rhs.height;
 
   if (rhs.field != nullptr) {
-    field = new int*[FIELD_HEIGHT];
-    for (int i = 0; i < FIELD_HEIGHT; ++i) {
-      field[i] = new int[FIELD_WIDTH];
-      for (int j = 0; j < FIELD_WIDTH; ++j) {
+    field = new int*[height];
+    for (int i = 0; i < height; ++i) {
+      field[i] = new int[width];
+      for (int j = 0; j < width; ++j) {
         field[i][j] = rhs.field[i][j];
       }
     }
@@ -138,7 +150,9 @@ GameInfo_t::GameInfo_t(GameInfo_t&& rhs) noexcept
       high_score(rhs.high_score),
       level(rhs.level),
       speed(rhs.speed),
-      pause(rhs.pause) {
+      pause(rhs.pause),
+      width(rhs.width),
+      height(rhs.height) {
   rhs.field = nullptr;
   rhs.next = nullptr;
 }
@@ -151,12 +165,14 @@ GameInfo_t::GameInfo_t() {
   level = 0;
   speed = 0;
   pause = 0;
+  width = FIELD_WIDTH;
+  height = FIELD_HEIGHT;
 }
 
 GameInfo_t::~GameInfo_t() {
   const int NEXT_SIZE = 4;
   if (field != nullptr) {
-    for (int i = 0; i < FIELD_HEIGHT; ++i) {
+    for (int i = 0; i < height; ++i) {
       delete[] field[i];
     }
     delete[] field;
@@ -1,11 +1,18 @@
 #ifndef COMMON_HPP
 #define COMMON_HPP
 
+#include <array>
+#include <cstdint>
+
 namespace s21 {
 #define FIELD_WIDTH 10
 #define FIELD_HEIGHT 20
 #define NEXT_WIDTH 4
 #define NEXT_HEIGHT 4
+#define GHOST_CELL 2  // tetris field: where falling piece will land
+
+// cells of piece in preview queue, as next piece of GameInfo_t
+using PieceGrid = std::array<std::array<uint8_t, NEXT_WIDTH>, NEXT_HEIGHT>;
 
 enum class GameStatus { INIT, INSTRUCTION, GAME, PAUSE, GAME_OVER, WIN };
 enum class GameType { NONE, TETRIS, SNAKE };
@@ -17,7 +24,8 @@ enum class UserAction_t {
   Right,
   Up,
   Down,
-  Action
+  Action,
+  HardDrop  // tetris: drop piece to the bottom at once
 };
 
 struct GameInfo_t {
@@ -28,6 +36,8 @@ struct GameInfo_t {
   int level;
   int speed;
   int pause;
+  int width;   // of field, FIELD_WIDTH on classic board
+  int height;  // of field, FIELD_HEIGHT on classic board
 
   GameInfo_t();
   GameInfo_t(const GameInfo_t& rhs);
@@ -37,6 +47,38 @@ struct GameInfo_t {
   bool operator!=(const GameInfo_t& rhs) const;
   bool operator==(const GameInfo_t& rhs) const;
 };
+
+// xorshift64* generator of game, its whole state is one number,
+// so the game can be saved and replayed with the same random shapes and food
+class RandomGenerator {
+ public:
+  explicit RandomGenerator(uint64_t seed = 1) { setSeed(seed); }
+
+  void setSeed(uint64_t seed) {
+    // splitmix64 step, spreads close seeds and avoids zero state
+    seed += 0x9E3779B97F4A7C15ull;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+    state = (seed ^ (seed >> 31)) | 1;
+  }
+
+  // random number from 0 to bound - 1
+  int next(int bound) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<int>(((state * 0x2545F4914F6CDD1Dull) >> 33) % bound);
+  }
+
+  uint64_t getState() const { return state; }
+  void setState(uint64_t newState) { state = newState ? newState : 1; }
+
+ private:
+  uint64_t state;
+};
+
+// delay between game ticks in ms, decreases from 1000 to 100 by level 10
+int getDelay(int level, int initialDelay = 1000);
 }  // namespace s21
 
 #endif  // COMMON_HPP
\ No newline at end of file
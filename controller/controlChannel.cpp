@@ -0,0 +1,203 @@
+#include "controlChannel.hpp"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+
+using namespace s21;
+
+#define SPIN_US 50  // client spins before sleeping, ack usually comes sooner
+
+static size_t channelSize(uint32_t capacity) {
+  return sizeof(ControlHeader) +
+         capacity * (sizeof(ControlCommand) + sizeof(ControlAck));
+}
+
+// shared futex, the word is mapped by both processes
+static void futexWait(std::atomic<uint32_t>& word, uint32_t expected,
+                      int timeoutUs) {
+  timespec timeout = {timeoutUs / 1000000, timeoutUs % 1000000 * 1000L};
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected,
+          &timeout, nullptr, 0);
+}
+
+static void futexWake(std::atomic<uint32_t>& word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1,
+          nullptr, nullptr, 0);
+}
+
+static void* mapChannel(int fd, size_t size) {
+  void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  return map == MAP_FAILED ? nullptr : map;
+}
+
+//
+// ============================================================================
+// Controller side
+// ============================================================================
+
+ControlChannel::~ControlChannel() { close(); }
+
+bool ControlChannel::open(const std::string& name, uint32_t capacity) {
+  close();
+  if (capacity == 0) return false;
+
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) return false;
+  size_t size = channelSize(capacity);
+  map = ftruncate(fd, size) == 0 ? mapChannel(fd, size) : nullptr;
+  ::close(fd);
+  if (!map) {
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  // new object is zero filled
+  this->name = name;
+  mapSize = size;
+  header = static_cast<ControlHeader*>(map);
+  commands = reinterpret_cast<ControlCommand*>(header + 1);
+  acks = reinterpret_cast<ControlAck*>(commands + capacity);
+  header->capacity = capacity;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->magic = CONTROL_MAGIC;
+  return true;
+}
+
+void ControlChannel::close() {
+  if (map) {
+    munmap(map, mapSize);
+    shm_unlink(name.c_str());
+    map = nullptr;
+    header = nullptr;
+    commands = nullptr;
+    acks = nullptr;
+  }
+}
+
+bool ControlChannel::poll(ControlCommand& command) {
+  if (!header) return false;
+  uint32_t read = header->commandsRead.load(std::memory_order_relaxed);
+  if (header->commandsWritten.load(std::memory_order_acquire) == read) {
+    return false;
+  }
+  command = commands[read % header->capacity];
+  header->commandsRead.store(read + 1, std::memory_order_release);
+  return true;
+}
+
+void ControlChannel::acknowledge(const ControlAck& ack) {
+  acks[ack.sequence % header->capacity] = ack;
+  header->acksWritten.store(ack.sequence + 1, std::memory_order_seq_cst);
+  if (header->clientWaiting.load(std::memory_order_seq_cst)) {
+    futexWake(header->acksWritten);
+  }
+}
+
+void ControlChannel::wait(int timeoutMs) {
+  uint32_t read = header->commandsRead.load(std::memory_order_relaxed);
+  header->controllerWaiting.store(1, std::memory_order_seq_cst);
+  // command written before flag was set is seen here
+  if (header->commandsWritten.load(std::memory_order_seq_cst) == read) {
+    futexWait(header->commandsWritten, read, timeoutMs * 1000);
+  }
+  header->controllerWaiting.store(0, std::memory_order_relaxed);
+}
+
+//
+// ============================================================================
+// Client side
+// ============================================================================
+
+ControlClient::~ControlClient() { close(); }
+
+bool ControlClient::open(const std::string& name) {
+  close();
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) return false;
+
+  struct stat info;
+  bool isValid = fstat(fd, &info) == 0 &&
+                 static_cast<size_t>(info.st_size) >= sizeof(ControlHeader);
+  if (isValid) {
+    mapSize = info.st_size;
+    map = mapChannel(fd, mapSize);
+  }
+  ::close(fd);
+  if (!map) return false;
+
+  header = static_cast<ControlHeader*>(map);
+  if (header->magic != CONTROL_MAGIC || header->capacity == 0 ||
+      channelSize(header->capacity) > mapSize) {
+    close();
+    return false;
+  }
+  commands = reinterpret_cast<ControlCommand*>(header + 1);
+  acks = reinterpret_cast<ControlAck*>(commands + header->capacity);
+  return true;
+}
+
+void ControlClient::close() {
+  if (map) {
+    munmap(map, mapSize);
+    map = nullptr;
+    header = nullptr;
+    commands = nullptr;
+    acks = nullptr;
+  }
+}
+
+bool ControlClient::send(UserAction_t action, bool hold, uint32_t& sequence) {
+  if (!header) return false;
+  uint32_t written = header->commandsWritten.load(std::memory_order_relaxed);
+  if (written - header->commandsRead.load(std::memory_order_acquire) >=
+      header->capacity) {
+    return false;
+  }
+
+  ControlCommand command = {written, static_cast<uint8_t>(action), hold, {}};
+  commands[written % header->capacity] = command;
+  header->commandsWritten.store(written + 1, std::memory_order_seq_cst);
+  if (header->controllerWaiting.load(std::memory_order_seq_cst)) {
+    futexWake(header->commandsWritten);
+  }
+  sequence = written;
+  return true;
+}
+
+bool ControlClient::waitAck(uint32_t sequence, ControlAck& ack,
+                            int timeoutUs) {
+  if (!header) return false;
+  using namespace std::chrono;
+  auto start = steady_clock::now();
+  auto isAcked = [this, sequence]() {
+    // counters wrap, so compare distance
+    uint32_t written = header->acksWritten.load(std::memory_order_acquire);
+    return static_cast<int32_t>(written - sequence) > 0;
+  };
+
+  while (!isAcked()) {
+    auto waited = duration_cast<microseconds>(steady_clock::now() - start);
+    if (waited.count() >= timeoutUs) return false;
+    if (waited.count() < SPIN_US) continue;
+
+    uint32_t written = header->acksWritten.load(std::memory_order_relaxed);
+    header->clientWaiting.store(1, std::memory_order_seq_cst);
+    if (header->acksWritten.load(std::memory_order_seq_cst) == written) {
+      futexWait(header->acksWritten, written,
+                timeoutUs - static_cast<int>(waited.count()));
+    }
+    header->clientWaiting.store(0, std::memory_order_relaxed);
+  }
+
+  ack = acks[sequence % header->capacity];
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint32_t written = header->acksWritten.load(std::memory_order_relaxed);
+  return ack.sequence == sequence && written - sequence <= header->capacity;
+}
@@ -0,0 +1,100 @@
+#ifndef CONTROL_CHANNEL_HPP
+#define CONTROL_CHANNEL_HPP
+
+#include <atomic>
+#include <string>
+
+#include "common.hpp"
+
+namespace s21 {
+
+#define CONTROL_MAGIC 0x4C525443  // "CTRL"
+
+// POSIX shared memory object, host byte order:
+//   ControlHeader | ControlCommand[capacity] | ControlAck[capacity]
+// One client writes commands, the controller applies them in order and
+// writes ack of command n to slot n % capacity. Counters only grow, the
+// sleeping side is woken by futex on its counter, only if it waits.
+struct ControlHeader {
+  uint32_t magic;
+  uint32_t capacity;
+  std::atomic<uint32_t> commandsWritten;
+  std::atomic<uint32_t> commandsRead;
+  std::atomic<uint32_t> acksWritten;
+  std::atomic<uint32_t> controllerWaiting;
+  std::atomic<uint32_t> clientWaiting;
+  uint32_t reserved;
+};
+
+struct ControlCommand {
+  uint32_t sequence;
+  uint8_t action;  // UserAction_t
+  uint8_t hold;
+  uint8_t reserved[2];
+};
+
+// state of game after command
+struct ControlAck {
+  uint32_t sequence;
+  uint8_t status;
+  uint8_t gameType;
+  uint8_t applied;  // 0 if action is unknown or there is no game
+  uint8_t reserved;
+  uint64_t version;  // changes of game made by controller so far
+  int32_t score;
+  int32_t level;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "counters are used as futex words");
+
+// Controller side, creates channel and removes it when closed.
+class ControlChannel {
+ public:
+  ControlChannel() = default;
+  ~ControlChannel();
+
+  // name as for shm_open, "/retro_games_control" for example
+  bool open(const std::string& name, uint32_t capacity = 256);
+  void close();
+  bool isOpen() const { return header != nullptr; }
+
+  // next command of client, false if there is none
+  bool poll(ControlCommand& command);
+  void acknowledge(const ControlAck& ack);
+  // sleeps until command comes or timeout
+  void wait(int timeoutMs);
+
+ private:
+  std::string name;
+  void* map = nullptr;
+  size_t mapSize = 0;
+  ControlHeader* header = nullptr;
+  ControlCommand* commands = nullptr;
+  ControlAck* acks = nullptr;
+};
+
+// Client side, for bot in other process.
+class ControlClient {
+ public:
+  ControlClient() = default;
+  ~ControlClient();
+
+  bool open(const std::string& name);
+  void close();
+
+  // false if queue is full, sequence identifies ack of command
+  bool send(UserAction_t action, bool hold, uint32_t& sequence);
+  // spins first, then sleeps; false on timeout or if ack is overwritten
+  bool waitAck(uint32_t sequence, ControlAck& ack, int timeoutUs = 100000);
+
+ private:
+  void* map = nullptr;
+  size_t mapSize = 0;
+  ControlHeader* header = nullptr;
+  ControlCommand* commands = nullptr;
+  ControlAck* acks = nullptr;
+};
+}  // namespace s21
+
+#endif  // CONTROL_CHANNEL_HPP
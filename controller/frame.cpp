@@ -0,0 +1,32 @@
+#include "frame.hpp"
+
+using namespace s21;
+
+void s21::packFrame(const GameInfo_t& gameInfo, GameStatus gameStatus,
+                    GameType gameType, Frame_t& frame) {
+  frame.gameType = static_cast<uint8_t>(gameType);
+  frame.status = static_cast<uint8_t>(gameStatus);
+  frame.pause = static_cast<uint8_t>(gameInfo.pause);
+  frame.reserved = 0;
+  frame.score = gameInfo.score;
+  frame.high_score = gameInfo.high_score;
+  frame.level = gameInfo.level;
+  frame.speed = gameInfo.speed;
+
+  // other board is cut to top left corner of classic one
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      bool isInside =
+          gameInfo.field && y < gameInfo.height && x < gameInfo.width;
+      frame.field[y][x] =
+          isInside ? static_cast<uint8_t>(gameInfo.field[y][x]) : 0;
+    }
+  }
+
+  for (int y = 0; y < NEXT_HEIGHT; y++) {
+    for (int x = 0; x < NEXT_WIDTH; x++) {
+      frame.next[y][x] =
+          gameInfo.next ? static_cast<uint8_t>(gameInfo.next[y][x]) : 0;
+    }
+  }
+}
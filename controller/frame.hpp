@@ -0,0 +1,29 @@
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include <cstdint>
+
+#include "common.hpp"
+
+namespace s21 {
+// Compact POD copy of a rendered game state, one byte per cell.
+// Used wherever a frame leaves the process (sockets, files, shared memory).
+struct Frame_t {
+  uint8_t gameType;
+  uint8_t status;
+  uint8_t pause;
+  uint8_t reserved;
+  uint32_t number;
+  int32_t score;
+  int32_t high_score;
+  int32_t level;
+  int32_t speed;
+  uint8_t field[FIELD_HEIGHT][FIELD_WIDTH];
+  uint8_t next[NEXT_HEIGHT][NEXT_WIDTH];
+};
+
+void packFrame(const GameInfo_t& gameInfo, GameStatus gameStatus,
+               GameType gameType, Frame_t& frame);
+}  // namespace s21
+
+#endif  // FRAME_HPP
@@ -0,0 +1,137 @@
+#include "frameRing.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace s21;
+
+static size_t ringSize(uint32_t capacity) {
+  return sizeof(FrameRingHeader) + capacity * sizeof(FrameSlot);
+}
+
+FrameRing::~FrameRing() { close(); }
+
+bool FrameRing::open(const std::string& name, uint32_t capacity) {
+  close();
+  if (capacity == 0) return false;
+
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+  size_t size = ringSize(capacity);
+  if (ftruncate(fd, size) < 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+  map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    map = nullptr;
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  // new object is zero filled, zero sequences are empty slots
+  this->name = name;
+  mapSize = size;
+  header = static_cast<FrameRingHeader*>(map);
+  slots = reinterpret_cast<FrameSlot*>(header + 1);
+  header->capacity = capacity;
+  header->magic = FRAME_RING_MAGIC;
+  return true;
+}
+
+void FrameRing::close() {
+  if (map) {
+    munmap(map, mapSize);
+    shm_unlink(name.c_str());
+    map = nullptr;
+    header = nullptr;
+    slots = nullptr;
+  }
+}
+
+void FrameRing::publish(const GameInfo_t& gameInfo, GameStatus gameStatus,
+                        GameType gameType) {
+  std::lock_guard<std::mutex> lock(publishMutex);
+  if (!slots) return;
+  uint64_t number = header->written.load(std::memory_order_relaxed);
+  FrameSlot& slot = slots[number % header->capacity];
+
+  slot.sequence.store(2 * number + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  packFrame(gameInfo, gameStatus, gameType, slot.frame);
+  slot.frame.number = static_cast<uint32_t>(number);
+  slot.sequence.store(2 * number + 2, std::memory_order_release);
+  header->written.store(number + 1, std::memory_order_release);
+}
+
+FrameRingReader::~FrameRingReader() { close(); }
+
+bool FrameRingReader::open(const std::string& name) {
+  close();
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) return false;
+
+  struct stat info;
+  bool isValid = fstat(fd, &info) == 0 &&
+                 static_cast<size_t>(info.st_size) >= sizeof(FrameRingHeader);
+  if (isValid) {
+    mapSize = info.st_size;
+    map = mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    isValid = map != MAP_FAILED;
+  }
+  ::close(fd);
+  if (!isValid) {
+    map = nullptr;
+    return false;
+  }
+
+  header = static_cast<const FrameRingHeader*>(map);
+  slots = reinterpret_cast<const FrameSlot*>(header + 1);
+  if (header->magic != FRAME_RING_MAGIC || header->capacity == 0 ||
+      ringSize(header->capacity) > mapSize) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void FrameRingReader::close() {
+  if (map) {
+    munmap(map, mapSize);
+    map = nullptr;
+    header = nullptr;
+    slots = nullptr;
+  }
+}
+
+uint64_t FrameRingReader::getWritten() const {
+  return header ? header->written.load(std::memory_order_acquire) : 0;
+}
+
+bool FrameRingReader::read(uint64_t number, Frame_t& frame) const {
+  if (!header) return false;
+  const FrameSlot& slot = slots[number % header->capacity];
+  uint64_t ready = 2 * number + 2;
+
+  if (slot.sequence.load(std::memory_order_acquire) != ready) return false;
+  memcpy(&frame, &slot.frame, sizeof(frame));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  // writer took the slot while frame was copied
+  return slot.sequence.load(std::memory_order_relaxed) == ready;
+}
+
+bool FrameRingReader::readLatest(Frame_t& frame) const {
+  bool isRead = false;
+  // writer may lap the reader, then take the next latest frame
+  for (int attempt = 0; attempt < 4 && !isRead; attempt++) {
+    uint64_t written = getWritten();
+    isRead = written > 0 && read(written - 1, frame);
+  }
+  return isRead;
+}
@@ -0,0 +1,81 @@
+#ifndef FRAME_RING_HPP
+#define FRAME_RING_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "frame.hpp"
+
+namespace s21 {
+
+#define FRAME_RING_MAGIC 0x474E5246  // "FRNG"
+
+// POSIX shared memory object, host byte order:
+//   FrameRingHeader | FrameSlot[capacity]
+// Frame number n goes to slot n % capacity. Each slot is a seqlock: its
+// sequence is 2n + 1 while frame n is written and 2n + 2 when it is ready,
+// so readers never block the game and detect torn or overwritten frames.
+struct FrameRingHeader {
+  uint32_t magic;
+  uint32_t capacity;
+  std::atomic<uint64_t> written;  // frames published
+};
+
+struct FrameSlot {
+  std::atomic<uint64_t> sequence;
+  Frame_t frame;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared counters must be lock free");
+
+// Publishes rendered frames into shared memory ring, writer side.
+// The object is removed when ring is closed, mapped readers keep working.
+class FrameRing {
+ public:
+  FrameRing() = default;
+  ~FrameRing();
+
+  // name as for shm_open, "/retro_games" for example
+  bool open(const std::string& name, uint32_t capacity = 64);
+  void close();
+  bool isOpen() const { return slots != nullptr; }
+
+  // safe from several threads, slots have one writer at a time
+  void publish(const GameInfo_t& gameInfo, GameStatus gameStatus,
+               GameType gameType);
+
+ private:
+  std::mutex publishMutex;  // seqlock of slot allows one writer
+  std::string name;
+  void* map = nullptr;
+  size_t mapSize = 0;
+  FrameRingHeader* header = nullptr;
+  FrameSlot* slots = nullptr;
+};
+
+// Reads frames of ring from other process, no syscalls after open.
+class FrameRingReader {
+ public:
+  FrameRingReader() = default;
+  ~FrameRingReader();
+
+  bool open(const std::string& name);
+  void close();
+
+  // frames published so far, the last one is getWritten() - 1
+  uint64_t getWritten() const;
+  // false if frame is not written yet or already overwritten
+  bool read(uint64_t number, Frame_t& frame) const;
+  bool readLatest(Frame_t& frame) const;
+
+ private:
+  void* map = nullptr;
+  size_t mapSize = 0;
+  const FrameRingHeader* header = nullptr;
+  const FrameSlot* slots = nullptr;
+};
+}  // namespace s21
+
+#endif  // FRAME_RING_HPP
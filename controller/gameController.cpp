@@ -1,13 +1,12 @@
 #include "gameController.hpp"
 
-#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 using namespace s21;
 
-static int getDelay(int level, int initialDelay = 1000) {
-  const double k = pow(0.1, 1.0 / 9.0);  // reduction ratio
-  return static_cast<int>(initialDelay * pow(k, level - 1));
-}
+#define BOT_DELAY 50   // ms between actions of autoplay bot
+#define LOOP_DELAY 10  // ms between iterations of game loop
 
 GameController::GameController(std::unique_ptr<GameView> view)
     : view(std::move(view)) {}
@@ -16,36 +15,350 @@ void GameController::setView(std::unique_ptr<GameView> view) {
   this->view = std::move(view);
 }
 
+void GameController::setSpectator(std::unique_ptr<SpectatorStream> spectator) {
+  this->spectator = std::move(spectator);
+}
+
+void GameController::setJournal(std::unique_ptr<GameJournal> journal) {
+  this->journal = std::move(journal);
+}
+
+void GameController::setFrameRing(std::unique_ptr<FrameRing> frameRing) {
+  this->frameRing = std::move(frameRing);
+}
+
+void GameController::setControl(std::unique_ptr<ControlChannel> control) {
+  this->control = std::move(control);
+}
+
+void GameController::setReplayDirectory(const std::string& directory) {
+  replayDirectory = directory;
+  recorder = directory.empty() ? nullptr : std::make_unique<ReplayRecorder>();
+}
+
+// "<width>x<height>", both not less than MIN_FIELD_SIZE
+static bool parseBoardSize(const char* text, int& width, int& height) {
+  int newWidth = 0;
+  int newHeight = 0;
+  char end = 0;
+  bool isParsed = sscanf(text, "%dx%d%c", &newWidth, &newHeight, &end) == 2 &&
+                  newWidth >= MIN_FIELD_SIZE && newHeight >= MIN_FIELD_SIZE;
+  if (isParsed) {
+    width = newWidth;
+    height = newHeight;
+  }
+  return isParsed;
+}
+
+bool GameController::applyOptions(int argc, char** argv) {
+  bool isValid = true;
+  std::string journalPath = JOURNAL_FILE;
+  for (int i = 1; i < argc && isValid; i++) {
+    std::string option = argv[i];
+    if (option == "--spectate" && i + 1 < argc) {
+      auto stream = std::make_unique<SpectatorStream>();
+      isValid = stream->open(argv[++i]);
+      if (isValid) {
+        setSpectator(std::move(stream));
+      }
+    } else if (option == "--shm" && i + 1 < argc) {
+      auto ring = std::make_unique<FrameRing>();
+      isValid = ring->open(argv[++i]);
+      if (isValid) {
+        setFrameRing(std::move(ring));
+      }
+    } else if (option == "--control" && i + 1 < argc) {
+      auto channel = std::make_unique<ControlChannel>();
+      isValid = channel->open(argv[++i]);
+      if (isValid) {
+        setControl(std::move(channel));
+      }
+    } else if (option == "--record" && i + 1 < argc) {
+      setReplayDirectory(argv[++i]);
+    } else if (option == "--board" && i + 1 < argc) {
+      isValid = parseBoardSize(argv[++i], boardWidth, boardHeight);
+    } else if (option == "--arena" && i + 1 < argc) {
+      arenaSnakes = atoi(argv[++i]);
+      isValid = arenaSnakes > 1 && arenaSnakes <= MAX_ARENA_SNAKES;
+    } else if (option == "--versus" && i + 1 < argc) {
+      versusBoards = atoi(argv[++i]);
+      isValid = versusBoards > 1 && versusBoards <= MAX_VERSUS_BOARDS;
+    } else if (option == "--preview" && i + 1 < argc) {
+      previewSize = atoi(argv[++i]);
+      isValid = previewSize > 0 && previewSize <= PREVIEW_SIZE;
+    } else if (option == "--journal" && i + 1 < argc) {
+      journalPath = argv[++i];
+    } else if (option == "--no-journal") {
+      journalPath.clear();
+    } else if (option == "--autoplay") {
+      autoplay = true;
+    } else if (option == "--solver") {
+      autoplay = true;
+      solver = true;
+    } else {
+      isValid = false;
+    }
+  }
+
+  // bots play only classic board
+  if (autoplay &&
+      (boardWidth != FIELD_WIDTH || boardHeight != FIELD_HEIGHT)) {
+    isValid = false;
+  }
+  // match is not restored from board of player
+  if (versusBoards > 1) {
+    journalPath.clear();
+  }
+  if (isValid && !journalPath.empty()) {
+    auto gameJournal = std::make_unique<GameJournal>();
+    isValid = gameJournal->open(journalPath);
+    if (isValid) {
+      setJournal(std::move(gameJournal));
+    }
+  }
+  return isValid;
+}
+
+void GameController::renderFrame(const GameInfo_t& gameInfo,
+                                 GameStatus gameStatus) {
+  view->render(gameInfo, gameStatus, gameType);
+  if (spectator) {
+    spectator->publish(gameInfo, gameStatus, gameType);
+  }
+  if (frameRing) {
+    frameRing->publish(gameInfo, gameStatus, gameType);
+  }
+  TetrisVersus* versus = getVersus();
+  if (versus) {
+    view->renderOpponents(
+        versus->getOpponentViews(FIELD_WIDTH, FIELD_HEIGHT));
+  }
+  // preview of resumed game is its own, not of option
+  if (gameType == GameType::TETRIS) {
+    std::vector<PieceGrid> pieces = previewPieces();
+    if (!pieces.empty()) {
+      view->renderPreview(pieces);
+    }
+  }
+}
+
+// pieces of queue after the next one, that is shown by GameInfo_t
+std::vector<PieceGrid> GameController::previewPieces() const {
+  std::vector<PieceGrid> pieces;
+  uint8_t queue[PREVIEW_SIZE];
+  int size = static_cast<TetrisLogic*>(model.get())->getPreview(queue);
+  for (int i = 1; i < size; i++) {
+    GameState_t::Shape_t shape = TetrisLogic::pieceShape(queue[i]);
+    PieceGrid& grid = pieces.emplace_back();
+    for (int y = 0; y < NEXT_HEIGHT; y++) {
+      std::copy(shape.grid[y], shape.grid[y] + NEXT_WIDTH, grid[y].begin());
+    }
+  }
+  return pieces;
+}
+
+// large board is shown by window of classic size around its focus, so
+// frame does not copy whole board
+GameInfo_t GameController::viewState() const {
+  return model->isClassicBoard()
+             ? model->updateCurrentState()
+             : model->getViewport(FIELD_WIDTH, FIELD_HEIGHT);
+}
+
+TetrisVersus* GameController::getVersus() const {
+  return dynamic_cast<TetrisVersus*>(model.get());
+}
+
+std::unique_ptr<GameLogic> GameController::createGame(GameType type,
+                                                      int width, int height) {
+  std::unique_ptr<GameLogic> game;
+  switch (type) {
+    case GameType::TETRIS:
+      if (versusBoards > 1) {
+        game = std::make_unique<TetrisVersus>(versusBoards, width, height);
+      } else {
+        game = std::make_unique<TetrisLogic>(width, height);
+      }
+      static_cast<TetrisLogic*>(game.get())->setPreviewSize(previewSize);
+      break;
+    case GameType::SNAKE:
+      if (arenaSnakes > 1) {
+        game = std::make_unique<SnakeArena>(arenaSnakes, arenaSnakes, width,
+                                            height);
+      } else {
+        game = std::make_unique<SnakeLogic>(width, height);
+      }
+      break;
+    default:
+      break;
+  }
+  return game;
+}
+
+std::unique_ptr<GameBot> GameController::createBot(GameType type) {
+  std::unique_ptr<GameBot> gameBot;
+  if (type == GameType::TETRIS) {
+    gameBot = std::make_unique<TetrisBot>();
+  } else if (type == GameType::SNAKE) {
+    gameBot = std::make_unique<SnakeBot>(solver ? SnakeBot::Mode::CYCLE
+                                                : SnakeBot::Mode::PATH);
+  }
+  return gameBot;
+}
+
+void GameController::applyAction(UserAction_t action, bool hold) {
+  std::lock_guard<std::mutex> lock(actionMutex);
+  if (journal) {
+    journal->userInput(*model, action, hold);
+  } else {
+    model->userInput(action, hold);
+  }
+  if (recorder) {
+    recorder->userInput(*model, action, hold);
+  }
+  stateVersion++;
+}
+
+void GameController::tickModel() {
+  std::lock_guard<std::mutex> lock(actionMutex);
+  if (journal) {
+    journal->gameTick(*model);
+  } else {
+    model->gameTick();
+  }
+  if (recorder) {
+    recorder->gameTick(*model);
+  }
+  stateVersion++;
+}
+
+// bot waits for player to start game, so ESC still leaves the game
+void GameController::playBot() {
+  using namespace std::chrono;
+  auto now = steady_clock::now();
+  UserAction_t action;
+
+  if (now - lastBotTime >= milliseconds(BOT_DELAY) &&
+      model->getCurrentGameStatus() != GameStatus::INIT &&
+      bot->nextAction(*model, action)) {
+    lastBotTime = now;
+    applyAction(action, false);
+    renderFrame(viewState(), model->getCurrentGameStatus());
+  }
+}
+
+void GameController::playCommands() {
+  ControlCommand command;
+  bool isApplied = false;
+  while (control->poll(command)) {
+    ControlAck ack = {};
+    ack.sequence = command.sequence;
+    ack.applied = model && command.action <=
+                               static_cast<uint8_t>(UserAction_t::HardDrop);
+    if (ack.applied) {
+      applyAction(static_cast<UserAction_t>(command.action), command.hold);
+      isApplied = true;
+    }
+    if (model) {
+      const GameInfo_t& gameInfo = model->getGameInfo();
+      ack.status = static_cast<uint8_t>(model->getCurrentGameStatus());
+      ack.score = gameInfo.score;
+      ack.level = gameInfo.level;
+    }
+    ack.gameType = static_cast<uint8_t>(gameType);
+    ack.version = stateVersion;
+    control->acknowledge(ack);
+  }
+
+  if (isApplied) {
+    renderFrame(viewState(), model->getCurrentGameStatus());
+  }
+}
+
+void GameController::waitLoop() {
+  if (control) {
+    control->wait(LOOP_DELAY);
+  } else {
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOOP_DELAY));
+  }
+}
+
+bool GameController::resumeGame() {
+  GameType savedGame = journal ? journal->getSavedGame() : GameType::NONE;
+  bool isResumed = false;
+
+  if (savedGame != GameType::NONE && view->offerResume(savedGame)) {
+    model = createGame(savedGame);
+    isResumed = model && journal->restore(*model);
+  }
+
+  if (isResumed) {
+    gameType = savedGame;
+  } else if (journal) {
+    journal->clear();
+  }
+  return isResumed;
+}
+
+// resumed game is not recorded, its start is unknown; keyframes of replay
+// hold only games that fit GameState_t. Versus match depends on boards of
+// bots, replay of board of player would not verify.
+void GameController::startReplay() {
+  std::lock_guard<std::mutex> lock(actionMutex);
+  GameState_t state = {};
+  if (recorder && model && !getVersus()) {
+    model->saveState(state);
+  }
+  if (state.magic == STATE_MAGIC) {
+    auto now = std::chrono::steady_clock::now();
+    recorder->start(*model, gameType, now.time_since_epoch().count());
+  }
+}
+
+void GameController::saveReplay() {
+  std::lock_guard<std::mutex> lock(actionMutex);
+  if (recorder && recorder->isRecording() && model) {
+    std::string name = gameType == GameType::TETRIS ? "tetris_" : "snake_";
+    recorder->save(*model, replayDirectory + "/" + name +
+                               std::to_string(recorder->getSeed()) +
+                               REPLAY_EXTENSION);
+  }
+}
+
 void GameController::run() {
   using namespace std::chrono;
 
   while (view) {
-    gameType = view->selectGame();
-    switch (gameType) {
-      case GameType::TETRIS:
-        model = std::make_unique<TetrisLogic>();
-        break;
-      case GameType::SNAKE:
-        model = std::make_unique<SnakeLogic>();
-        break;
-      default:
+    if (!resumeGame()) {
+      gameType = view->selectGame();
+      model = createGame(gameType, boardWidth, boardHeight);
+      startReplay();
+      if (model && journal) {
+        journal->checkpoint(*model);
+      } else if (!model) {
         view.reset();
-        break;
+      }
     }
+    bot = autoplay ? createBot(gameType) : nullptr;
 
     while (model && gameType != GameType::NONE) {
       auto currentTime = high_resolution_clock::now();
       auto diff = currentTime - model->lastTickTime;
       auto timeDiff = duration_cast<milliseconds>(diff).count();
 
-      GameInfo_t gameInfo = model->updateCurrentState();
-      if (timeDiff >= getDelay(gameInfo.speed)) {
-        model->gameTick();
-        gameInfo = model->updateCurrentState();
-        view->render(gameInfo, model->getCurrentGameStatus(), gameType);
+      if (timeDiff >= getDelay(model->getGameInfo().speed)) {
+        tickModel();
+        renderFrame(viewState(), model->getCurrentGameStatus());
       }
 
-      std::this_thread::sleep_for(milliseconds(10));
+      if (bot) {
+        playBot();
+      }
+      if (control) {
+        playCommands();
+      }
+
+      waitLoop();
     }
   }
 }
@@ -60,7 +373,7 @@ void GameController::userInput(Key key, bool hold) {
       {UserAction_t::Action, Key::SPACE}, {UserAction_t::Left, Key::LEFT},
       {UserAction_t::Right, Key::RIGHT},  {UserAction_t::Down, Key::DOWN},
       {UserAction_t::Up, Key::UP},        {UserAction_t::Start, Key::ENTER},
-      {UserAction_t::Pause, Key::P}};
+      {UserAction_t::Pause, Key::P},      {UserAction_t::HardDrop, Key::D}};
   const int numActions = sizeof(actions) / sizeof(actions[0]);
 
   UserAction_t action = UserAction_t::Terminate;
@@ -75,14 +388,17 @@ void GameController::userInput(Key key, bool hold) {
     if (gameStatus == GameStatus::INIT && key == Key::ESC) {
       closeGame();
     } else {
-      this->model->userInput(action, hold);
-      GameInfo_t gameInfo = model->updateCurrentState();
-      view->render(gameInfo, gameStatus, gameType);
+      applyAction(action, hold);
+      renderFrame(viewState(), gameStatus);
     }
   }
 }
 
 void GameController::closeGame() {
+  saveReplay();
+  if (journal) {
+    journal->clear();
+  }
   gameType = GameType::NONE;
   model.reset();
 }
\ No newline at end of file
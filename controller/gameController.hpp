@@ -1,12 +1,23 @@
 #ifndef GAME_CONTROLLER_HPP
 #define GAME_CONTROLLER_HPP
 
+#include <atomic>
+#include <mutex>
 #include <thread>
 
 #include "../gui/gameView.hpp"
+#include "../retro_games/snake/snakeArena.hpp"
+#include "../retro_games/snake/snakeBot.hpp"
 #include "../retro_games/snake/snakeLogic.hpp"
+#include "../retro_games/tetris/tetrisBot.hpp"
 #include "../retro_games/tetris/tetrisLogic.hpp"
+#include "../retro_games/tetris/tetrisVersus.hpp"
 #include "common.hpp"
+#include "controlChannel.hpp"
+#include "frameRing.hpp"
+#include "gameJournal.hpp"
+#include "replay.hpp"
+#include "spectatorStream.hpp"
 
 namespace s21 {
 class GameController {
@@ -22,10 +33,77 @@ class GameController {
 
   void closeGame();
 
+  void setSpectator(std::unique_ptr<SpectatorStream> spectator);
+  void setJournal(std::unique_ptr<GameJournal> journal);
+  void setFrameRing(std::unique_ptr<FrameRing> frameRing);
+  void setControl(std::unique_ptr<ControlChannel> control);
+  // each new game is recorded and saved to directory when closed
+  void setReplayDirectory(const std::string& directory);
+  // command line options shared by console and desktop versions:
+  //   --spectate <target>  broadcast game, see SpectatorStream::open
+  //   --shm <name>         publish frames to shared memory ring
+  //   --control <name>     take actions from shared memory channel
+  //   --record <dir>       save replay of each new game to directory
+  //   --board <W>x<H>      size of board of new games, 10x20 by default
+  //   --arena <N>          snake is played in arena with N - 1 bots
+  //   --versus <N>         tetris is played against N - 1 bots, match is
+  //                        not journaled or recorded
+  //   --preview <N>        tetris shows N coming pieces, 1 by default
+  //   --journal <path>     journal for resume after crash, JOURNAL_FILE
+  //   --no-journal         by default
+  //   --autoplay           game is played by bot after start, only on
+  //                        10x20 board
+  //   --solver             autoplay, snake goes by Hamiltonian cycle
+  bool applyOptions(int argc, char** argv);
+
  protected:
+  void renderFrame(const GameInfo_t& gameInfo, GameStatus gameStatus);
+  std::vector<PieceGrid> previewPieces() const;
+  // state of model for views and frames
+  GameInfo_t viewState() const;
+  // match of model if it is versus game, else nullptr
+  TetrisVersus* getVersus() const;
+  // journal holds only classic board, so resumed game is classic
+  std::unique_ptr<GameLogic> createGame(GameType type,
+                                        int width = FIELD_WIDTH,
+                                        int height = FIELD_HEIGHT);
+  std::unique_ptr<GameBot> createBot(GameType type);
+  // action of player or bot, through journal if it is on
+  void applyAction(UserAction_t action, bool hold);
+  // tick of model, through journal if it is on
+  void tickModel();
+  void playBot();
+  // applies actions of control channel, acks carry state after each one
+  void playCommands();
+  // pause between iterations of game loop, ends early on command
+  void waitLoop();
+  // offers view to resume game from journal
+  bool resumeGame();
+  void startReplay();
+  void saveReplay();
+
   GameType gameType = GameType::NONE;
   std::unique_ptr<GameLogic> model;
   std::unique_ptr<GameView> view;
+  std::unique_ptr<SpectatorStream> spectator;
+  std::unique_ptr<GameJournal> journal;
+  std::unique_ptr<FrameRing> frameRing;
+  std::unique_ptr<ControlChannel> control;
+  std::unique_ptr<ReplayRecorder> recorder;
+  std::string replayDirectory;
+  // input and loop threads apply and record actions and ticks under it, so
+  // replay logs them in order they were applied
+  std::mutex actionMutex;
+  std::atomic<uint64_t> stateVersion = 0;  // ticks and actions of model
+  int boardWidth = FIELD_WIDTH;
+  int boardHeight = FIELD_HEIGHT;
+  int arenaSnakes = 1;  // more than one: snake game is arena
+  int versusBoards = 1;  // more than one: tetris game is versus match
+  int previewSize = 1;   // pieces of tetris shown ahead
+  bool autoplay = false;
+  bool solver = false;
+  std::unique_ptr<GameBot> bot;
+  std::chrono::steady_clock::time_point lastBotTime;
 };
 }  // namespace s21
 
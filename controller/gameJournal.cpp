@@ -0,0 +1,224 @@
+#include "gameJournal.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace s21;
+
+static uint32_t checksum(const Checkpoint& checkpoint) {
+  uint32_t hash = 2166136261u;
+  auto addBytes = [&hash](const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 16777619u;
+    }
+  };
+  addBytes(&checkpoint.sequence, sizeof(checkpoint.sequence));
+  addBytes(&checkpoint.state, sizeof(checkpoint.state));
+  return hash;
+}
+
+static bool isValid(const Checkpoint& checkpoint) {
+  return checkpoint.state.magic == STATE_MAGIC &&
+         checkpoint.checksum == checksum(checkpoint);
+}
+
+static size_t journalSize(uint32_t capacity) {
+  return sizeof(JournalHeader) + 2 * sizeof(Checkpoint) +
+         capacity * sizeof(JournalEvent);
+}
+
+GameJournal::GameJournal(int flushIntervalMs)
+    : flushIntervalMs(flushIntervalMs) {}
+
+GameJournal::~GameJournal() { close(); }
+
+bool GameJournal::open(const std::string& path, uint32_t capacity) {
+  close();
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t size = journalSize(capacity);
+
+  fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) return false;
+
+  // journal of other size is useless, start it again
+  struct stat info;
+  bool isNew =
+      fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) != size;
+  if (isNew && (ftruncate(fd, 0) < 0 || ftruncate(fd, size) < 0)) {
+    ::close(fd);
+    fd = -1;
+    return false;
+  }
+
+  map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    map = nullptr;
+    ::close(fd);
+    fd = -1;
+    return false;
+  }
+
+  mapSize = size;
+  header = static_cast<JournalHeader*>(map);
+  slots = reinterpret_cast<Checkpoint*>(header + 1);
+  events = reinterpret_cast<JournalEvent*>(slots + 2);
+  if (header->magic != JOURNAL_MAGIC || header->capacity != capacity) {
+    memset(map, 0, size);
+    header->magic = JOURNAL_MAGIC;
+    header->capacity = capacity;
+  }
+
+  this->capacity = capacity;
+  eventsCount = 0;
+  sequence = std::max(slots[0].sequence, slots[1].sequence);
+  activeSlot = slots[0].sequence < slots[1].sequence ? 1 : 0;
+
+  flushing = true;
+  flusher = std::thread(&GameJournal::flushLoop, this);
+  return true;
+}
+
+void GameJournal::close() {
+  {
+    std::lock_guard<std::mutex> lock(flushMutex);
+    flushing = false;
+  }
+  flushWakeUp.notify_all();
+  if (flusher.joinable()) {
+    flusher.join();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (map) {
+    msync(map, mapSize, MS_SYNC);
+    munmap(map, mapSize);
+    map = nullptr;
+    header = nullptr;
+    slots = nullptr;
+    events = nullptr;
+  }
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+void GameJournal::flushLoop() {
+  std::unique_lock<std::mutex> lock(flushMutex);
+  while (flushing) {
+    flushWakeUp.wait_for(lock, std::chrono::milliseconds(flushIntervalMs),
+                         [this]() { return !flushing; });
+    // msync does not block writers of the mapping
+    if (dirty.exchange(false)) {
+      msync(map, mapSize, MS_SYNC);
+    }
+  }
+}
+
+void GameJournal::writeCheckpoint(const GameLogic& game) {
+  int slot = 1 - activeSlot;
+  Checkpoint& checkpoint = slots[slot];
+  checkpoint.sequence = ++sequence;
+  game.saveState(checkpoint.state);
+  // checksum is written last, torn checkpoint stays invalid
+  std::atomic_signal_fence(std::memory_order_release);
+  checkpoint.checksum = checksum(checkpoint);
+  std::atomic_signal_fence(std::memory_order_release);
+
+  activeSlot = slot;
+  eventsCount = 0;
+  dirty = true;
+}
+
+void GameJournal::append(JournalEventType type, uint8_t action, uint8_t hold,
+                         const GameLogic& game) {
+  if (eventsCount == capacity) {
+    // state after this event, so it is not logged
+    writeCheckpoint(game);
+  } else {
+    JournalEvent event = {sequence, static_cast<uint8_t>(type), action, hold,
+                          0};
+    events[eventsCount++] = event;
+    dirty = true;
+  }
+}
+
+void GameJournal::checkpoint(const GameLogic& game) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (events) {
+    writeCheckpoint(game);
+  }
+}
+
+void GameJournal::gameTick(GameLogic& game) {
+  std::lock_guard<std::mutex> lock(mutex);
+  game.gameTick();
+  if (events) {
+    append(JournalEventType::TICK, 0, 0, game);
+  }
+}
+
+void GameJournal::userInput(GameLogic& game, UserAction_t action, bool hold) {
+  std::lock_guard<std::mutex> lock(mutex);
+  game.userInput(action, hold);
+  if (events) {
+    append(JournalEventType::INPUT, static_cast<uint8_t>(action), hold, game);
+  }
+}
+
+void GameJournal::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (events) {
+    // sequences are kept, so old events never match new checkpoints
+    slots[0].state.magic = 0;
+    slots[1].state.magic = 0;
+    eventsCount = 0;
+    dirty = true;
+  }
+}
+
+const Checkpoint* GameJournal::lastCheckpoint() const {
+  const Checkpoint* last = nullptr;
+  for (int i = 0; events && i < 2; i++) {
+    if (isValid(slots[i]) &&
+        (last == nullptr || slots[i].sequence > last->sequence)) {
+      last = &slots[i];
+    }
+  }
+  return last;
+}
+
+GameType GameJournal::getSavedGame() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  const Checkpoint* checkpoint = lastCheckpoint();
+  return checkpoint ? static_cast<GameType>(checkpoint->state.gameType)
+                    : GameType::NONE;
+}
+
+bool GameJournal::restore(GameLogic& game) {
+  std::lock_guard<std::mutex> lock(mutex);
+  const Checkpoint* checkpoint = lastCheckpoint();
+  bool isRestored = checkpoint && game.loadState(checkpoint->state);
+
+  for (uint32_t i = 0;
+       isRestored && i < capacity && events[i].sequence == checkpoint->sequence;
+       i++) {
+    if (events[i].type == static_cast<uint8_t>(JournalEventType::TICK)) {
+      game.gameTick();
+    } else {
+      game.userInput(static_cast<UserAction_t>(events[i].action),
+                     events[i].hold);
+    }
+  }
+
+  // continue from restored state with empty log
+  if (isRestored) {
+    writeCheckpoint(game);
+  }
+  return isRestored;
+}
@@ -0,0 +1,97 @@
+#ifndef GAME_JOURNAL_HPP
+#define GAME_JOURNAL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../retro_games/gameLogic.hpp"
+
+namespace s21 {
+
+#define JOURNAL_FILE "game_journal.db"
+#define JOURNAL_MAGIC 0x4C4E524A  // "JRNL"
+
+// Journal file, memory mapped, host byte order:
+//   JournalHeader | Checkpoint[2] | JournalEvent[capacity]
+// Checkpoints are written to slots in turn, so a torn checkpoint leaves the
+// previous one valid. Events carry sequence of their checkpoint, events of
+// older checkpoints are not replayed.
+struct JournalHeader {
+  uint32_t magic;
+  uint32_t capacity;
+};
+
+struct Checkpoint {
+  uint32_t sequence;
+  uint32_t checksum;  // FNV-1a of sequence and state
+  GameState_t state;
+};
+
+enum class JournalEventType : uint8_t { TICK = 1, INPUT };
+
+struct JournalEvent {
+  uint32_t sequence;
+  uint8_t type;
+  uint8_t action;
+  uint8_t hold;
+  uint8_t reserved;
+};
+
+// Crash-safe log of current game. Inputs and ticks pass through journal to
+// game and are appended to mapped file, full log is replaced by checkpoint.
+// The file is synced to disk by background thread, never on tick path.
+class GameJournal {
+ public:
+  explicit GameJournal(int flushIntervalMs = 1000);
+  ~GameJournal();
+
+  bool open(const std::string& path, uint32_t capacity = 4096);
+  void close();
+  bool isOpen() const { return events != nullptr; }
+
+  // start log from current state of game
+  void checkpoint(const GameLogic& game);
+  void gameTick(GameLogic& game);
+  void userInput(GameLogic& game, UserAction_t action, bool hold);
+  // game is over or closed, nothing to resume
+  void clear();
+
+  // type of game which can be resumed, NONE if there is none
+  GameType getSavedGame() const;
+  // loads last checkpoint into game and replays events after it
+  bool restore(GameLogic& game);
+
+  uint32_t getEventsCount() const { return eventsCount; }
+
+ private:
+  const Checkpoint* lastCheckpoint() const;
+  void append(JournalEventType type, uint8_t action, uint8_t hold,
+              const GameLogic& game);
+  void writeCheckpoint(const GameLogic& game);
+  void flushLoop();
+
+  mutable std::mutex mutex;
+  void* map = nullptr;
+  size_t mapSize = 0;
+  int fd = -1;
+  JournalHeader* header = nullptr;
+  Checkpoint* slots = nullptr;
+  JournalEvent* events = nullptr;
+  uint32_t capacity = 0;
+  uint32_t eventsCount = 0;
+  uint32_t sequence = 0;
+  int activeSlot = 0;
+
+  int flushIntervalMs;
+  std::thread flusher;
+  std::mutex flushMutex;
+  std::condition_variable flushWakeUp;
+  std::atomic<bool> dirty = false;
+  bool flushing = false;
+};
+}  // namespace s21
+
+#endif  // GAME_JOURNAL_HPP
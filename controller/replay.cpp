@@ -0,0 +1,182 @@
+#include "replay.hpp"
+
+#include <cstdio>
+
+using namespace s21;
+
+ReplayRecorder::ReplayRecorder(uint32_t keyframeInterval)
+    : keyframeInterval(keyframeInterval ? keyframeInterval : 1) {}
+
+void ReplayRecorder::start(GameLogic& game, GameType gameType,
+                           uint64_t seed) {
+  game.setSeed(seed);
+  header = {};
+  header.magic = REPLAY_MAGIC;
+  header.gameType = static_cast<uint8_t>(gameType);
+  header.seed = seed;
+  events.clear();
+  keyframes.resize(1);
+  game.saveState(keyframes[0]);
+  header.previewSize = keyframes[0].previewSize;
+  recording = true;
+}
+
+void ReplayRecorder::append(const GameLogic& game, const ReplayEvent& event) {
+  if (!recording) return;
+  events.push_back(event);
+  if (events.size() % keyframeInterval == 0) {
+    keyframes.emplace_back();
+    game.saveState(keyframes.back());
+  }
+}
+
+void ReplayRecorder::gameTick(const GameLogic& game) {
+  append(game, {static_cast<uint8_t>(ReplayEventType::TICK), 0, 0, 0});
+}
+
+void ReplayRecorder::userInput(const GameLogic& game, UserAction_t action,
+                               bool hold) {
+  append(game, {static_cast<uint8_t>(ReplayEventType::INPUT),
+                static_cast<uint8_t>(action), hold, 0});
+}
+
+bool ReplayRecorder::save(const GameLogic& game, const std::string& path) {
+  if (!recording) return false;
+  recording = false;
+
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  header.status = static_cast<uint8_t>(game.getCurrentGameStatus());
+  header.eventsCount = static_cast<uint32_t>(events.size());
+  header.score = gameInfo.score;
+  header.level = gameInfo.level;
+  header.hash = game.getHash();
+
+  ReplayIndex index = {};
+  index.magic = REPLAY_INDEX_MAGIC;
+  index.interval = keyframeInterval;
+  index.keyframesCount = static_cast<uint32_t>(keyframes.size());
+  index.keyframesOffset = sizeof(header) + events.size() * sizeof(ReplayEvent);
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) return false;
+  bool isSaved =
+      fwrite(&header, sizeof(header), 1, file) == 1 &&
+      fwrite(events.data(), sizeof(ReplayEvent), events.size(), file) ==
+          events.size() &&
+      fwrite(keyframes.data(), sizeof(GameState_t), keyframes.size(),
+             file) == keyframes.size() &&
+      fwrite(&index, sizeof(index), 1, file) == 1;
+  isSaved &= fclose(file) == 0;
+  return isSaved;
+}
+
+// broken counts must not allocate more than file holds
+static bool readEvents(FILE* file, ReplayHeader& header,
+                       std::vector<ReplayEvent>& events, uint64_t& size) {
+  bool isRead = fread(&header, sizeof(header), 1, file) == 1 &&
+                header.magic == REPLAY_MAGIC && fseek(file, 0, SEEK_END) == 0;
+  long end = isRead ? ftell(file) : -1;
+  size = end < 0 ? 0 : static_cast<uint64_t>(end);
+  isRead = isRead && end >= 0 &&
+           size >= sizeof(header) + uint64_t{header.eventsCount} *
+                                        sizeof(ReplayEvent) &&
+           fseek(file, sizeof(header), SEEK_SET) == 0;
+  if (isRead) {
+    events.resize(header.eventsCount);
+    isRead = fread(events.data(), sizeof(ReplayEvent), events.size(),
+                   file) == events.size();
+  }
+  return isRead;
+}
+
+bool s21::readReplay(const std::string& path, ReplayHeader& header,
+                     std::vector<ReplayEvent>& events) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) return false;
+  uint64_t size = 0;
+  bool isRead = readEvents(file, header, events, size);
+  fclose(file);
+  return isRead;
+}
+
+bool s21::readReplay(const std::string& path, ReplayHeader& header,
+                     std::vector<ReplayEvent>& events, ReplayIndex& index,
+                     std::vector<GameState_t>& keyframes) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) return false;
+  uint64_t size = 0;
+  bool isRead = readEvents(file, header, events, size) &&
+                size >= sizeof(index) &&
+                fseek(file, size - sizeof(index), SEEK_SET) == 0 &&
+                fread(&index, sizeof(index), 1, file) == 1;
+
+  uint64_t eventsEnd =
+      sizeof(header) + uint64_t{header.eventsCount} * sizeof(ReplayEvent);
+  isRead = isRead && index.magic == REPLAY_INDEX_MAGIC && index.interval &&
+           index.keyframesCount == header.eventsCount / index.interval + 1 &&
+           index.keyframesOffset == eventsEnd &&
+           eventsEnd + index.keyframesCount * sizeof(GameState_t) +
+                   sizeof(index) ==
+               size &&
+           fseek(file, index.keyframesOffset, SEEK_SET) == 0;
+  if (isRead) {
+    keyframes.resize(index.keyframesCount);
+    isRead = fread(keyframes.data(), sizeof(GameState_t), keyframes.size(),
+                   file) == keyframes.size();
+  }
+  fclose(file);
+  return isRead;
+}
+
+static bool applyEvent(GameLogic& game, const ReplayEvent& event) {
+  bool isValid = true;
+  if (event.type == static_cast<uint8_t>(ReplayEventType::TICK)) {
+    game.gameTick();
+  } else if (event.type == static_cast<uint8_t>(ReplayEventType::INPUT) &&
+             event.action <= static_cast<uint8_t>(UserAction_t::HardDrop)) {
+    game.userInput(static_cast<UserAction_t>(event.action), event.hold);
+  } else {
+    isValid = false;
+  }
+  return isValid;
+}
+
+bool ReplayPlayer::open(const std::string& path) {
+  lastGame = nullptr;
+  position = 0;
+  bool isOpen = readReplay(path, header, events, index, keyframes);
+  if (!isOpen) {
+    keyframes.clear();
+  }
+  return isOpen;
+}
+
+bool ReplayPlayer::seek(GameLogic& game, uint32_t target) {
+  if (keyframes.empty() || target > header.eventsCount) return false;
+
+  // game of caller is a keyframe too, if it is nearer
+  uint32_t keyframe = target / index.interval;
+  bool isLoaded = &game == lastGame && position <= target &&
+                  position >= keyframe * index.interval;
+  if (!isLoaded) {
+    isLoaded = game.loadState(keyframes[keyframe]);
+    position = keyframe * index.interval;
+  }
+
+  lastGame = isLoaded ? &game : nullptr;
+  while (lastGame && position < target) {
+    step(game);
+  }
+  return lastGame != nullptr;
+}
+
+bool ReplayPlayer::step(GameLogic& game) {
+  bool isStepped = &game == lastGame && position < header.eventsCount &&
+                   applyEvent(game, events[position]);
+  if (isStepped) {
+    position++;
+  } else if (position < header.eventsCount) {
+    lastGame = nullptr;
+  }
+  return isStepped;
+}
@@ -0,0 +1,114 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <string>
+#include <vector>
+
+#include "../retro_games/gameLogic.hpp"
+
+namespace s21 {
+
+#define REPLAY_MAGIC 0x594C5052        // "RPLY"
+#define REPLAY_INDEX_MAGIC 0x58444952  // "RIDX"
+#define REPLAY_EXTENSION ".replay"
+#define KEYFRAME_INTERVAL 256  // events between keyframes
+
+// Replay file, host byte order:
+//   ReplayHeader | ReplayEvent[eventsCount] | GameState_t[keyframesCount] |
+//   ReplayIndex
+// Session starts from new game seeded with seed, events are applied in
+// order. Header keeps result of the session to check replay against it.
+// Keyframe k is state after k * interval events, index at the end of file
+// tells where keyframes are, so position n is reached from keyframe
+// n / interval by at most interval events.
+struct ReplayHeader {
+  uint32_t magic;
+  uint8_t gameType;
+  uint8_t status;       // GameStatus after last event
+  uint8_t previewSize;  // of Tetris, 0 for default
+  uint8_t reserved;
+  uint64_t seed;
+  uint32_t eventsCount;
+  int32_t score;
+  int32_t level;
+  uint32_t reserved2;
+  uint64_t hash;  // GameLogic::getHash after last event
+};
+
+enum class ReplayEventType : uint8_t { TICK = 1, INPUT };
+
+struct ReplayEvent {
+  uint8_t type;
+  uint8_t action;
+  uint8_t hold;
+  uint8_t reserved;
+};
+
+struct ReplayIndex {
+  uint32_t magic;
+  uint32_t interval;
+  uint32_t keyframesCount;
+  uint32_t reserved;
+  uint64_t keyframesOffset;
+};
+
+// Records session of one game from its creation. Events are only logged,
+// the caller applies them to game itself and passes game after them, as
+// journal does.
+class ReplayRecorder {
+ public:
+  explicit ReplayRecorder(uint32_t keyframeInterval = KEYFRAME_INTERVAL);
+
+  // seeds new game and starts empty log
+  void start(GameLogic& game, GameType gameType, uint64_t seed);
+  bool isRecording() const { return recording; }
+  uint64_t getSeed() const { return header.seed; }
+  void gameTick(const GameLogic& game);
+  void userInput(const GameLogic& game, UserAction_t action, bool hold);
+  // writes log with result of game, recording stops
+  bool save(const GameLogic& game, const std::string& path);
+
+ private:
+  void append(const GameLogic& game, const ReplayEvent& event);
+
+  uint32_t keyframeInterval;
+  ReplayHeader header = {};
+  std::vector<ReplayEvent> events;
+  std::vector<GameState_t> keyframes;
+  bool recording = false;
+};
+
+// events are read into vector of caller, so its memory is reused
+bool readReplay(const std::string& path, ReplayHeader& header,
+                std::vector<ReplayEvent>& events);
+bool readReplay(const std::string& path, ReplayHeader& header,
+                std::vector<ReplayEvent>& events, ReplayIndex& index,
+                std::vector<GameState_t>& keyframes);
+
+// Moves game of caller to any position of replay, forwards or backwards.
+// Position is number of events applied.
+class ReplayPlayer {
+ public:
+  bool open(const std::string& path);
+
+  const ReplayHeader& getHeader() const { return header; }
+  uint32_t getLength() const { return header.eventsCount; }
+  uint32_t getPosition() const { return position; }
+
+  // game must be of replay type; it goes on from its position if it was
+  // moved only by player and it is the nearest way
+  bool seek(GameLogic& game, uint32_t target);
+  // applies next event, false at the end
+  bool step(GameLogic& game);
+
+ private:
+  ReplayHeader header = {};
+  std::vector<ReplayEvent> events;
+  ReplayIndex index = {};
+  std::vector<GameState_t> keyframes;
+  const GameLogic* lastGame = nullptr;
+  uint32_t position = 0;
+};
+}  // namespace s21
+
+#endif  // REPLAY_HPP
@@ -0,0 +1,213 @@
+#include "replayVerifier.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#include "../retro_games/snake/snakeLogic.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+
+using namespace s21;
+
+// games and buffers of one thread, reused for all its replays
+struct Simulator {
+  TetrisLogic tetris;
+  SnakeLogic snake;
+  GameState_t newTetris;
+  GameState_t newSnake;
+  ReplayHeader header;
+  std::vector<ReplayEvent> events;
+
+  Simulator() {
+    tetris.saveState(newTetris);
+    snake.saveState(newSnake);
+  }
+
+  GameLogic* getGame(uint8_t gameType) {
+    GameLogic* game = nullptr;
+    if (gameType == static_cast<uint8_t>(GameType::TETRIS)) {
+      game = &tetris;
+    } else if (gameType == static_cast<uint8_t>(GameType::SNAKE)) {
+      game = &snake;
+    }
+    return game;
+  }
+
+  // state of new game with seed of replay
+  bool getNewGame(const ReplayHeader& header, GameState_t& state) {
+    GameLogic* game = getGame(header.gameType);
+    if (game) {
+      state = game == &tetris ? newTetris : newSnake;
+      state.random = RandomGenerator(header.seed).getState();
+      if (game == &tetris && header.previewSize > 0) {
+        state.previewSize = header.previewSize;
+      }
+    }
+    return game != nullptr;
+  }
+};
+
+// calls are qualified with Game:: so they are not virtual
+template <class Game>
+static bool simulate(Game& game, const GameState_t& start,
+                     const ReplayEvent* events, size_t count) {
+  bool isValid = game.Game::loadState(start);
+  for (size_t i = 0; i < count && isValid; i++) {
+    const ReplayEvent& event = events[i];
+    if (event.type == static_cast<uint8_t>(ReplayEventType::TICK)) {
+      game.Game::gameTick();
+    } else if (event.type == static_cast<uint8_t>(ReplayEventType::INPUT) &&
+               event.action <= static_cast<uint8_t>(UserAction_t::HardDrop)) {
+      game.Game::userInput(static_cast<UserAction_t>(event.action),
+                           event.hold);
+    } else {
+      isValid = false;
+    }
+  }
+  return isValid;
+}
+
+static bool simulate(Simulator& simulator, GameLogic* game,
+                     const GameState_t& start, const ReplayEvent* events,
+                     size_t count) {
+  bool isValid = false;
+  if (game == &simulator.tetris) {
+    isValid = simulate(simulator.tetris, start, events, count);
+  } else if (game == &simulator.snake) {
+    isValid = simulate(simulator.snake, start, events, count);
+  }
+  return isValid;
+}
+
+static bool isRecordedResult(const GameLogic& game,
+                             const ReplayHeader& header) {
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  return gameInfo.score == header.score && gameInfo.level == header.level &&
+         game.getCurrentGameStatus() ==
+             static_cast<GameStatus>(header.status) &&
+         game.getHash() == header.hash;
+}
+
+// high score comes from file of player, it is not a part of game
+static bool isSameState(const GameState_t& state, GameState_t other) {
+  other.high_score = state.high_score;
+  return memcmp(&state, &other, sizeof(state)) == 0;
+}
+
+static ReplayResult verifyReplay(Simulator& simulator,
+                                 const std::string& path) {
+  ReplayResult result = {ReplayVerdict::UNREADABLE, 0, 0};
+  ReplayHeader& header = simulator.header;
+  if (!readReplay(path, header, simulator.events)) return result;
+  result.recordedScore = header.score;
+
+  GameLogic* game = simulator.getGame(header.gameType);
+  GameState_t start;
+  if (simulator.getNewGame(header, start) &&
+      simulate(simulator, game, start, simulator.events.data(),
+               simulator.events.size())) {
+    result.score = game->getGameInfo().score;
+    result.verdict = isRecordedResult(*game, header) ? ReplayVerdict::MATCH
+                                                     : ReplayVerdict::DIVERGED;
+  }
+  return result;
+}
+
+// calling thread works too
+static void runThreads(int threads, size_t tasks,
+                       const std::function<void()>& work) {
+  int count = std::min<int>(threads, std::max<size_t>(1, tasks));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < count; i++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+ReplayVerifier::ReplayVerifier(int threads) {
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  this->threads = std::max(1, threads);
+}
+
+std::vector<std::string> ReplayVerifier::listReplays(
+    const std::string& directory) {
+  std::vector<std::string> paths;
+  std::error_code error;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error)) {
+    if (entry.is_regular_file(error) &&
+        entry.path().extension() == REPLAY_EXTENSION) {
+      paths.push_back(entry.path().string());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+std::vector<ReplayResult> ReplayVerifier::verify(
+    const std::vector<std::string>& paths) {
+  std::vector<ReplayResult> results(paths.size());
+  std::atomic<size_t> next = 0;
+  runThreads(threads, paths.size(), [&]() {
+    Simulator simulator;
+    for (size_t i = next++; i < paths.size(); i = next++) {
+      results[i] = verifyReplay(simulator, paths[i]);
+    }
+  });
+  return results;
+}
+
+ReplayResult ReplayVerifier::verifySplit(const std::string& path) {
+  ReplayResult result = {ReplayVerdict::UNREADABLE, 0, 0};
+  ReplayHeader header;
+  std::vector<ReplayEvent> events;
+  ReplayIndex index;
+  std::vector<GameState_t> keyframes;
+  if (!readReplay(path, header, events, index, keyframes)) return result;
+  result.recordedScore = header.score;
+
+  size_t segments = keyframes.size();
+  std::atomic<size_t> next = 0;
+  std::atomic<bool> isBroken = false;
+  std::atomic<bool> isDiverged = false;
+  runThreads(threads, segments, [&]() {
+    Simulator simulator;
+    GameState_t start;
+    GameState_t end;
+    GameLogic* game = simulator.getGame(header.gameType);
+    isBroken = isBroken || !simulator.getNewGame(header, start);
+
+    for (size_t i = next++; i < segments && !isBroken; i = next++) {
+      if (i > 0) {
+        start = keyframes[i];
+      } else if (!isSameState(start, keyframes[0])) {
+        isDiverged = true;
+      }
+      size_t first = i * index.interval;
+      size_t count = std::min<size_t>(index.interval, events.size() - first);
+      if (!simulate(simulator, game, start, events.data() + first, count)) {
+        isBroken = true;
+      } else if (i + 1 < segments) {
+        game->saveState(end);
+        isDiverged = isDiverged || !isSameState(end, keyframes[i + 1]);
+      } else {
+        result.score = game->getGameInfo().score;
+        isDiverged = isDiverged || !isRecordedResult(*game, header);
+      }
+    }
+  });
+
+  if (!isBroken) {
+    result.verdict =
+        isDiverged ? ReplayVerdict::DIVERGED : ReplayVerdict::MATCH;
+  }
+  return result;
+}
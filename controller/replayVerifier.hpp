@@ -0,0 +1,40 @@
+#ifndef REPLAY_VERIFIER_HPP
+#define REPLAY_VERIFIER_HPP
+
+#include "replay.hpp"
+
+namespace s21 {
+
+enum class ReplayVerdict { MATCH, DIVERGED, UNREADABLE };
+
+struct ReplayResult {
+  ReplayVerdict verdict;
+  int32_t recordedScore;
+  int32_t score;  // got by simulation
+};
+
+// Simulates replays again on all cores and compares result with recorded
+// one: score, level, status and hash of final state. Each thread keeps its
+// own games and buffers, replays are taken one by one from shared counter,
+// so long replays do not hold other threads. High score storage should
+// be off while verifying, see GameLogic::setHighScoreStorage.
+class ReplayVerifier {
+ public:
+  // threads <= 0 takes number of cores
+  explicit ReplayVerifier(int threads = 0);
+
+  // files with REPLAY_EXTENSION in directory, sorted
+  static std::vector<std::string> listReplays(const std::string& directory);
+  // results in order of paths
+  std::vector<ReplayResult> verify(const std::vector<std::string>& paths);
+  // one long replay split by keyframes between threads: each segment
+  // starts from its keyframe and must end in the next one, first keyframe
+  // must be new game and the last segment must give recorded result
+  ReplayResult verifySplit(const std::string& path);
+
+ private:
+  int threads;
+};
+}  // namespace s21
+
+#endif  // REPLAY_VERIFIER_HPP
@@ -0,0 +1,267 @@
+#include "spectatorStream.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+using namespace s21;
+
+//
+// ============================================================================
+// Encoder and decoder of frames
+// ============================================================================
+
+static RecordHeader makeHeader(RecordType type, const Frame_t& frame) {
+  RecordHeader header = {};
+  header.type = static_cast<uint8_t>(type);
+  header.status = frame.status;
+  header.pause = frame.pause;
+  header.number = frame.number;
+  header.score = frame.score;
+  header.high_score = frame.high_score;
+  header.level = frame.level;
+  header.speed = frame.speed;
+  return header;
+}
+
+SpectatorEncoder::SpectatorEncoder(int keyframeInterval)
+    : keyframeInterval(keyframeInterval) {}
+
+bool SpectatorEncoder::encode(const Frame_t& frame, std::string& out) {
+  CellChange changes[FRAME_CELLS];
+  int count = 0;
+
+  bool isKeyframe = !hasPrevious || sinceKeyframe >= keyframeInterval ||
+                    frame.gameType != previous.gameType;
+  if (!isKeyframe) {
+    const int fieldCells = FIELD_WIDTH * FIELD_HEIGHT;
+    const uint8_t* cells = &frame.field[0][0];
+    const uint8_t* oldCells = &previous.field[0][0];
+    for (int i = 0; i < fieldCells; i++) {
+      if (cells[i] != oldCells[i]) {
+        changes[count++] = {static_cast<uint8_t>(i), cells[i]};
+      }
+    }
+    cells = &frame.next[0][0];
+    oldCells = &previous.next[0][0];
+    for (int i = 0; i < NEXT_WIDTH * NEXT_HEIGHT; i++) {
+      if (cells[i] != oldCells[i]) {
+        changes[count++] = {static_cast<uint8_t>(fieldCells + i), cells[i]};
+      }
+    }
+
+    // big delta is not cheaper than keyframe
+    isKeyframe = count * sizeof(CellChange) >= sizeof(Frame_t);
+  }
+
+  if (isKeyframe) {
+    RecordHeader header = makeHeader(RecordType::KEYFRAME, frame);
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(&frame), sizeof(frame));
+    sinceKeyframe = 0;
+  } else {
+    RecordHeader header = makeHeader(RecordType::DELTA, frame);
+    header.changes = static_cast<uint8_t>(count);
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(changes),
+               count * sizeof(CellChange));
+  }
+
+  previous = frame;
+  hasPrevious = true;
+  sinceKeyframe++;
+
+  return isKeyframe;
+}
+
+void SpectatorDecoder::feed(const char* data, size_t size) {
+  buffer.append(data, size);
+  while (applyRecord()) {
+  }
+}
+
+// returns false if buffer has no complete record
+bool SpectatorDecoder::applyRecord() {
+  if (buffer.size() < sizeof(RecordHeader)) return false;
+
+  RecordHeader header;
+  memcpy(&header, buffer.data(), sizeof(header));
+  const char* payload = buffer.data() + sizeof(header);
+  size_t payloadSize = 0;
+  RecordType type = static_cast<RecordType>(header.type);
+
+  if (type == RecordType::KEYFRAME) {
+    payloadSize = sizeof(Frame_t);
+  } else if (type == RecordType::DELTA) {
+    payloadSize = header.changes * sizeof(CellChange);
+  } else {  // broken stream
+    buffer.clear();
+    synced = false;
+    return false;
+  }
+  if (buffer.size() < sizeof(header) + payloadSize) return false;
+
+  if (type == RecordType::KEYFRAME) {
+    memcpy(&frame, payload, sizeof(frame));
+    synced = true;
+  } else if (synced && header.number != frame.number + 1) {
+    synced = false;  // lost record, wait next keyframe
+  } else if (synced) {
+    const int fieldCells = FIELD_WIDTH * FIELD_HEIGHT;
+    for (int i = 0; i < header.changes; i++) {
+      CellChange change;
+      memcpy(&change, payload + i * sizeof(change), sizeof(change));
+      if (change.index < fieldCells) {
+        (&frame.field[0][0])[change.index] = change.value;
+      } else if (change.index < FRAME_CELLS) {
+        (&frame.next[0][0])[change.index - fieldCells] = change.value;
+      }
+    }
+    frame.status = header.status;
+    frame.pause = header.pause;
+    frame.number = header.number;
+    frame.score = header.score;
+    frame.high_score = header.high_score;
+    frame.level = header.level;
+    frame.speed = header.speed;
+  }
+
+  if (synced) {
+    framesCount++;
+  }
+  buffer.erase(0, sizeof(header) + payloadSize);
+
+  return true;
+}
+
+//
+// ============================================================================
+// Output of stream
+// ============================================================================
+
+SpectatorStream::SpectatorStream(int keyframeInterval)
+    : encoder(keyframeInterval) {}
+
+SpectatorStream::~SpectatorStream() {
+  for (int fd : clients) {
+    close(fd);
+  }
+  if (fileFd >= 0) {
+    close(fileFd);
+  }
+  if (listenFd >= 0) {
+    close(listenFd);
+    unlink(socketPath.c_str());
+  }
+}
+
+bool SpectatorStream::openFile(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex);
+  struct stat info;
+
+  // FIFO is opened for read too, so open does not wait for reader
+  if (stat(path.c_str(), &info) == 0 && S_ISFIFO(info.st_mode)) {
+    fileFd = ::open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  } else {
+    fileFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0644);
+  }
+
+  return fileFd >= 0;
+}
+
+bool SpectatorStream::listen(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex);
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) return false;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) return false;
+
+  unlink(path.c_str());
+  if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      ::listen(listenFd, SOMAXCONN) < 0) {
+    close(listenFd);
+    listenFd = -1;
+  } else {
+    socketPath = path;
+  }
+
+  return listenFd >= 0;
+}
+
+bool SpectatorStream::open(const std::string& target) {
+  bool isOpen = false;
+  if (target.rfind("unix:", 0) == 0) {
+    isOpen = listen(target.substr(5));
+  } else if (target.rfind("file:", 0) == 0) {
+    isOpen = openFile(target.substr(5));
+  } else {
+    isOpen = openFile(target);
+  }
+  return isOpen;
+}
+
+// spectator that can not take whole record is too slow and is disconnected
+bool SpectatorStream::writeAll(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t count = send(fd, data.data() + sent, data.size() - sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (count <= 0) break;
+    sent += count;
+  }
+  return sent == data.size();
+}
+
+void SpectatorStream::acceptClients() {
+  while (true) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) break;
+
+    if (writeAll(fd, backlog)) {
+      clients.push_back(fd);
+    } else {
+      close(fd);
+    }
+  }
+}
+
+void SpectatorStream::publish(const GameInfo_t& gameInfo,
+                              GameStatus gameStatus, GameType gameType) {
+  std::lock_guard<std::mutex> lock(mutex);
+  Frame_t frame;
+  packFrame(gameInfo, gameStatus, gameType, frame);
+  frame.number = ++frameNumber;
+
+  record.clear();
+  if (encoder.encode(frame, record)) {
+    backlog.clear();
+  }
+  backlog += record;
+
+  // records are smaller than PIPE_BUF, FIFO writes them whole or drops
+  if (fileFd >= 0 && write(fileFd, record.data(), record.size()) < 0) {
+    // reader of FIFO is too slow, it resyncs on next keyframe
+  }
+
+  if (listenFd >= 0) {
+    for (size_t i = 0; i < clients.size();) {
+      if (writeAll(clients[i], record)) {
+        i++;
+      } else {
+        close(clients[i]);
+        clients[i] = clients.back();
+        clients.pop_back();
+      }
+    }
+    acceptClients();
+  }
+}
@@ -0,0 +1,102 @@
+#ifndef SPECTATOR_STREAM_HPP
+#define SPECTATOR_STREAM_HPP
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "frame.hpp"
+
+namespace s21 {
+// Stream format, host byte order:
+//   KEYFRAME: RecordHeader + full Frame_t
+//   DELTA:    RecordHeader + changes * CellChange against previous frame
+// Cells of field and next are numbered row by row, next follows field.
+enum class RecordType : uint8_t { KEYFRAME = 1, DELTA };
+
+struct RecordHeader {
+  uint8_t type;
+  uint8_t changes;
+  uint8_t status;
+  uint8_t pause;
+  uint32_t number;
+  int32_t score;
+  int32_t high_score;
+  int32_t level;
+  int32_t speed;
+};
+
+struct CellChange {
+  uint8_t index;
+  uint8_t value;
+};
+
+#define FRAME_CELLS (FIELD_WIDTH * FIELD_HEIGHT + NEXT_WIDTH * NEXT_HEIGHT)
+static_assert(FRAME_CELLS <= 256, "cell index must fit one byte");
+
+class SpectatorEncoder {
+ public:
+  explicit SpectatorEncoder(int keyframeInterval = 50);
+  // append record of frame to out, returns true if it is keyframe
+  bool encode(const Frame_t& frame, std::string& out);
+
+ private:
+  int keyframeInterval;
+  int sinceKeyframe = 0;
+  bool hasPrevious = false;
+  Frame_t previous = {};
+};
+
+class SpectatorDecoder {
+ public:
+  // accepts stream in chunks of any size, deltas before keyframe are skipped
+  void feed(const char* data, size_t size);
+  bool isSynced() const { return synced; }
+  const Frame_t& getFrame() const { return frame; }
+  uint32_t getFramesCount() const { return framesCount; }
+
+ private:
+  bool applyRecord();
+
+  std::string buffer;
+  Frame_t frame = {};
+  bool synced = false;
+  uint32_t framesCount = 0;
+};
+
+// Broadcasts game to spectators: file, FIFO or local socket.
+// Socket clients that join late get the last keyframe and following deltas.
+class SpectatorStream {
+ public:
+  explicit SpectatorStream(int keyframeInterval = 50);
+  ~SpectatorStream();
+
+  bool openFile(const std::string& path);
+  bool listen(const std::string& socketPath);
+  // "unix:<path>" listens socket, "file:<path>" or "<path>" writes file/FIFO
+  bool open(const std::string& target);
+
+  void publish(const GameInfo_t& gameInfo, GameStatus gameStatus,
+               GameType gameType);
+  size_t getClientsCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return clients.size();
+  }
+
+ private:
+  void acceptClients();
+  bool writeAll(int fd, const std::string& data);
+
+  mutable std::mutex mutex;  // clients are changed by publish
+  SpectatorEncoder encoder;
+  std::string record;
+  std::string backlog;  // last keyframe and deltas after it
+  uint32_t frameNumber = 0;
+  int fileFd = -1;
+  int listenFd = -1;
+  std::string socketPath;
+  std::vector<int> clients;
+};
+}  // namespace s21
+
+#endif  // SPECTATOR_STREAM_HPP
@@ -0,0 +1,259 @@
+#include "tickScheduler.hpp"
+
+using namespace s21;
+using namespace std::chrono;
+
+// 1 ms per slot, one turn of wheel covers the longest delay (first level)
+#define WHEEL_SLOTS 1024
+
+struct TickScheduler::Entry {
+  GameId id;
+  GameEngine game;
+  std::mutex mutex;
+  uint64_t deadline = 0;
+  bool removed = false;
+};
+
+struct TickScheduler::Worker {
+  std::thread thread;
+  std::mutex mutex;
+  std::deque<Entry*> tasks;
+};
+
+TickScheduler::TickScheduler(int workersCount, int initialDelay)
+    : workersCount(workersCount), initialDelay(initialDelay) {
+  if (this->workersCount <= 0) {
+    this->workersCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  startTime = steady_clock::now();
+  wheel.resize(WHEEL_SLOTS);
+}
+
+TickScheduler::~TickScheduler() { stop(); }
+
+uint64_t TickScheduler::nowMs() const {
+  return duration_cast<milliseconds>(steady_clock::now() - startTime).count();
+}
+
+TickScheduler::GameId TickScheduler::addGame(GameType type, uint64_t seed) {
+  Entry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    if (!freeEntries.empty()) {
+      entry = freeEntries.back();
+      freeEntries.pop_back();
+    } else {
+      entries.push_back(std::make_unique<Entry>());
+      entry = entries.back().get();
+      entry->id = static_cast<GameId>(entries.size() - 1);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    entry->removed = false;
+    entry->game.reset(type);
+    entry->game.setSeed(seed);
+    int speed = entry->game.getGameInfo().speed;
+    entry->deadline = nowMs() + getDelay(speed, initialDelay);
+  }
+  insertToWheel(entry);
+
+  return entry->id;
+}
+
+void TickScheduler::removeGame(GameId id) {
+  Entry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    if (id < entries.size()) entry = entries[id].get();
+  }
+
+  // entry stays in wheel, it is freed on the next due tick
+  if (entry) {
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    entry->removed = true;
+    entry->game.reset(GameType::NONE);
+  }
+}
+
+void TickScheduler::userInput(GameId id, UserAction_t action, bool hold) {
+  Entry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    if (id < entries.size()) entry = entries[id].get();
+  }
+
+  if (entry) {
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (!entry->removed) {
+      entry->game.userInput(action, hold);
+    }
+  }
+}
+
+void TickScheduler::setTickCallback(TickCallback callback) {
+  onTick = std::move(callback);
+}
+
+void TickScheduler::start() {
+  if (running) return;
+  running = true;
+
+  // wheel jumps to now, so games added while it was stopped are put again
+  // by their deadlines; late ones go to the next slot instead of waiting
+  // for a turn of wheel
+  {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    std::vector<Entry*> waiting;
+    for (std::vector<Entry*>& slot : wheel) {
+      waiting.insert(waiting.end(), slot.begin(), slot.end());
+      slot.clear();
+    }
+    wheelTime = nowMs();
+    for (Entry* entry : waiting) {
+      uint64_t slot = std::max(entry->deadline, wheelTime + 1) % WHEEL_SLOTS;
+      wheel[slot].push_back(entry);
+    }
+  }
+
+  for (int i = 0; i < workersCount; i++) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < workersCount; i++) {
+    workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+  }
+  timer = std::thread([this]() { timerLoop(); });
+}
+
+void TickScheduler::stop() {
+  if (!running) return;
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    running = false;
+  }
+  wakeUp.notify_all();
+
+  if (timer.joinable()) timer.join();
+  for (auto& worker : workers) {
+    if (worker->thread.joinable()) worker->thread.join();
+
+    // return not processed games to wheel for next start
+    for (Entry* entry : worker->tasks) {
+      insertToWheel(entry);
+    }
+  }
+  workers.clear();
+  pendingTasks = 0;
+}
+
+void TickScheduler::insertToWheel(Entry* entry) {
+  std::lock_guard<std::mutex> lock(wheelMutex);
+  uint64_t slot = std::max(entry->deadline, wheelTime + 1) % WHEEL_SLOTS;
+  wheel[slot].push_back(entry);
+}
+
+void TickScheduler::timerLoop() {
+  std::vector<Entry*> due;
+  std::vector<Entry*> notDue;
+  size_t nextWorker = 0;
+
+  while (running) {
+    std::this_thread::sleep_until(startTime + milliseconds(wheelTime + 1));
+    uint64_t now = nowMs();
+
+    // entries with deadline after this turn of wheel stay in their slot
+    {
+      std::lock_guard<std::mutex> lock(wheelMutex);
+      while (wheelTime < now) {
+        wheelTime++;
+        std::vector<Entry*>& slot = wheel[wheelTime % WHEEL_SLOTS];
+        for (Entry* entry : slot) {
+          (entry->deadline <= wheelTime ? due : notDue).push_back(entry);
+        }
+        slot.swap(notDue);
+        notDue.clear();
+      }
+    }
+
+    if (!due.empty()) {
+      for (Entry* entry : due) {
+        Worker& worker = *workers[nextWorker++ % workers.size()];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(entry);
+      }
+      {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pendingTasks += due.size();
+      }
+      wakeUp.notify_all();
+      due.clear();
+    }
+  }
+}
+
+// own queue is used as stack, other queues are robbed from the opposite end
+TickScheduler::Entry* TickScheduler::popTask(int index) {
+  Entry* entry = nullptr;
+  {
+    Worker& own = *workers[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      entry = own.tasks.back();
+      own.tasks.pop_back();
+    }
+  }
+
+  for (int i = 1; i < workersCount && entry == nullptr; i++) {
+    Worker& victim = *workers[(index + i) % workersCount];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      entry = victim.tasks.front();
+      victim.tasks.pop_front();
+      stealCount++;
+    }
+  }
+
+  return entry;
+}
+
+void TickScheduler::workerLoop(int index) {
+  while (running) {
+    Entry* entry = popTask(index);
+    if (entry) {
+      pendingTasks--;
+      tickGame(entry);
+    } else {
+      std::unique_lock<std::mutex> lock(sleepMutex);
+      wakeUp.wait(lock, [this]() { return !running || pendingTasks > 0; });
+    }
+  }
+}
+
+void TickScheduler::tickGame(Entry* entry) {
+  bool isRemoved = false;
+  {
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    isRemoved = entry->removed;
+    if (!isRemoved) {
+      entry->game.gameTick();
+      tickCount++;
+      if (onTick) {
+        onTick(entry->id, *entry->game.get());
+      }
+
+      // keep tick rate without drift, late games are ticked as soon as
+      // possible
+      int delay = getDelay(entry->game.getGameInfo().speed, initialDelay);
+      entry->deadline = std::max(entry->deadline + delay, nowMs());
+    }
+  }
+
+  // removed entry has left the wheel, it is free for new game
+  if (isRemoved) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    freeEntries.push_back(entry);
+  } else {
+    insertToWheel(entry);
+  }
+}
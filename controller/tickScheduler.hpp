@@ -0,0 +1,75 @@
+#ifndef TICK_SCHEDULER_HPP
+#define TICK_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../retro_games/gameEngine.hpp"
+
+namespace s21 {
+// Ticks many games without a thread per game. Games wait in a timer wheel
+// keyed by the deadline of their next tick (getDelay of current speed), due
+// games are dispatched to worker threads which steal work from each other.
+// Games are kept by value in GameEngine, so ticks are not virtual calls.
+class TickScheduler {
+ public:
+  using GameId = uint32_t;
+  using TickCallback = std::function<void(GameId, GameLogic&)>;
+
+  explicit TickScheduler(int workersCount = 0, int initialDelay = 1000);
+  ~TickScheduler();
+
+  // new game of type, not started; id of removed game is given again once
+  // its entry has left the wheel
+  GameId addGame(GameType type, uint64_t seed);
+  void removeGame(GameId id);
+  void userInput(GameId id, UserAction_t action, bool hold);
+  void setTickCallback(TickCallback callback);
+
+  void start();
+  void stop();
+
+  uint64_t getTickCount() const { return tickCount; }
+  uint64_t getStealCount() const { return stealCount; }
+
+ private:
+  struct Entry;
+  struct Worker;
+
+  void timerLoop();
+  void workerLoop(int index);
+  Entry* popTask(int index);
+  void tickGame(Entry* entry);
+  void insertToWheel(Entry* entry);
+  uint64_t nowMs() const;
+
+  int workersCount;
+  int initialDelay;
+  std::chrono::steady_clock::time_point startTime;
+
+  std::mutex entriesMutex;
+  std::vector<std::unique_ptr<Entry>> entries;
+  std::vector<Entry*> freeEntries;  // removed and out of wheel
+
+  std::mutex wheelMutex;
+  std::vector<std::vector<Entry*>> wheel;
+  uint64_t wheelTime = 0;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::thread timer;
+  std::mutex sleepMutex;
+  std::condition_variable wakeUp;
+  std::atomic<int64_t> pendingTasks = 0;
+  std::atomic<bool> running = false;
+  std::atomic<uint64_t> tickCount = 0;
+  std::atomic<uint64_t> stealCount = 0;
+  TickCallback onTick;
+};
+}  // namespace s21
+
+#endif  // TICK_SCHEDULER_HPP
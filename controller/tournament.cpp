@@ -0,0 +1,353 @@
+#include "tournament.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "../retro_games/snake/snakeLogic.hpp"
+#include "../retro_games/tetris/tetrisVersus.hpp"
+
+using namespace s21;
+
+// 0 or 1 by bigger score, -1 for equal
+static int winnerByScore(const TournamentGame& game) {
+  if (game.score[0] == game.score[1]) return -1;
+  return game.score[0] > game.score[1] ? 0 : 1;
+}
+
+static void playVersus(const TournamentPolicy* sides[2], TournamentGame& game,
+                       int maxTicks) {
+  TetrisVersus match(2);
+  for (int i = 0; i < 2; i++) {
+    match.setBot(i, sides[i]->makeBot());
+  }
+  match.setSeed(game.seed);
+  match.userInput(UserAction_t::Start, false);
+  for (int tick = 0; tick < maxTicks && !match.isFinished(); tick++) {
+    match.gameTick();
+    for (int i = 0; i < 2; i++) {
+      GameStatus status = match.getBoard(i).getCurrentGameStatus();
+      game.ticks[i] += status == GameStatus::GAME;
+    }
+  }
+  for (int i = 0; i < 2; i++) {
+    game.score[i] = match.getBoard(i).getGameInfo().score;
+    game.lines[i] = match.getLinesCleared(i);
+  }
+  game.winner = match.isFinished() ? match.getWinner() : winnerByScore(game);
+}
+
+// snake moves by each action of bot
+static void playSnake(const TournamentPolicy& policy, TournamentGame& game,
+                      int side, int maxTicks) {
+  SnakeLogic snake;
+  snake.setSeed(game.seed);
+  snake.userInput(UserAction_t::Start, false);
+  std::unique_ptr<GameBot> bot = policy.makeBot();
+  UserAction_t action;
+  int& ticks = game.ticks[side];
+  while (bot && ticks < maxTicks &&
+         snake.getCurrentGameStatus() == GameStatus::GAME &&
+         bot->nextAction(snake, action)) {
+    snake.userInput(action, false);
+    ticks++;
+  }
+  game.score[side] = snake.getGameInfo().score;
+}
+
+static void updateElo(double& first, double& second, double result) {
+  double expected = 1.0 / (1.0 + std::pow(10.0, (second - first) / 400.0));
+  first += ELO_K * (result - expected);
+  second -= ELO_K * (result - expected);
+}
+
+double PolicyStanding::meanScore() const {
+  return games ? static_cast<double>(score) / games : 0;
+}
+
+double PolicyStanding::scoreDeviation() const {
+  double mean = meanScore();
+  return games ? std::sqrt(std::max(0.0, scoreSquares / games - mean * mean))
+               : 0;
+}
+
+double PolicyStanding::meanLines() const {
+  return games ? static_cast<double>(lines) / games : 0;
+}
+
+double PolicyStanding::meanTicks() const {
+  return games ? static_cast<double>(ticks) / games : 0;
+}
+
+Tournament::Tournament(std::vector<TournamentPolicy> policies,
+                       TournamentOptions options)
+    : policies(std::move(policies)), options(std::move(options)) {
+  if (this->options.seeds.empty()) {
+    this->options.seeds.push_back(1);
+  }
+  if (this->options.threads <= 0) {
+    this->options.threads =
+        static_cast<int>(std::thread::hardware_concurrency());
+  }
+  this->options.threads = std::max(1, this->options.threads);
+  size_t count = this->policies.size();
+  standings.resize(count);
+  hasPlayed.assign(count, std::vector<bool>(count, false));
+  for (size_t i = 0; i < count; i++) {
+    standings[i].name = this->policies[i].name;
+  }
+}
+
+TournamentGame Tournament::playGame(GameType game,
+                                    const TournamentPolicy& first,
+                                    const TournamentPolicy& second,
+                                    uint64_t seed, int maxTicks) {
+  TournamentGame result = {0, {0, 1}, seed, -1, {0, 0}, {0, 0}, {0, 0}};
+  const TournamentPolicy* sides[2] = {&first, &second};
+  if (game == GameType::TETRIS) {
+    playVersus(sides, result, maxTicks);
+  } else if (game == GameType::SNAKE) {
+    for (int i = 0; i < 2; i++) {
+      playSnake(*sides[i], result, i, maxTicks);
+    }
+    result.winner = winnerByScore(result);
+  }
+  return result;
+}
+
+void Tournament::run() {
+  int count = static_cast<int>(policies.size());
+  if (count < 2) return;
+  if (options.format == TournamentFormat::ROUND_ROBIN) {
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < count; i++) {
+      for (int j = i + 1; j < count; j++) {
+        pairs.emplace_back(i, j);
+      }
+    }
+    playRound(0, pairs);
+  } else {
+    int rounds = options.rounds;
+    if (rounds <= 0) {
+      rounds = std::max(1, static_cast<int>(std::ceil(std::log2(count))));
+    }
+    for (int round = 0; round < rounds; round++) {
+      playRound(round, pairRound());
+    }
+  }
+}
+
+// first policy of order plays the best one it has not played yet, with
+// backtracking when the rest can not be paired so
+static bool pairNew(const std::vector<int>& order,
+                    const std::vector<std::vector<bool>>& hasPlayed,
+                    std::vector<std::pair<int, int>>& pairs) {
+  if (order.empty()) return true;
+  int first = order[0];
+  for (size_t i = 1; i < order.size(); i++) {
+    if (hasPlayed[first][order[i]]) continue;
+    std::vector<int> rest(order.begin() + 1, order.end());
+    rest.erase(rest.begin() + (i - 1));
+    pairs.emplace_back(first, order[i]);
+    if (pairNew(rest, hasPlayed, pairs)) return true;
+    pairs.pop_back();
+  }
+  return false;
+}
+
+// policies go by points, bye goes to the lowest policy without bye; pairs
+// repeat only when there is no other way, then neighbours play
+std::vector<std::pair<int, int>> Tournament::pairRound() {
+  std::vector<int> order(policies.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = static_cast<int>(i);
+  }
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+    const PolicyStanding& first = standings[a];
+    const PolicyStanding& second = standings[b];
+    if (first.points != second.points) return first.points > second.points;
+    return first.elo > second.elo;
+  });
+
+  if (order.size() % 2) {
+    auto bye = std::find_if(order.rbegin(), order.rend(),
+                            [this](int i) { return standings[i].byes == 0; });
+    auto position = bye == order.rend() ? order.end() - 1 : bye.base() - 1;
+    standings[*position].byes++;
+    standings[*position].points += 1;
+    order.erase(position);
+  }
+
+  std::vector<std::pair<int, int>> pairs;
+  if (!pairNew(order, hasPlayed, pairs)) {
+    pairs.clear();
+    for (size_t i = 0; i + 1 < order.size(); i += 2) {
+      pairs.emplace_back(order[i], order[i + 1]);
+    }
+  }
+  return pairs;
+}
+
+// sides of pair change by seed, board 0 of Tetris match moves first
+void Tournament::playRound(int round,
+                           const std::vector<std::pair<int, int>>& pairs) {
+  size_t seeds = options.seeds.size();
+  size_t tasks = pairs.size() * seeds;
+  std::vector<TournamentGame> results(tasks);
+  std::atomic<size_t> next = 0;
+  auto work = [&]() {
+    for (size_t i = next++; i < tasks; i = next++) {
+      auto [first, second] = pairs[i / seeds];
+      if (i % seeds % 2) {
+        std::swap(first, second);
+      }
+      results[i] = playGame(options.game, policies[first], policies[second],
+                            options.seeds[i % seeds], options.maxTicks);
+      results[i].round = round;
+      results[i].policies[0] = first;
+      results[i].policies[1] = second;
+    }
+  };
+
+  // calling thread works too
+  int threads = std::min<int>(options.threads, std::max<size_t>(1, tasks));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (const TournamentGame& game : results) {
+    addGame(game);
+  }
+}
+
+void Tournament::addGame(const TournamentGame& game) {
+  int first = game.policies[0];
+  int second = game.policies[1];
+  hasPlayed[first][second] = true;
+  hasPlayed[second][first] = true;
+
+  for (int i = 0; i < 2; i++) {
+    PolicyStanding& standing = standings[game.policies[i]];
+    standing.games++;
+    standing.score += game.score[i];
+    standing.lines += game.lines[i];
+    standing.ticks += game.ticks[i];
+    standing.scoreSquares += static_cast<double>(game.score[i]) * game.score[i];
+    if (game.winner < 0) {
+      standing.draws++;
+      standing.points += 0.5;
+    } else if (game.winner == i) {
+      standing.wins++;
+      standing.points += 1;
+    } else {
+      standing.losses++;
+    }
+  }
+  double result = game.winner < 0 ? 0.5 : game.winner == 0 ? 1 : 0;
+  updateElo(standings[first].elo, standings[second].elo, result);
+  games.push_back(game);
+}
+
+std::vector<int> Tournament::getRanking() const {
+  std::vector<int> ranking(standings.size());
+  for (size_t i = 0; i < ranking.size(); i++) {
+    ranking[i] = static_cast<int>(i);
+  }
+  std::stable_sort(ranking.begin(), ranking.end(), [this](int a, int b) {
+    const PolicyStanding& first = standings[a];
+    const PolicyStanding& second = standings[b];
+    if (first.elo != second.elo) return first.elo > second.elo;
+    return first.points > second.points;
+  });
+  return ranking;
+}
+
+static std::string format(double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.2f", value);
+  return buffer;
+}
+
+// name is quoted when it has comma or quote
+static std::string csvField(const std::string& text) {
+  if (text.find_first_of(",\"\n") == std::string::npos) return text;
+  std::string field = "\"";
+  for (char c : text) {
+    field += c == '"' ? "\"\"" : std::string(1, c);
+  }
+  return field + "\"";
+}
+
+static std::string jsonString(const std::string& text) {
+  std::string string = "\"";
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      string += '\\';
+    }
+    string += c < ' ' ? ' ' : c;
+  }
+  return string + "\"";
+}
+
+void Tournament::writeCsv(std::ostream& out) const {
+  out << "rank,policy,elo,points,games,wins,draws,losses,byes,mean_score,"
+         "score_deviation,mean_lines,mean_ticks\n";
+  std::vector<int> ranking = getRanking();
+  for (size_t i = 0; i < ranking.size(); i++) {
+    const PolicyStanding& s = standings[ranking[i]];
+    out << i + 1 << ',' << csvField(s.name) << ',' << format(s.elo) << ','
+        << s.points << ',' << s.games << ',' << s.wins << ',' << s.draws
+        << ',' << s.losses << ',' << s.byes << ',' << format(s.meanScore())
+        << ',' << format(s.scoreDeviation()) << ',' << format(s.meanLines())
+        << ',' << format(s.meanTicks()) << '\n';
+  }
+}
+
+void Tournament::writeJson(std::ostream& out) const {
+  bool isTetris = options.game == GameType::TETRIS;
+  bool isSwiss = options.format == TournamentFormat::SWISS;
+  out << "{\n  \"game\": \"" << (isTetris ? "tetris" : "snake") << "\",\n"
+      << "  \"format\": \"" << (isSwiss ? "swiss" : "round robin") << "\",\n"
+      << "  \"max_ticks\": " << options.maxTicks << ",\n  \"seeds\": [";
+  for (size_t i = 0; i < options.seeds.size(); i++) {
+    out << (i ? ", " : "") << options.seeds[i];
+  }
+
+  out << "],\n  \"standings\": [";
+  std::vector<int> ranking = getRanking();
+  for (size_t i = 0; i < ranking.size(); i++) {
+    const PolicyStanding& s = standings[ranking[i]];
+    out << (i ? "," : "") << "\n    {\"rank\": " << i + 1
+        << ", \"policy\": " << jsonString(s.name)
+        << ", \"elo\": " << format(s.elo) << ", \"points\": " << s.points
+        << ", \"games\": " << s.games << ", \"wins\": " << s.wins
+        << ", \"draws\": " << s.draws << ", \"losses\": " << s.losses
+        << ", \"byes\": " << s.byes
+        << ", \"mean_score\": " << format(s.meanScore())
+        << ", \"score_deviation\": " << format(s.scoreDeviation())
+        << ", \"mean_lines\": " << format(s.meanLines())
+        << ", \"mean_ticks\": " << format(s.meanTicks()) << "}";
+  }
+
+  out << "\n  ],\n  \"games\": [";
+  for (size_t i = 0; i < games.size(); i++) {
+    const TournamentGame& g = games[i];
+    const std::string& first = standings[g.policies[0]].name;
+    const std::string& second = standings[g.policies[1]].name;
+    out << (i ? "," : "") << "\n    {\"round\": " << g.round
+        << ", \"policies\": [" << jsonString(first) << ", "
+        << jsonString(second) << "], \"seed\": " << g.seed << ", \"winner\": "
+        << (g.winner < 0 ? "null" : jsonString(g.winner ? second : first))
+        << ", \"score\": [" << g.score[0] << ", " << g.score[1]
+        << "], \"lines\": [" << g.lines[0] << ", " << g.lines[1]
+        << "], \"ticks\": [" << g.ticks[0] << ", " << g.ticks[1] << "]}";
+  }
+  out << "\n  ]\n}\n";
+}
@@ -0,0 +1,112 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../retro_games/gameBot.hpp"
+
+namespace s21 {
+
+#define ELO_START 1500
+#define ELO_K 16                // change of rating by one game
+#define TOURNAMENT_TICKS 5000  // game is decided by score after them
+
+// bot of tournament, made anew for each game
+struct TournamentPolicy {
+  std::string name;
+  std::function<std::unique_ptr<GameBot>()> makeBot;
+};
+
+enum class TournamentFormat { ROUND_ROBIN, SWISS };
+
+struct TournamentOptions {
+  GameType game = GameType::TETRIS;
+  TournamentFormat format = TournamentFormat::ROUND_ROBIN;
+  int rounds = 0;               // of swiss, 0 takes log2 of policies
+  std::vector<uint64_t> seeds;  // each pair plays a game on every seed
+  int maxTicks = TOURNAMENT_TICKS;
+  int threads = 0;  // <= 0 takes number of cores
+};
+
+// game of two policies, index 0 is the first one
+struct TournamentGame {
+  int round;
+  int policies[2];
+  uint64_t seed;
+  int winner;  // 0 or 1, -1 for draw
+  int score[2];
+  int lines[2];  // cleared in Tetris
+  int ticks[2];  // game survived
+};
+
+struct PolicyStanding {
+  std::string name;
+  double elo = ELO_START;
+  double points = 0;  // 1 for win or bye, 0.5 for draw
+  int games = 0;
+  int wins = 0;
+  int draws = 0;
+  int losses = 0;
+  int byes = 0;
+  int64_t score = 0;
+  int64_t lines = 0;
+  int64_t ticks = 0;
+  double scoreSquares = 0;
+
+  double meanScore() const;
+  double scoreDeviation() const;
+  double meanLines() const;
+  double meanTicks() const;
+};
+
+// Tournament of bot policies on fixed seeds, so every pair plays the same
+// games. Tetris game is versus match of two boards with garbage, Snake
+// game is played by each policy alone and won by bigger score. Games not
+// decided in maxTicks are won by score. Round robin plays all pairs in
+// one round, swiss pairs policies by points in each round without
+// repeating pairs while possible, odd policy out gets a bye.
+// Games of a round are taken by threads one by one from shared counter,
+// each game has its own engines and bots. Elo goes through games in order
+// of round, pair and seed, so result does not depend on threads.
+// High score storage should be off, see GameLogic::setHighScoreStorage.
+class Tournament {
+ public:
+  Tournament(std::vector<TournamentPolicy> policies,
+             TournamentOptions options);
+
+  void run();
+  // all games in order they were rated
+  const std::vector<TournamentGame>& getGames() const { return games; }
+  // by index of policy
+  const PolicyStanding& getStanding(int index) const {
+    return standings[index];
+  }
+  // indexes of policies by Elo, then points
+  std::vector<int> getRanking() const;
+  void writeCsv(std::ostream& out) const;
+  void writeJson(std::ostream& out) const;
+
+  // Tetris policies are first and second board of match, any thread
+  static TournamentGame playGame(GameType game,
+                                 const TournamentPolicy& first,
+                                 const TournamentPolicy& second,
+                                 uint64_t seed, int maxTicks);
+
+ private:
+  std::vector<std::pair<int, int>> pairRound();
+  void playRound(int round, const std::vector<std::pair<int, int>>& pairs);
+  void addGame(const TournamentGame& game);
+
+  std::vector<TournamentPolicy> policies;
+  TournamentOptions options;
+  std::vector<PolicyStanding> standings;
+  std::vector<TournamentGame> games;
+  std::vector<std::vector<bool>> hasPlayed;  // pairs of swiss
+};
+}  // namespace s21
+
+#endif  // TOURNAMENT_HPP
@@ -4,10 +4,21 @@
 
 using namespace s21;
 
-int main() {
+int main(int argc, char** argv) {
+  GameController controller;
+  if (!controller.applyOptions(argc, argv)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--spectate file:<path>|unix:<path>]"
+                 " [--journal <path>|--no-journal] [--autoplay]"
+                 " [--board <W>x<H>] [--arena <N>] [--versus <N>]"
+                 " [--preview <N>]"
+              << std::endl;
+    return 1;
+  }
+
   auto view = std::make_unique<ConsoleView>();
   ConsoleView* consoleViewPtr = view.get();
-  GameController controller(std::move(view));
+  controller.setView(std::move(view));
 
   consoleViewPtr->startInputThread(controller);
   controller.run();
@@ -408,12 +419,23 @@ static void drawNextShape(const GameInfo_t* gameInfo) {
   }
 }
 
+// area of view is classic board, larger board is shown by its top left
+// corner
 static void drawField(const GameInfo_t* gameInfo, GameType gameType) {
   clearGameArea(1, 1, FIELD_WIDTH * 2 + 1, FIELD_HEIGHT);
 
-  for (int y = 0; y < FIELD_HEIGHT; y++) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
-      if (gameInfo->field[y][x]) {
+  int height = std::min(gameInfo->height, FIELD_HEIGHT);
+  int width = std::min(gameInfo->width, FIELD_WIDTH);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      bool isGhost = gameType == GameType::TETRIS &&
+                     gameInfo->field[y][x] == GHOST_CELL;
+      if (isGhost) {
+        // outline of place where piece lands
+        setColor(Color::LIGHT_BLUE, Color::DEFAULT);
+        printAtXY(x * 2 + 1, y + 1, "[]");
+        setDefaultColor();
+      } else if (gameInfo->field[y][x]) {
         if (gameType == GameType::SNAKE) {
           if (gameInfo->field[y][x] == 1) {
             setColor(Color::WHITE, Color::RED);
@@ -433,6 +455,63 @@ static void drawField(const GameInfo_t* gameInfo, GameType gameType) {
   }
 }
 
+// board of opponent in one column per cell, right of score
+static void drawOpponent(const GameInfo_t& gameInfo, int index) {
+  const int startX = FIELD_WIDTH * 2 + 25 + index * (FIELD_WIDTH + 3);
+  std::string title = "P" + std::to_string(index + 2);
+  title += gameInfo.pause ? " KO" : "";
+  printHLine(startX, 0, '-', FIELD_WIDTH + 2);
+  printAtXY(startX + 1, 0, title);
+  printVLine(startX, 1, '|', FIELD_HEIGHT);
+  printVLine(startX + FIELD_WIDTH + 1, 1, '|', FIELD_HEIGHT);
+  printHLine(startX, FIELD_HEIGHT + 1, '-', FIELD_WIDTH + 2);
+
+  int height = std::min(gameInfo.height, FIELD_HEIGHT);
+  int width = std::min(gameInfo.width, FIELD_WIDTH);
+  for (int y = 0; y < height; y++) {
+    moveAtXY(startX + 1, y + 1);
+    for (int x = 0; x < width; x++) {
+      int cell = gameInfo.field[y][x];
+      if (cell && cell != GHOST_CELL) {
+        setColor(Color::WHITE, gameInfo.pause ? Color::WHITE : Color::BLUE);
+        getOutputBuffer() += ' ';
+        setDefaultColor();
+      } else {
+        getOutputBuffer() += ' ';
+      }
+    }
+  }
+}
+
+// pieces after the next one under score, one column per cell, three
+// pieces in row
+static void drawPreview(const std::vector<PieceGrid>& pieces) {
+  const int startX = FIELD_WIDTH * 2 + 3;
+  const int startY = 14;
+  const int width = 18;
+  const int height = 2 * (NEXT_HEIGHT + 1);
+
+  printAtXY(startX, startY, "-------QUEUE--------");
+  printVLine(startX, startY + 1, '|', height);
+  printVLine(startX + width + 1, startY + 1, '|', height);
+  printHLine(startX, startY + height + 1, '-', width + 2);
+  clearGameArea(startX + 1, startY + 1, startX + width + 1, startY + height);
+
+  for (size_t i = 0; i < pieces.size(); i++) {
+    int posX = startX + 2 + static_cast<int>(i % 3) * (NEXT_WIDTH + 2);
+    int posY = startY + 1 + static_cast<int>(i / 3) * (NEXT_HEIGHT + 1);
+    for (int y = 0; y < NEXT_HEIGHT; y++) {
+      for (int x = 0; x < NEXT_WIDTH; x++) {
+        if (pieces[i][y][x] != 0) {
+          setColor(Color::WHITE, Color::BLUE);
+          printAtXY(posX + x, posY + y, " ");
+          setDefaultColor();
+        }
+      }
+    }
+  }
+}
+
 static bool keyIsHold(unsigned int key) {
   static unsigned int lastKey = 0;
   static struct timespec lastTime = {0, 0};
@@ -479,7 +558,8 @@ InputEvent ConsoleView::readKey() {
       {' ', Key::SPACE},  {27, Key::ESC},       {10, Key::ENTER},
       {'P', Key::P},      {'p', Key::P},        {53431, Key::P},
       {53399, Key::P},    {1792836, Key::LEFT}, {1792835, Key::RIGHT},
-      {1792833, Key::UP}, {1792834, Key::DOWN}};
+      {1792833, Key::UP}, {1792834, Key::DOWN}, {'D', Key::D},
+      {'d', Key::D},      {53426, Key::D},      {53394, Key::D}};
   InputEvent event = {Key::ENTER, false, true};
   const int numBindings = sizeof(keyBindings) / sizeof(keyBindings[0]);
 
@@ -578,6 +658,35 @@ GameType ConsoleView::selectGame() {
   return selectedGame;
 }
 
+bool ConsoleView::offerResume(GameType gameType) {
+  inSelectGame = true;
+  bool isResumed = false;
+
+  clear();
+  setColor(Color::GREEN, Color::DEFAULT);
+  printAtXY(0, 0, "Previous game was interrupted.");
+  setDefaultColor();
+  printAtXY(0, 1,
+            gameType == GameType::TETRIS ? "Resume Tetris?" : "Resume Snake?");
+  printAtXY(0, 2, "Enter - resume, ESC - new game");
+  moveAtXY(0, 1);
+  flushOutput();
+
+  while (true) {
+    InputEvent input = readKey();
+    if (!input.noKey && input.key == Key::ENTER) {
+      isResumed = true;
+      break;
+    } else if (!input.noKey && input.key == Key::ESC) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  inSelectGame = false;
+  return isResumed;
+}
+
 void ConsoleView::render(const GameInfo_t& gameInfo, GameStatus gameStatus,
                          GameType gameType) {
   std::lock_guard<std::mutex> lock(renderMutex);
@@ -625,4 +734,24 @@ void ConsoleView::render(const GameInfo_t& gameInfo, GameStatus gameStatus,
   oldGameInfo = gameInfo;
   oldGameStatus = gameStatus;
   oldGameType = gameType;
-}
\ No newline at end of file
+}
+
+void ConsoleView::renderOpponents(const std::vector<GameInfo_t>& boards) {
+  std::lock_guard<std::mutex> lock(renderMutex);
+  if (currentMenu == Menu::SELECT_GAME) return;
+
+  for (size_t i = 0; i < boards.size(); i++) {
+    drawOpponent(boards[i], static_cast<int>(i));
+  }
+  moveToStart();
+  flushOutput();
+}
+
+void ConsoleView::renderPreview(const std::vector<PieceGrid>& pieces) {
+  std::lock_guard<std::mutex> lock(renderMutex);
+  if (currentMenu == Menu::SELECT_GAME) return;
+
+  drawPreview(pieces);
+  moveToStart();
+  flushOutput();
+}
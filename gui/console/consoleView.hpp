@@ -39,9 +39,12 @@ class ConsoleView : public GameView {
   ~ConsoleView();
   void render(const GameInfo_t& gameInfo, GameStatus gameStatus,
               GameType gameType) override;
+  void renderOpponents(const std::vector<GameInfo_t>& boards) override;
+  void renderPreview(const std::vector<PieceGrid>& pieces) override;
   void onInput(GameController& controller);
   InputEvent readKey();
   GameType selectGame() override;
+  bool offerResume(GameType gameType) override;
   void startInputThread(GameController& controller);
 
  private:
@@ -2,6 +2,8 @@
 
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QDialog>
+#include <QtWidgets/QMessageBox>
+#include <iostream>
 
 #include "../../controller/gameController.hpp"
 
@@ -11,10 +13,21 @@ int main(int argc, char** argv) {
   QApplication app(argc, argv);
   app.setQuitOnLastWindowClosed(false);
 
+  GameController controller;
+  if (!controller.applyOptions(argc, argv)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--spectate file:<path>|unix:<path>]"
+                 " [--journal <path>|--no-journal] [--autoplay]"
+                 " [--board <W>x<H>] [--arena <N>] [--versus <N>]"
+                 " [--preview <N>]"
+              << std::endl;
+    return 1;
+  }
+
   auto view = std::make_unique<DesktopView>();
   DesktopView* desktopViewPtr = view.get();
 
-  GameController controller(std::move(view));
+  controller.setView(std::move(view));
   desktopViewPtr->setGameController(controller);
 
   std::thread controllerThread([&controller]() { controller.run(); });
@@ -148,7 +161,8 @@ static void renderGame(GameWindow* gameWindow, const GameInfo_t* gameInfo,
   gameWindow->setLevel(gameInfo->level);
   gameWindow->setSpeed(gameInfo->speed);
   gameWindow->setHighScore(gameInfo->high_score);
-  gameWindow->setGameField(gameInfo->field);
+  gameWindow->setGameField(gameInfo->field, gameInfo->width,
+                           gameInfo->height);
   if (gameType == GameType::TETRIS) {
     gameWindow->setNextField(gameInfo->next);
   }
@@ -197,6 +211,20 @@ void DesktopView::render(const GameInfo_t& gameInfo, GameStatus gameStatus,
   oldGameType = gameType;
 }
 
+void DesktopView::renderOpponents(const std::vector<GameInfo_t>& boards) {
+  std::lock_guard<std::mutex> lock(renderMutex);
+  if (gameWindow) {
+    gameWindow->setOpponents(boards);
+  }
+}
+
+void DesktopView::renderPreview(const std::vector<PieceGrid>& pieces) {
+  std::lock_guard<std::mutex> lock(renderMutex);
+  if (gameWindow) {
+    gameWindow->setPreview(pieces);
+  }
+}
+
 static bool keyIsHold(unsigned int key) {
   static unsigned int lastKey = 0;
   static struct timespec lastTime = {0, 0};
@@ -252,8 +280,9 @@ static void initSnakeGame(GameWindow* gameWindow) {
 
 static void initTetrisGame(GameWindow* gameWindow) {
   QVector<QColor> colors = {
-      QColor(0, 0, 0),   // background
-      QColor(0, 0, 238)  // blue
+      QColor(0, 0, 0),     // background
+      QColor(0, 0, 238),   // blue
+      QColor(60, 60, 110)  // ghost piece
   };
   gameWindow->setTitle("TETRIS");
   gameWindow->setColors(colors);
@@ -302,4 +331,20 @@ GameType DesktopView::selectGame() {
   delete gameSelect;
 
   return gameType;
-}
\ No newline at end of file
+}
+bool DesktopView::offerResume(GameType gameType) {
+  const char* msg = gameType == GameType::TETRIS
+                        ? "Previous game was interrupted.\nResume Tetris?"
+                        : "Previous game was interrupted.\nResume Snake?";
+  auto answer = QMessageBox::question(nullptr, "Retro games", msg,
+                                      QMessageBox::Yes | QMessageBox::No);
+  bool isResumed = answer == QMessageBox::Yes;
+
+  if (isResumed && gameType == GameType::TETRIS) {
+    initTetrisGame(gameWindow);
+  } else if (isResumed && gameType == GameType::SNAKE) {
+    initSnakeGame(gameWindow);
+  }
+
+  return isResumed;
+}
@@ -14,7 +14,10 @@ class DesktopView : public GameView {
   ~DesktopView();
   void render(const GameInfo_t& gameInfo, GameStatus gameStatus,
               GameType gameType) override;
+  void renderOpponents(const std::vector<GameInfo_t>& boards) override;
+  void renderPreview(const std::vector<PieceGrid>& pieces) override;
   GameType selectGame() override;
+  bool offerResume(GameType gameType) override;
   void keyPressEvent(Key key);
   void setGameController(GameController& controller);
   void gameWindowClosed();
@@ -11,14 +11,16 @@ namespace s21 {
 
 class GameField : public QFrame {
  public:
-  explicit GameField(int width, int height, QWidget* parent = nullptr, const QVector<QColor>& colors = QVector<QColor>())
+  explicit GameField(int width, int height, QWidget* parent = nullptr, const QVector<QColor>& colors = QVector<QColor>(),
+                     int pixelSize = PIXEL_SIZE)
       : QFrame(parent), width(width), height(height),
+      pixelSize(pixelSize),
       colors(colors.empty() ? 
              QVector<QColor>{  // Дефолтные цвета если пустой массив
                  QColor(0, 0, 0),    // 0 - background
                  QColor(0, 0, 238) //  blue
              } : colors) {
-    setFixedSize(width * PIXEL_SIZE, height * PIXEL_SIZE);
+    setFixedSize(width * pixelSize, height * pixelSize);
   }
 
   void updateField(const std::vector<int>& fieldData) {
@@ -45,7 +47,7 @@ class GameField : public QFrame {
         if (colorId < 0) colorId = 0;
         if (colorId >= colors.size()) colorId = colors.size() - 1;
 
-        painter.fillRect(x * PIXEL_SIZE, y * PIXEL_SIZE, PIXEL_SIZE, PIXEL_SIZE,
+        painter.fillRect(x * pixelSize, y * pixelSize, pixelSize, pixelSize,
                          colors[colorId]);
       }
     }
@@ -54,6 +56,7 @@ class GameField : public QFrame {
  private:
   int width = 0;
   int height = 0;
+  int pixelSize = PIXEL_SIZE;
   QVector<QColor> colors;
   std::vector<int> field;
 };
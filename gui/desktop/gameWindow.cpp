@@ -1,5 +1,7 @@
 #include "gameWindow.hpp"
 
+#include <algorithm>
+
 #include "desktopView.hpp"
 
 using namespace s21;
@@ -13,6 +15,8 @@ static void setupConnections(GameWindow* gw) {
   gw->connect(gw, GW(visibleChanged), gw, GW(updateVisible));
   gw->connect(gw, GW(gameFieldChanged), gw, GW(updateGameField));
   gw->connect(gw, GW(nextFieldChanged), gw, GW(updateNextField));
+  gw->connect(gw, GW(opponentsChanged), gw, GW(updateOpponents));
+  gw->connect(gw, GW(previewChanged), gw, GW(updatePreview));
   gw->connect(gw, GW(windowTitleChanged), gw, GW(updateWindowTitle));
   gw->connect(gw, GW(infoMessageChanged), gw, GW(updateInfoMessage));
   gw->connect(gw, GW(infoMessageHidding), gw, GW(infoMessageHide));
@@ -41,6 +45,8 @@ GameWindow::GameWindow(DesktopView* view, QWidget* parent)
 
   statsLayout->addWidget(nextLabel);
   statsLayout->addWidget(nextField);
+  previewLayout = new QHBoxLayout();
+  statsLayout->addLayout(previewLayout);
   statsLayout->addWidget(levelLabel);
   statsLayout->addWidget(speedLabel);
   statsLayout->addWidget(scoreLabel);
@@ -51,6 +57,8 @@ GameWindow::GameWindow(DesktopView* view, QWidget* parent)
   QHBoxLayout* mainLayout = new QHBoxLayout(this);
   mainLayout->addWidget(gameField);
   mainLayout->addWidget(statsWidget);
+  opponentsLayout = new QHBoxLayout();
+  mainLayout->addLayout(opponentsLayout);
 
   setLayout(mainLayout);
   adjustSize();
@@ -112,15 +120,17 @@ void GameWindow::setVisiblity(bool isVisible) {
   emit visibleChanged(isVisible);
 }
 
-void GameWindow::setGameField(int** field) {
+void GameWindow::setGameField(int** field, int fieldWidth, int fieldHeight) {
   const int width = FIELD_WIDTH;
   const int height = FIELD_HEIGHT;
 
-  // Copying a two-dimensional array into a one-dimensional vector (row-major)
+  // Copying a two-dimensional array into a one-dimensional vector (row-major),
+  // larger board is cut to top left corner, smaller one is padded
   std::vector<int> fieldData(width * height);
 
-  for (int y = 0; y < height; ++y) {
-    memcpy(&fieldData[y * width], field[y], width * sizeof(int));
+  int copyWidth = std::min(width, fieldWidth);
+  for (int y = 0; y < std::min(height, fieldHeight); ++y) {
+    memcpy(&fieldData[y * width], field[y], copyWidth * sizeof(int));
   }
 
   emit gameFieldChanged(fieldData);
@@ -161,6 +171,41 @@ void GameWindow::setNextField(int** field) {
   }
 }
 
+void GameWindow::setOpponents(const std::vector<GameInfo_t>& boards) {
+  const int cells = FIELD_WIDTH * FIELD_HEIGHT;
+  std::vector<int> fieldsData(boards.size() * cells, 0);
+
+  // board out of match is grey
+  for (size_t i = 0; i < boards.size(); i++) {
+    const GameInfo_t& board = boards[i];
+    int filled = board.pause ? 2 : 1;
+    for (int y = 0; y < std::min(FIELD_HEIGHT, board.height); ++y) {
+      for (int x = 0; x < std::min(FIELD_WIDTH, board.width); ++x) {
+        int cell = board.field[y][x];
+        fieldsData[i * cells + y * FIELD_WIDTH + x] =
+            cell && cell != GHOST_CELL ? filled : 0;
+      }
+    }
+  }
+
+  emit opponentsChanged(fieldsData);
+}
+
+void GameWindow::setPreview(const std::vector<PieceGrid>& pieces) {
+  const int cells = NEXT_WIDTH * NEXT_HEIGHT;
+  std::vector<int> fieldsData(pieces.size() * cells, 0);
+
+  for (size_t i = 0; i < pieces.size(); i++) {
+    for (int y = 0; y < NEXT_HEIGHT; ++y) {
+      for (int x = 0; x < NEXT_WIDTH; ++x) {
+        fieldsData[i * cells + y * NEXT_WIDTH + x] = pieces[i][y][x] ? 1 : 0;
+      }
+    }
+  }
+
+  emit previewChanged(fieldsData);
+}
+
 void GameWindow::setTitle(const char* title) { emit windowTitleChanged(title); }
 
 void GameWindow::showInfoMessage(const char* message) {
@@ -205,6 +250,69 @@ void GameWindow::updateNextField(const std::vector<int>& fieldData) {
   nextField->updateField(fieldData);
 }
 
+void GameWindow::updateOpponents(const std::vector<int>& fieldsData) {
+  const int cells = FIELD_WIDTH * FIELD_HEIGHT;
+  size_t count = fieldsData.size() / cells;
+  if (count != opponentFields.size()) {
+    const QVector<QColor> colors = {QColor(0, 0, 0), QColor(0, 0, 238),
+                                    QColor(128, 128, 128)};
+    while (opponentFields.size() < count) {
+      GameField* field = new GameField(FIELD_WIDTH, FIELD_HEIGHT, this,
+                                       colors, PIXEL_SIZE / 2);
+      opponentsLayout->addWidget(field);
+      opponentFields.push_back(field);
+    }
+    while (opponentFields.size() > count) {
+      delete opponentFields.back();
+      opponentFields.pop_back();
+    }
+
+    // window is fixed by its content
+    setMinimumSize(0, 0);
+    setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    adjustSize();
+    setFixedSize(size());
+    infoOverlayLabel->setGeometry(rect());
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    std::vector<int> fieldData(fieldsData.begin() + i * cells,
+                               fieldsData.begin() + (i + 1) * cells);
+    opponentFields[i]->updateField(fieldData);
+  }
+}
+
+void GameWindow::updatePreview(const std::vector<int>& fieldsData) {
+  const int cells = NEXT_WIDTH * NEXT_HEIGHT;
+  size_t count = fieldsData.size() / cells;
+  if (count != previewFields.size()) {
+    const QVector<QColor> colors = {QColor(0, 0, 0), QColor(0, 0, 238)};
+    while (previewFields.size() < count) {
+      GameField* field = new GameField(NEXT_WIDTH, NEXT_HEIGHT, this, colors,
+                                       PIXEL_SIZE / 2);
+      previewLayout->addWidget(field);
+      previewFields.push_back(field);
+    }
+    while (previewFields.size() > count) {
+      delete previewFields.back();
+      previewFields.pop_back();
+    }
+
+    // window is fixed by its content
+    setMinimumSize(0, 0);
+    setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    adjustSize();
+    setFixedSize(size());
+    infoOverlayLabel->setGeometry(rect());
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    std::vector<int> fieldData(fieldsData.begin() + i * cells,
+                               fieldsData.begin() + (i + 1) * cells);
+    previewFields[i]->updateField(fieldData);
+  }
+}
+
 void GameWindow::updateWindowTitle(const char* title) {
   setWindowTitle(QString::fromUtf8(title));
 }
@@ -250,6 +358,10 @@ void GameWindow::keyPressEvent(QKeyEvent* event) {
     case Qt::Key_Up:
       view->keyPressEvent(Key::UP);
       break;
+    case Qt::Key_D:
+    case 1042:
+      view->keyPressEvent(Key::D);
+      break;
     default:
       QWidget::keyPressEvent(event);
       break;
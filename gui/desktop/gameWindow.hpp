@@ -27,8 +27,14 @@ class GameWindow : public QWidget {
   void setSpeed(int speed);
   void setHighScore(int highScore);
   void setVisiblity(bool isVisible);
-  void setGameField(int** field);
+  // board of other size is fitted to classic one
+  void setGameField(int** field, int fieldWidth = FIELD_WIDTH,
+                    int fieldHeight = FIELD_HEIGHT);
   void setNextField(int** field);
+  // boards of versus game in small fields right of stats
+  void setOpponents(const std::vector<GameInfo_t>& boards);
+  // tetris pieces after the next one in small fields under it
+  void setPreview(const std::vector<PieceGrid>& pieces);
   void setTitle(const char* title);
   void showInfoMessage(const char* message);
   void hideInfoMessage();
@@ -42,6 +48,8 @@ class GameWindow : public QWidget {
   void visibleChanged(bool);
   void gameFieldChanged(const std::vector<int>&);
   void nextFieldChanged(const std::vector<int>&);
+  void opponentsChanged(const std::vector<int>&);
+  void previewChanged(const std::vector<int>&);
   void windowTitleChanged(const char*);
   void infoMessageChanged(const char*);
   void infoMessageHidding();
@@ -55,6 +63,8 @@ class GameWindow : public QWidget {
   void updateVisible(bool isVisible);
   void updateGameField(const std::vector<int>& fieldData);
   void updateNextField(const std::vector<int>& fieldData);
+  void updateOpponents(const std::vector<int>& fieldsData);
+  void updatePreview(const std::vector<int>& fieldsData);
   void updateWindowTitle(const char* title);
   void updateInfoMessage(const char* message);
   void infoMessageHide();
@@ -69,6 +79,10 @@ class GameWindow : public QWidget {
   GameField* gameField;
   GameField* nextField;
   QWidget* statsWidget;
+  QHBoxLayout* opponentsLayout;
+  std::vector<GameField*> opponentFields;
+  QHBoxLayout* previewLayout;
+  std::vector<GameField*> previewFields;
   QLabel* nextLabel;
   QLabel* scoreLabel;
   QLabel* levelLabel;
@@ -1,12 +1,14 @@
 #ifndef GAME_VIEW_HPP
 #define GAME_VIEW_HPP
 
+#include <vector>
+
 #include "../controller/common.hpp"
 
 namespace s21 {
 class GameController;
 
-enum class Key { SPACE, ESC, LEFT, RIGHT, DOWN, UP, ENTER, P };
+enum class Key { SPACE, ESC, LEFT, RIGHT, DOWN, UP, ENTER, P, D };
 
 struct InputEvent {
   Key key;
@@ -20,6 +22,19 @@ class GameView {
   virtual void render(const GameInfo_t& gameInfo, GameStatus gameStatus,
                       GameType gameType) = 0;
   virtual GameType selectGame() = 0;
+  // game was interrupted, returns true if user wants to continue it
+  virtual bool offerResume(GameType gameType) {
+    (void)gameType;
+    return false;
+  }
+  // boards of opponents in versus game, board out of match has pause set
+  virtual void renderOpponents(const std::vector<GameInfo_t>& boards) {
+    (void)boards;
+  }
+  // tetris pieces coming after the next one, in order
+  virtual void renderPreview(const std::vector<PieceGrid>& pieces) {
+    (void)pieces;
+  }
 };
 }  // namespace s21
 
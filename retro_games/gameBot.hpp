@@ -0,0 +1,17 @@
+#ifndef GAME_BOT_HPP
+#define GAME_BOT_HPP
+
+#include "gameLogic.hpp"
+
+namespace s21 {
+// Plays game through the same actions as a player. The caller applies the
+// action with GameLogic::userInput, so bot works with any view or headless.
+class GameBot {
+ public:
+  virtual ~GameBot() = default;
+  // next action for current state of game, false if bot has nothing to do
+  virtual bool nextAction(const GameLogic& game, UserAction_t& action) = 0;
+};
+}  // namespace s21
+
+#endif  // GAME_BOT_HPP
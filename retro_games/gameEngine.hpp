@@ -0,0 +1,116 @@
+#ifndef GAME_ENGINE_HPP
+#define GAME_ENGINE_HPP
+
+#include <type_traits>
+#include <variant>
+
+#include "snake/snakeLogic.hpp"
+#include "tetris/tetrisLogic.hpp"
+
+namespace s21 {
+// Game of either type kept by value, for headless and batch paths that
+// drive many games. Type of game is known from the variant, so calls are
+// qualified with it and are not virtual; state is read by reference
+// instead of copy of updateCurrentState. Views keep the virtual
+// GameLogic, it is given by get(). Games of derived classes (versus,
+// arena) do not fit here.
+class GameEngine {
+ public:
+  GameEngine() = default;
+  explicit GameEngine(GameType type, int width = FIELD_WIDTH,
+                      int height = FIELD_HEIGHT) {
+    reset(type, width, height);
+  }
+  GameEngine(const GameEngine&) = delete;
+  GameEngine& operator=(const GameEngine&) = delete;
+
+  // new game of type in place of old one, NONE leaves no game
+  void reset(GameType type, int width = FIELD_WIDTH,
+             int height = FIELD_HEIGHT) {
+    if (type == GameType::TETRIS) {
+      engine.emplace<TetrisLogic>(width, height);
+    } else if (type == GameType::SNAKE) {
+      engine.emplace<SnakeLogic>(width, height);
+    } else {
+      engine.emplace<std::monostate>();
+    }
+  }
+
+  GameType getType() const {
+    return static_cast<GameType>(engine.index());
+  }
+  explicit operator bool() const { return engine.index() != 0; }
+
+  // nullptr without game
+  GameLogic* get() {
+    return std::visit([](auto& game) { return logicOf(game); }, engine);
+  }
+  const GameLogic* get() const {
+    return std::visit([](const auto& game) { return logicOf(game); },
+                      engine);
+  }
+
+  // visitor is called with game by its own type, not without game
+  template <class Visitor>
+  void visit(Visitor&& visitor) {
+    std::visit(
+        [&visitor](auto& game) {
+          if constexpr (!std::is_same_v<std::decay_t<decltype(game)>,
+                                        std::monostate>) {
+            visitor(game);
+          }
+        },
+        engine);
+  }
+
+  // calls are qualified with Game:: so they are not virtual
+  void userInput(UserAction_t action, bool hold) {
+    visit([action, hold](auto& game) {
+      using Game = std::decay_t<decltype(game)>;
+      game.Game::userInput(action, hold);
+    });
+  }
+  void gameTick() {
+    visit([](auto& game) {
+      using Game = std::decay_t<decltype(game)>;
+      game.Game::gameTick();
+    });
+  }
+  void saveState(GameState_t& state) const {
+    std::visit(
+        [&state](const auto& game) {
+          using Game = std::decay_t<decltype(game)>;
+          if constexpr (!std::is_same_v<Game, std::monostate>) {
+            game.Game::saveState(state);
+          }
+        },
+        engine);
+  }
+  bool loadState(const GameState_t& state) {
+    bool isLoaded = false;
+    visit([&state, &isLoaded](auto& game) {
+      using Game = std::decay_t<decltype(game)>;
+      isLoaded = game.Game::loadState(state);
+    });
+    return isLoaded;
+  }
+
+  // the rest needs a game
+  void setSeed(uint64_t seed) { get()->setSeed(seed); }
+  GameStatus getCurrentGameStatus() const {
+    return get()->getCurrentGameStatus();
+  }
+  const GameInfo_t& getGameInfo() const { return get()->getGameInfo(); }
+
+ private:
+  static GameLogic* logicOf(std::monostate&) { return nullptr; }
+  static const GameLogic* logicOf(const std::monostate&) { return nullptr; }
+  static GameLogic* logicOf(GameLogic& game) { return &game; }
+  static const GameLogic* logicOf(const GameLogic& game) { return &game; }
+
+  // order of GameType
+  std::variant<std::monostate, TetrisLogic, SnakeLogic> engine;
+};
+}  // namespace s21
+
+#endif  // GAME_ENGINE_HPP
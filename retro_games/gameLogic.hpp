@@ -2,7 +2,11 @@
 #define GAME_LOGIC_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <mutex>
 #include <vector>
 
@@ -11,17 +15,242 @@
 namespace s21 {
 
 #define DB_FILE "game_data.db"
+#define STATE_MAGIC 0x32524753  // "SGR2", state with preview of pieces
+#define PREVIEW_SIZE 6          // most pieces in tetris preview queue
+
+// Complete state of engine as fixed size POD, restoring it into engine
+// gives the same future game for the same inputs
+struct GameState_t {
+  struct Shape_t {
+    uint8_t grid[NEXT_HEIGHT][NEXT_WIDTH];
+    int8_t width;
+    int8_t height;
+    int8_t x;
+    int8_t y;
+  };
+
+  uint32_t magic;
+  uint8_t gameType;
+  uint8_t status;
+  uint8_t pause;
+  uint8_t hasShapes;
+  int32_t score;
+  int32_t high_score;
+  int32_t level;
+  int32_t speed;
+  uint64_t random;
+  uint8_t field[FIELD_HEIGHT][FIELD_WIDTH];
+  Shape_t current;  // tetris only
+  Shape_t next;     // tetris only
+  // tetris only: coming pieces from next one on, see TetrisLogic::pieceShape
+  uint8_t preview[PREVIEW_SIZE];
+  uint8_t previewSize;
+  uint8_t bag;  // tetris: bit of each piece type left in bag
+};
+
+// layouts of observation written by GameLogic::exportObservation
+enum class ObservationLayout { BYTES, BITS };
+
+#define OBSERVATION_STATS 6  // score, high score, level, speed, pause, status
+
+static_assert(FIELD_WIDTH <= 16, "row of field must fit in uint16_t");
+
+// kinds of keys of Zobrist hash, key is taken by kind and cell
+#define HASH_FILLED 0  // tetris: locked cell
+#define HASH_PIECE 1   // tetris: cell of falling piece
+#define HASH_NEXT 2    // tetris: cell of next piece grid
+#define HASH_FOOD 3    // snake: food
+#define HASH_HEAD 4    // snake: head, plus direction
+#define HASH_LINK 8    // snake: body, plus direction to previous part
+#define HASH_KINDS 12
+
+#define MIN_FIELD_SIZE 5  // smallest width and height of board
+
+// Size of board as type of engine helpers. Classic board is known at
+// compile time, so its loops have constant bounds; any other size is
+// read at run time.
+template <int W, int H>
+struct FixedBoard {
+  constexpr int width() const { return W; }
+  constexpr int height() const { return H; }
+};
+
+using ClassicBoard = FixedBoard<FIELD_WIDTH, FIELD_HEIGHT>;
+
+struct DynamicBoard {
+  int fieldWidth;
+  int fieldHeight;
+  int width() const { return fieldWidth; }
+  int height() const { return fieldHeight; }
+};
 
 class GameLogic {
  public:
+  GameLogic() {
+    auto now = std::chrono::high_resolution_clock::now();
+    randomGenerator.setSeed(now.time_since_epoch().count());
+  }
   virtual ~GameLogic() = default;
   virtual void userInput(UserAction_t action, bool hold) = 0;
   virtual GameInfo_t updateCurrentState() = 0;
   virtual void gameTick() = 0;
+  virtual void saveState(GameState_t& state) const = 0;
+  // returns false if state belongs to other game
+  virtual bool loadState(const GameState_t& state) = 0;
+  void setSeed(uint64_t seed) { randomGenerator.setSeed(seed); }
   GameStatus getCurrentGameStatus() const { return currentGameStatus; }
+  // state without copy, for the thread owning the game
+  const GameInfo_t& getGameInfo() const { return gameInfo; }
+
+  // Zobrist hash of board, pieces and snake, kept up to date by moves.
+  // Score, level and status are not a part of it.
+  virtual uint64_t getHash() const { return hash; }
+
+  // random key, the same in every run; directions of snake are in order
+  // of SnakeLogic::Direct. Cells of classic board are taken from table,
+  // cells out of it are mixed when asked.
+  static uint64_t hashKey(int kind, int cell) {
+    static const auto keys = []() {
+      std::array<uint64_t, HASH_KINDS * FIELD_HEIGHT * FIELD_WIDTH> keys;
+      for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = mixKey(i + 1);
+      }
+      return keys;
+    }();
+    return cell < FIELD_HEIGHT * FIELD_WIDTH
+               ? keys[kind * FIELD_HEIGHT * FIELD_WIDTH + cell]
+               : mixKey((uint64_t(kind + 1) << 32) + cell);
+  }
+
+  // cell the view of large board follows: snake head, falling piece
+  virtual void getFocus(int& x, int& y) const {
+    x = 0;
+    y = 0;
+  }
+
+  // Copy of state with window of field of width x height around focus,
+  // window is moved inside board. Cost depends on window only, so views
+  // of large board take it instead of updateCurrentState.
+  GameInfo_t getViewport(int width, int height) const {
+    std::lock_guard<std::mutex> lock(gameTickMutex);
+    GameInfo_t view;
+    view.score = gameInfo.score;
+    view.high_score = gameInfo.high_score;
+    view.level = gameInfo.level;
+    view.speed = gameInfo.speed;
+    view.pause = gameInfo.pause;
+    view.width = std::min(width, gameInfo.width);
+    view.height = std::min(height, gameInfo.height);
+
+    int focusX = 0;
+    int focusY = 0;
+    getFocus(focusX, focusY);
+    int left = std::clamp(focusX - view.width / 2, 0,
+                          gameInfo.width - view.width);
+    int top = std::clamp(focusY - view.height / 2, 0,
+                         gameInfo.height - view.height);
+    view.field = new int*[view.height];
+    for (int y = 0; y < view.height; y++) {
+      view.field[y] = new int[view.width];
+      memcpy(view.field[y], gameInfo.field[top + y] + left,
+             view.width * sizeof(int));
+    }
+
+    if (gameInfo.next != nullptr) {
+      view.next = new int*[NEXT_HEIGHT];
+      for (int y = 0; y < NEXT_HEIGHT; y++) {
+        view.next[y] = new int[NEXT_WIDTH];
+        memcpy(view.next[y], gameInfo.next[y], NEXT_WIDTH * sizeof(int));
+      }
+    }
+    return view;
+  }
+
+  int getWidth() const { return gameInfo.width; }
+  int getHeight() const { return gameInfo.height; }
+  // only classic board fits GameState_t, frames and observations
+  bool isClassicBoard() const {
+    return gameInfo.width == FIELD_WIDTH && gameInfo.height == FIELD_HEIGHT;
+  }
+
+  static size_t observationSize(ObservationLayout layout) {
+    size_t stats = OBSERVATION_STATS * sizeof(int32_t);
+    return layout == ObservationLayout::BITS
+               ? FIELD_HEIGHT * sizeof(uint16_t) + NEXT_HEIGHT + stats
+               : FIELD_HEIGHT * FIELD_WIDTH + NEXT_HEIGHT * NEXT_WIDTH + stats;
+  }
+
+  // value of cell in observations, ghost is not a part of board
+  uint8_t observedCell(int value) const {
+    return value == ghostCell ? 0 : static_cast<uint8_t>(value);
+  }
+
+  // Writes observation of classic board into buffer of caller, nothing is
+  // allocated:
+  //   BYTES  uint8 field[FIELD_HEIGHT][FIELD_WIDTH] as values of cells
+  //          (ghost is 0), uint8 next[NEXT_HEIGHT][NEXT_WIDTH], int32 stats
+  //   BITS   uint16 field[FIELD_HEIGHT] and uint8 next[NEXT_HEIGHT], bit x is
+  //          filled cell in column x (ghost is empty), int32 stats
+  // Stats are OBSERVATION_STATS numbers, host byte order, no padding.
+  // Returns size written, 0 if buffer is smaller than observationSize or
+  // board is not classic.
+  size_t exportObservation(void* buffer, size_t size,
+                           ObservationLayout layout) const {
+    if (size < observationSize(layout) || !isClassicBoard()) return 0;
+    bool isBits = layout == ObservationLayout::BITS;
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      const int* row = gameInfo.field[y];
+      uint16_t bits = 0;
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        if (isBits) {
+          bits |= (observedCell(row[x]) != 0) << x;
+        } else {
+          *out++ = observedCell(row[x]);
+        }
+      }
+      if (isBits) {
+        memcpy(out, &bits, sizeof(bits));
+        out += sizeof(bits);
+      }
+    }
+
+    for (int y = 0; y < NEXT_HEIGHT; y++) {
+      uint8_t bits = 0;
+      for (int x = 0; x < NEXT_WIDTH; x++) {
+        int value = gameInfo.next ? gameInfo.next[y][x] : 0;
+        if (isBits) {
+          bits |= (value != 0) << x;
+        } else {
+          *out++ = static_cast<uint8_t>(value);
+        }
+      }
+      if (isBits) {
+        *out++ = bits;
+      }
+    }
+
+    int32_t stats[OBSERVATION_STATS] = {
+        gameInfo.score, gameInfo.high_score, gameInfo.level, gameInfo.speed,
+        gameInfo.pause, static_cast<int32_t>(currentGameStatus)};
+    memcpy(out, stats, sizeof(stats));
+    return observationSize(layout);
+  }
   std::chrono::high_resolution_clock::time_point lastTickTime;
+  // ticks and falls made so far, counts steps of game unlike clock
+  uint64_t getTickCount() const { return tickCount; }
+
+  // off for headless runs of many games, scores are not read or written
+  static void setHighScoreStorage(bool isEnabled) {
+    highScoreStorage() = isEnabled;
+  }
+  // the same for this game only, its high score is kept in memory
+  void setSavesHighScore(bool isSaved) { savesHighScore = isSaved; }
 
   static void saveHighScore(int highScore, int idGame) {
+    if (!highScoreStorage()) return;
+    std::lock_guard<std::mutex> lock(highScoreMutex());
     struct Record {
       int32_t id;
       int32_t score;
@@ -60,7 +289,9 @@ class GameLogic {
       int32_t score;
     };
     int score = 0;
+    if (!highScoreStorage()) return score;
 
+    std::lock_guard<std::mutex> lock(highScoreMutex());
     FILE* file = fopen(DB_FILE, "rb");
     if (file) {
       while (true) {
@@ -78,9 +309,92 @@ class GameLogic {
   }
 
  protected:
+  // several games may run in one process (server), serialize access to DB
+  static std::mutex& highScoreMutex() {
+    static std::mutex dbMutex;
+    return dbMutex;
+  }
+
+  static std::atomic<bool>& highScoreStorage() {
+    static std::atomic<bool> isEnabled = true;
+    return isEnabled;
+  }
+
+  // splitmix64 of index
+  static uint64_t mixKey(uint64_t index) {
+    uint64_t z = 0x5A0B7157ull + index * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // calls action with size of board: fixed one for classic board, so
+  // templates of helpers are compiled for it with constant bounds
+  template <class Action>
+  auto withBoard(Action&& action) const {
+    return isClassicBoard()
+               ? action(ClassicBoard{})
+               : action(DynamicBoard{gameInfo.width, gameInfo.height});
+  }
+
+  // common part of saveState and loadState, state of other board is
+  // marked invalid by zero magic
+  void saveCommonState(GameState_t& state, GameType gameType) const {
+    state.magic = isClassicBoard() ? STATE_MAGIC : 0;
+    state.gameType = static_cast<uint8_t>(gameType);
+    state.status = static_cast<uint8_t>(currentGameStatus);
+    state.pause = static_cast<uint8_t>(gameInfo.pause);
+    state.hasShapes = 0;
+    memset(state.preview, 0, sizeof(state.preview));
+    state.previewSize = 0;
+    state.bag = 0;
+    state.score = gameInfo.score;
+    state.high_score = gameInfo.high_score;
+    state.level = gameInfo.level;
+    state.speed = gameInfo.speed;
+    state.random = randomGenerator.getState();
+    for (int y = 0; y < FIELD_HEIGHT && isClassicBoard(); y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        state.field[y][x] = static_cast<uint8_t>(gameInfo.field[y][x]);
+      }
+    }
+  }
+
+  bool loadCommonState(const GameState_t& state, GameType gameType) {
+    if (state.magic != STATE_MAGIC ||
+        state.gameType != static_cast<uint8_t>(gameType) ||
+        !isClassicBoard()) {
+      return false;
+    }
+    currentGameStatus = static_cast<GameStatus>(state.status);
+    gameInfo.pause = state.pause;
+    gameInfo.score = state.score;
+    gameInfo.high_score = state.high_score;
+    gameInfo.level = state.level;
+    gameInfo.speed = state.speed;
+    randomGenerator.setState(state.random);
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        gameInfo.field[y][x] = state.field[y][x];
+      }
+    }
+    return true;
+  }
+
+  // game has advanced by a tick or a fall
+  void markTick() {
+    lastTickTime = std::chrono::high_resolution_clock::now();
+    tickCount++;
+  }
+
   GameInfo_t gameInfo;
+  int ghostCell = 0;  // value drawn over empty cells, empty in observations
+  bool savesHighScore = true;  // off for games of bots and batches
+  uint64_t hash = 0;  // tetris: locked cells only
+  uint64_t tickCount = 0;
   GameStatus currentGameStatus = GameStatus::INIT;
-  std::mutex gameTickMutex;
+  mutable std::mutex gameTickMutex;
+  RandomGenerator randomGenerator;
 };
 }  // namespace s21
 
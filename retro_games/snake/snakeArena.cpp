@@ -0,0 +1,576 @@
+#include "snakeArena.hpp"
+
+#include <climits>
+#include <cstdlib>
+
+using namespace s21;
+using enum SnakeLogic::Field;
+using enum SnakeLogic::Direct;
+
+#define DB_ID 213
+#define START_SIZE 4  // parts of new snake
+#define BODY_CELL (static_cast<int>(HEAD_DOWN) + 1)
+#define FREE_OWNER 0
+#define FOOD_OWNER -1
+#define SPAWN_TRIES 100  // random places tried for new snake
+
+static const int dx[] = {-1, 1, 0, 0};
+static const int dy[] = {0, 0, -1, 1};
+
+// turn back of direction: LEFT and RIGHT, UP and DOWN
+static int reverse(int direct) { return direct ^ 1; }
+
+// neighbour of cell, -1 out of board
+static int nextCell(const Arena& arena, int cell, int direct) {
+  int x = cell % arena.width + dx[direct];
+  int y = cell / arena.width + dy[direct];
+  bool isInside = x >= 0 && x < arena.width && y >= 0 && y < arena.height;
+  return isInside ? y * arena.width + x : -1;
+}
+
+// direction from cell to its neighbour, as index of Direct
+static int cellDirect(const Arena& arena, int cell, int to) {
+  int direct = static_cast<int>(DOWN);
+  if (to == cell - 1) {
+    direct = static_cast<int>(LEFT);
+  } else if (to == cell + 1) {
+    direct = static_cast<int>(RIGHT);
+  } else if (to == cell - arena.width) {
+    direct = static_cast<int>(UP);
+  }
+  return direct;
+}
+
+static int& fieldCell(const Arena& arena, GameInfo_t& gameInfo, int cell) {
+  return gameInfo.field[cell / arena.width][cell % arena.width];
+}
+
+static int snakeCell(const ArenaSnake& snake, size_t part) {
+  return snake.body[(snake.head + part) % snake.body.size()];
+}
+
+static int facing(const Arena& arena, const ArenaSnake& snake,
+                  GameInfo_t& gameInfo) {
+  return fieldCell(arena, gameInfo, snakeCell(snake, 0)) -
+         static_cast<int>(HEAD_LEFT);
+}
+
+static bool isHead(const Arena& arena, int cell) {
+  int owner = arena.occupant[cell];
+  return owner > 0 && snakeCell(arena.snakes[owner - 1], 0) == cell;
+}
+
+static bool isTail(const Arena& arena, int cell) {
+  int owner = arena.occupant[cell];
+  const ArenaSnake* snake = owner > 0 ? &arena.snakes[owner - 1] : nullptr;
+  return snake && snakeCell(*snake, snake->length - 1) == cell;
+}
+
+static void takeCell(Arena& arena, int cell, int owner) {
+  int index = arena.freeIndex[cell];
+  int last = arena.freeCells.back();
+  arena.freeCells[index] = last;
+  arena.freeIndex[last] = index;
+  arena.freeCells.pop_back();
+  arena.occupant[cell] = owner;
+}
+
+static void releaseCell(Arena& arena, int cell) {
+  arena.freeIndex[cell] = static_cast<int>(arena.freeCells.size());
+  arena.freeCells.push_back(cell);
+  arena.occupant[cell] = FREE_OWNER;
+}
+
+// ring grows twice when it is full, so long snakes do not reserve board
+static void pushHead(ArenaSnake& snake, int cell) {
+  if (snake.length == snake.body.size()) {
+    std::vector<int> body(std::max<size_t>(2 * snake.length, START_SIZE));
+    for (size_t i = 0; i < snake.length; i++) {
+      body[i] = snakeCell(snake, i);
+    }
+    snake.body.swap(body);
+    snake.head = 0;
+  }
+  snake.head = (snake.head + snake.body.size() - 1) % snake.body.size();
+  snake.body[snake.head] = cell;
+  snake.length++;
+}
+
+//
+// ============================================================================
+// Food
+// ============================================================================
+
+static void spawnFood(Arena& arena, GameInfo_t& gameInfo,
+                      RandomGenerator& random, uint64_t& hash) {
+  if (arena.freeCells.empty()) return;
+  int size = static_cast<int>(arena.freeCells.size());
+  int cell = arena.freeCells[random.next(size)];
+  takeCell(arena, cell, FOOD_OWNER);
+  arena.foodCells.push_back(cell);
+  fieldCell(arena, gameInfo, cell) = static_cast<int>(FOOD);
+  hash ^= GameLogic::hashKey(HASH_FOOD, cell);
+}
+
+static void removeFood(Arena& arena, int cell, uint64_t& hash) {
+  auto food = std::find(arena.foodCells.begin(), arena.foodCells.end(), cell);
+  *food = arena.foodCells.back();
+  arena.foodCells.pop_back();
+  hash ^= GameLogic::hashKey(HASH_FOOD, cell);
+}
+
+static void scoreFood(ArenaSnake& snake, bool isPlayer,
+                      GameInfo_t& gameInfo) {
+  snake.score++;
+  if (!isPlayer) return;
+  gameInfo.score = snake.score;
+
+  while (gameInfo.level < 10 && gameInfo.score >= gameInfo.level * 5) {
+    gameInfo.level++;
+    gameInfo.speed++;
+  }
+
+  // high score is stored by game after its step
+  if (gameInfo.score > gameInfo.high_score) {
+    gameInfo.high_score = gameInfo.score;
+  }
+}
+
+//
+// ============================================================================
+// Snakes
+// ============================================================================
+
+static bool placeSnake(Arena& arena, int index, int head, int direct,
+                       GameInfo_t& gameInfo, uint64_t& hash) {
+  int cells[START_SIZE];
+  bool isFree = nextCell(arena, head, direct) >= 0 &&
+                arena.occupant[nextCell(arena, head, direct)] == FREE_OWNER;
+  for (int i = 0; i < START_SIZE && isFree; i++) {
+    cells[i] = i == 0 ? head : nextCell(arena, cells[i - 1], reverse(direct));
+    isFree = cells[i] >= 0 && arena.occupant[cells[i]] == FREE_OWNER;
+  }
+  if (!isFree) return false;
+
+  // from tail, each part is linked to the next one by direct
+  ArenaSnake& snake = arena.snakes[index];
+  snake.head = 0;
+  snake.length = 0;
+  for (int i = START_SIZE - 1; i >= 0; i--) {
+    takeCell(arena, cells[i], index + 1);
+    pushHead(snake, cells[i]);
+    int kind = i == 0 ? HASH_HEAD : HASH_LINK;
+    hash ^= GameLogic::hashKey(kind + direct, cells[i]);
+    fieldCell(arena, gameInfo, cells[i]) =
+        i == 0 ? static_cast<int>(HEAD_LEFT) + direct : BODY_CELL;
+  }
+  snake.moved = direct;
+  snake.isAlive = true;
+  arena.alive++;
+  return true;
+}
+
+static void spawnSnake(Arena& arena, int index, GameInfo_t& gameInfo,
+                       RandomGenerator& random, uint64_t& hash) {
+  int cells = arena.width * arena.height;
+  bool isPlaced = false;
+  for (int i = 0; i < SPAWN_TRIES && !isPlaced; i++) {
+    int direct = random.next(4);
+    int head = random.next(cells);
+    isPlaced = placeSnake(arena, index, head, direct, gameInfo, hash);
+  }
+}
+
+static void removeSnake(Arena& arena, int index, GameInfo_t& gameInfo,
+                        uint64_t& hash) {
+  ArenaSnake& snake = arena.snakes[index];
+  if (!snake.isAlive) return;
+  int direct = facing(arena, snake, gameInfo);
+  hash ^= GameLogic::hashKey(HASH_HEAD + direct, snakeCell(snake, 0));
+  for (size_t i = 0; i < snake.length; i++) {
+    int cell = snakeCell(snake, i);
+    if (i > 0) {
+      direct = cellDirect(arena, cell, snakeCell(snake, i - 1));
+      hash ^= GameLogic::hashKey(HASH_LINK + direct, cell);
+    }
+    fieldCell(arena, gameInfo, cell) = 0;
+    releaseCell(arena, cell);
+  }
+  snake.length = 0;
+  snake.isAlive = false;
+  arena.alive--;
+}
+
+static void steerSnake(Arena& arena, int index, int direct,
+                       GameInfo_t& gameInfo, uint64_t& hash) {
+  ArenaSnake& snake = arena.snakes[index];
+  if (!snake.isAlive || direct == reverse(snake.moved)) return;
+  int head = snakeCell(snake, 0);
+  int& value = fieldCell(arena, gameInfo, head);
+  int kind = HASH_HEAD - static_cast<int>(HEAD_LEFT);
+  hash ^= GameLogic::hashKey(kind + value, head);
+  value = static_cast<int>(HEAD_LEFT) + direct;
+  hash ^= GameLogic::hashKey(kind + value, head);
+}
+
+static int distance(const Arena& arena, int cell, int to) {
+  return std::abs(to % arena.width - cell % arena.width) +
+         std::abs(to / arena.width - cell / arena.width);
+}
+
+static int nearestFood(const Arena& arena, int cell) {
+  int nearest = -1;
+  for (int food : arena.foodCells) {
+    if (nearest < 0 || distance(arena, cell, food) <
+                           distance(arena, cell, nearest)) {
+      nearest = food;
+    }
+  }
+  return nearest;
+}
+
+// cell at x, y, -1 out of board
+static int cellAt(const Arena& arena, int x, int y) {
+  bool isInside = x >= 0 && x < arena.width && y >= 0 && y < arena.height;
+  return isInside ? y * arena.width + x : -1;
+}
+
+// bot takes free cell nearest to its food, cells next to other heads are
+// taken last as they may end in head-on collision; food is searched again
+// only when it is eaten, so usual turn does not look over all food.
+// Cells are checked by coordinates, without division per neighbour.
+static void steerBot(Arena& arena, int index, GameInfo_t& gameInfo,
+                     uint64_t& hash) {
+  ArenaSnake& snake = arena.snakes[index];
+  int head = snakeCell(snake, 0);
+  if (snake.food < 0 || arena.occupant[snake.food] != FOOD_OWNER) {
+    snake.food = nearestFood(arena, head);
+  }
+  int headX = head % arena.width;
+  int headY = head / arena.width;
+  int foodX = snake.food < 0 ? headX : snake.food % arena.width;
+  int foodY = snake.food < 0 ? headY : snake.food / arena.width;
+
+  int bestDirect = -1;
+  int bestCost = INT_MAX;
+  for (int direct = 0; direct < 4; direct++) {
+    int x = headX + dx[direct];
+    int y = headY + dy[direct];
+    int cell = cellAt(arena, x, y);
+    if (direct == reverse(snake.moved) || cell < 0 ||
+        arena.occupant[cell] > 0) {
+      continue;
+    }
+    int cost = std::abs(foodX - x) + std::abs(foodY - y);
+    for (int side = 0; side < 4; side++) {
+      int near = cellAt(arena, x + dx[side], y + dy[side]);
+      if (near >= 0 && near != head && isHead(arena, near)) {
+        cost += arena.width + arena.height;
+      }
+    }
+    if (cost < bestCost) {
+      bestCost = cost;
+      bestDirect = direct;
+    }
+  }
+  if (bestDirect >= 0) {
+    steerSnake(arena, index, bestDirect, gameInfo, hash);
+  }
+}
+
+//
+// ============================================================================
+// Tick
+// ============================================================================
+
+// head may go to a tail which leaves: tail of snake not eating on tick
+static void findTargets(Arena& arena, GameInfo_t& gameInfo) {
+  int count = static_cast<int>(arena.snakes.size());
+  for (int i = 0; i < count; i++) {
+    const ArenaSnake& snake = arena.snakes[i];
+    arena.targets[i] = -1;
+    arena.eats[i] = 0;
+    arena.dies[i] = 0;
+    if (snake.isAlive) {
+      int direct = facing(arena, snake, gameInfo);
+      arena.targets[i] = nextCell(arena, snakeCell(snake, 0), direct);
+      arena.eats[i] = arena.targets[i] >= 0 &&
+                      arena.occupant[arena.targets[i]] == FOOD_OWNER;
+      arena.dies[i] = arena.targets[i] < 0;
+    }
+  }
+}
+
+static void findCollisions(Arena& arena) {
+  int count = static_cast<int>(arena.snakes.size());
+  arena.tick++;
+  for (int i = 0; i < count; i++) {
+    int target = arena.targets[i];
+    if (!arena.snakes[i].isAlive || target < 0) continue;
+    if (arena.claimTick[target] == arena.tick) {
+      arena.dies[i] = 1;
+      arena.dies[arena.claimer[target]] = 1;
+    } else {
+      arena.claimTick[target] = arena.tick;
+      arena.claimer[target] = i;
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    int target = arena.targets[i];
+    if (!arena.snakes[i].isAlive || target < 0) continue;
+    int owner = arena.occupant[target];
+    bool isLeaving = owner > 0 && !arena.eats[owner - 1] &&
+                     isTail(arena, target);
+    if (owner > 0 && !isLeaving) {
+      arena.dies[i] = 1;
+    }
+  }
+}
+
+// tails go first, so heads may take their cells
+static void moveSnakes(Arena& arena, GameInfo_t& gameInfo, uint64_t& hash) {
+  int count = static_cast<int>(arena.snakes.size());
+  for (int i = 0; i < count; i++) {
+    ArenaSnake& snake = arena.snakes[i];
+    if (!snake.isAlive || arena.eats[i]) continue;
+    int tail = snakeCell(snake, snake.length - 1);
+    int direct = cellDirect(arena, tail, snakeCell(snake, snake.length - 2));
+    hash ^= GameLogic::hashKey(HASH_LINK + direct, tail);
+    fieldCell(arena, gameInfo, tail) = 0;
+    releaseCell(arena, tail);
+    snake.length--;
+  }
+
+  for (int i = 0; i < count; i++) {
+    ArenaSnake& snake = arena.snakes[i];
+    if (!snake.isAlive) continue;
+    int head = snakeCell(snake, 0);
+    int target = arena.targets[i];
+    int direct = facing(arena, snake, gameInfo);
+    hash ^= GameLogic::hashKey(HASH_HEAD + direct, head) ^
+            GameLogic::hashKey(HASH_LINK + direct, head) ^
+            GameLogic::hashKey(HASH_HEAD + direct, target);
+    if (arena.eats[i]) {
+      removeFood(arena, target, hash);
+      arena.occupant[target] = i + 1;
+      scoreFood(snake, i == 0, gameInfo);
+    } else {
+      takeCell(arena, target, i + 1);
+    }
+    fieldCell(arena, gameInfo, target) = fieldCell(arena, gameInfo, head);
+    fieldCell(arena, gameInfo, head) = BODY_CELL;
+    pushHead(snake, target);
+    snake.moved = direct;
+  }
+}
+
+// one move of all snakes and end of game; eaten food is spawned again
+// after all moves in order of snakes
+static void arenaTick(Arena& arena, GameStatus& gameStatus,
+                      GameInfo_t& gameInfo, RandomGenerator& random,
+                      uint64_t& hash) {
+  int count = static_cast<int>(arena.snakes.size());
+  for (int i = 0; i < count; i++) {
+    if (arena.snakes[i].isAlive && arena.snakes[i].isBot) {
+      steerBot(arena, i, gameInfo, hash);
+    }
+  }
+
+  findTargets(arena, gameInfo);
+  findCollisions(arena);
+  for (int i = 0; i < count; i++) {
+    if (arena.dies[i]) {
+      removeSnake(arena, i, gameInfo, hash);
+    }
+  }
+  moveSnakes(arena, gameInfo, hash);
+  while (static_cast<int>(arena.foodCells.size()) < arena.foods &&
+         !arena.freeCells.empty()) {
+    spawnFood(arena, gameInfo, random, hash);
+  }
+
+  bool isFull = arena.freeCells.empty() && arena.foodCells.empty();
+  if (!arena.snakes[0].isAlive) {
+    gameStatus = GameStatus::GAME_OVER;
+    gameInfo.pause = 1;
+  } else if ((count > 1 && arena.alive == 1) || isFull) {
+    gameStatus = GameStatus::WIN;
+    gameInfo.pause = 1;
+  }
+}
+
+static void initArena(Arena& arena, GameInfo_t& gameInfo,
+                      RandomGenerator& random, uint64_t& hash,
+                      bool savesHighScore) {
+  int cells = arena.width * arena.height;
+  for (int y = 0; y < arena.height; y++) {
+    for (int x = 0; x < arena.width; x++) {
+      gameInfo.field[y][x] = 0;
+    }
+  }
+  arena.freeCells.resize(cells);
+  for (int cell = 0; cell < cells; cell++) {
+    arena.freeCells[cell] = cell;
+    arena.freeIndex[cell] = cell;
+    arena.occupant[cell] = FREE_OWNER;
+  }
+  arena.foodCells.clear();
+  arena.alive = 0;
+  hash = 0;
+
+  if (savesHighScore) {
+    gameInfo.high_score = GameLogic::loadHighScore(DB_ID);
+  }
+  gameInfo.score = 0;
+  gameInfo.level = 1;
+  gameInfo.speed = 1;
+  gameInfo.pause = 0;
+
+  int count = static_cast<int>(arena.snakes.size());
+  for (int i = 0; i < count; i++) {
+    arena.snakes[i].isAlive = false;
+    arena.snakes[i].length = 0;
+    arena.snakes[i].score = 0;
+    arena.snakes[i].food = -1;
+    spawnSnake(arena, i, gameInfo, random, hash);
+  }
+  for (int i = 0; i < arena.foods; i++) {
+    spawnFood(arena, gameInfo, random, hash);
+  }
+}
+
+static void applyInput(Arena& arena, UserAction_t action, bool hold,
+                       GameStatus& gameStatus, GameInfo_t& gameInfo,
+                       RandomGenerator& random, uint64_t& hash,
+                       bool savesHighScore) {
+  using UA = UserAction_t;
+  bool isStart = action == UA::Start;
+  switch (gameStatus) {
+    case GameStatus::INIT:
+      gameStatus = action == UA::Up ? GameStatus::INSTRUCTION : gameStatus;
+      break;
+    case GameStatus::INSTRUCTION:
+      gameStatus = action == UA::Terminate ? GameStatus::INIT : gameStatus;
+      break;
+    case GameStatus::PAUSE:
+      if (isStart || action == UA::Pause || action == UA::Terminate) {
+        gameStatus = GameStatus::GAME;
+        gameInfo.pause = 0;
+      }
+      isStart = false;
+      break;
+    case GameStatus::GAME_OVER:
+    case GameStatus::WIN:
+      gameStatus = action == UA::Terminate ? GameStatus::INIT : gameStatus;
+      break;
+    case GameStatus::GAME:
+      isStart = false;
+      if (hold && (action == UA::Pause || action == UA::Terminate)) {
+        break;
+      } else if (action == UA::Pause || action == UA::Terminate) {
+        gameStatus =
+            action == UA::Pause ? GameStatus::PAUSE : GameStatus::INIT;
+        gameInfo.pause = 1;
+      } else if (action >= UA::Left && action <= UA::Down) {
+        int direct = static_cast<int>(action) - static_cast<int>(UA::Left);
+        steerSnake(arena, 0, direct, gameInfo, hash);
+      } else if (action == UA::Action) {
+        arenaTick(arena, gameStatus, gameInfo, random, hash);
+      }
+      break;
+  }
+
+  if (isStart) {
+    initArena(arena, gameInfo, random, hash, savesHighScore);
+    gameStatus = GameStatus::GAME;
+  }
+}
+
+SnakeArena::SnakeArena(int snakes, int foods, int width, int height)
+    : SnakeLogic(width, height) {
+  size_t cells = static_cast<size_t>(gameInfo.width) * gameInfo.height;
+  size_t count = std::clamp(snakes, 1, MAX_ARENA_SNAKES);
+  arena.width = gameInfo.width;
+  arena.height = gameInfo.height;
+  arena.foods = std::max(foods, 0);
+  arena.snakes.resize(count);
+  arena.snakes[0].isBot = false;
+  arena.occupant.resize(cells);
+  arena.freeIndex.resize(cells);
+  arena.claimTick.resize(cells);
+  arena.claimer.resize(cells);
+  arena.targets.resize(count);
+  arena.eats.resize(count);
+  arena.dies.resize(count);
+}
+
+void SnakeArena::userInput(UserAction_t action, bool hold) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  int highScore = gameInfo.high_score;
+  applyInput(arena, action, hold, currentGameStatus, gameInfo,
+             randomGenerator, hash, savesHighScore);
+  storeHighScore(highScore);
+  if (action == UserAction_t::Action) {
+    markTick();
+  }
+}
+
+void SnakeArena::gameTick() {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  int highScore = gameInfo.high_score;
+  if (currentGameStatus == GameStatus::GAME && !gameInfo.pause) {
+    arenaTick(arena, currentGameStatus, gameInfo, randomGenerator, hash);
+  }
+  storeHighScore(highScore);
+  markTick();
+}
+
+void SnakeArena::storeHighScore(int highScore) const {
+  if (savesHighScore && gameInfo.high_score > highScore) {
+    GameLogic::saveHighScore(gameInfo.high_score, DB_ID);
+  }
+}
+
+void SnakeArena::saveState(GameState_t& state) const {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  saveCommonState(state, GameType::SNAKE);
+  state.magic = 0;
+  state.current = {};
+  state.next = {};
+}
+
+bool SnakeArena::loadState(const GameState_t&) { return false; }
+
+void SnakeArena::getFocus(int& x, int& y) const {
+  const ArenaSnake& player = arena.snakes[0];
+  int cell = player.length > 0 ? snakeCell(player, 0) : 0;
+  x = cell % arena.width;
+  y = cell / arena.width;
+}
+
+void SnakeArena::steer(int index, Direct direct) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  if (index >= 0 && index < getSnakesCount() && direct != NONE) {
+    steerSnake(arena, index, static_cast<int>(direct), gameInfo, hash);
+  }
+}
+
+void SnakeArena::setBot(int index, bool isBot) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  if (index >= 0 && index < getSnakesCount()) {
+    arena.snakes[index].isBot = isBot;
+  }
+}
+
+bool SnakeArena::placeSnake(int index, int x, int y, Direct direct) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  ::removeSnake(arena, index, gameInfo, hash);
+  return ::placeSnake(arena, index, y * arena.width + x,
+                      static_cast<int>(direct), gameInfo, hash);
+}
+
+void SnakeArena::removeSnake(int index) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  ::removeSnake(arena, index, gameInfo, hash);
+}
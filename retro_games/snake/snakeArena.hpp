@@ -0,0 +1,84 @@
+#ifndef SNAKE_ARENA_HPP
+#define SNAKE_ARENA_HPP
+
+#include "snakeLogic.hpp"
+
+namespace s21 {
+
+#define MAX_ARENA_SNAKES 64
+
+// snake of arena, body is ring buffer of cells y * width + x from head
+struct ArenaSnake {
+  std::vector<int> body;
+  size_t head = 0;
+  size_t length = 0;
+  int moved = 0;  // Direct of last move, head cannot turn back to it
+  int score = 0;
+  int food = -1;  // cell bot goes to, kept while food is there
+  bool isAlive = false;
+  bool isBot = true;
+};
+
+// all snakes and food of arena with the grid they share
+struct Arena {
+  int width = 0;
+  int height = 0;
+  int foods = 0;  // food kept on board
+  int alive = 0;  // snakes alive
+  std::vector<ArenaSnake> snakes;
+  std::vector<int> occupant;   // cell: free, food or snake index + 1
+  std::vector<int> freeCells;  // cells without snake and food
+  std::vector<int> freeIndex;  // position of free cell in freeCells
+  std::vector<int> foodCells;
+
+  // buffers of tick
+  std::vector<int> targets;  // cell each snake moves to, -1 out of board
+  std::vector<uint8_t> eats;
+  std::vector<uint8_t> dies;
+  std::vector<uint32_t> claimTick;  // cell: number of tick it was claimed
+  std::vector<int> claimer;         // cell: first snake which claimed it
+  uint32_t tick = 0;
+};
+
+// Several snakes and several food on one board. All snakes move at once on
+// tick: cell of each head is looked up in shared occupancy grid, so tick
+// takes time by number of snakes, not by board or lengths. Heads moving to
+// the same cell all die, so result does not depend on order of snakes;
+// head may take the cell the tail of any snake leaves on this tick.
+// Snake 0 is the player: arrows turn it, Action makes tick at once. Other
+// snakes are bots going to the nearest food unless setBot turns them to
+// steer of caller. Game is lost with the player, won when it is the last.
+// Arena does not fit GameState_t, its saved state is marked invalid.
+class SnakeArena : public SnakeLogic {
+ public:
+  // snakes from 1 to MAX_ARENA_SNAKES, food from 0
+  SnakeArena(int snakes, int foods, int width = FIELD_WIDTH,
+             int height = FIELD_HEIGHT);
+  void userInput(UserAction_t action, bool hold) override;
+  void gameTick() override;
+  void saveState(GameState_t& state) const override;
+  bool loadState(const GameState_t& state) override;
+  // head of player
+  void getFocus(int& x, int& y) const override;
+
+  int getSnakesCount() const { return static_cast<int>(arena.snakes.size()); }
+  int getAliveCount() const { return arena.alive; }
+  // for the thread owning the game
+  const ArenaSnake& getSnake(int index) const { return arena.snakes[index]; }
+  // turn before next tick, turn back is ignored
+  void steer(int index, Direct direct);
+  void setBot(int index, bool isBot);
+
+ protected:
+  // new snake of START_SIZE with head at x, y going to direct, false if
+  // its cells or cell before head are taken
+  bool placeSnake(int index, int x, int y, Direct direct);
+  void removeSnake(int index);
+  // saves high score if step has raised it over highScore
+  void storeHighScore(int highScore) const;
+
+  Arena arena;
+};
+}  // namespace s21
+
+#endif  // SNAKE_ARENA_HPP
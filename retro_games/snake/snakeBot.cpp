@@ -0,0 +1,265 @@
+#include "snakeBot.hpp"
+
+#include "snakeLogic.hpp"
+
+using namespace s21;
+
+#define FIRST_BODY 6  // value of body cell next to head on field
+#define SHORTCUT_MARGIN 4  // free cells kept before tail after shortcut
+
+static_assert(FIELD_WIDTH % 2 == 0 || FIELD_HEIGHT % 2 == 0,
+              "Hamiltonian cycle needs even side of field");
+
+// same order as SnakeLogic::Direct
+static const int dx[] = {-1, 1, 0, 0};
+static const int dy[] = {0, 0, -1, 1};
+static const UserAction_t moves[] = {UserAction_t::Left, UserAction_t::Right,
+                                     UserAction_t::Up, UserAction_t::Down};
+
+static int neighbour(int cell, int direction) {
+  int x = cell % FIELD_WIDTH + dx[direction];
+  int y = cell / FIELD_WIDTH + dy[direction];
+  bool inField = x >= 0 && x < FIELD_WIDTH && y >= 0 && y < FIELD_HEIGHT;
+  return inField ? y * FIELD_WIDTH + x : -1;
+}
+
+// Row 0 from left to right, then columns from right to left in zigzag
+// over other rows, back up along column 0. Needs even number of columns,
+// else rows and columns are swapped.
+static void buildCycle(int order[SNAKE_CELLS]) {
+  bool byColumns = FIELD_WIDTH % 2 == 0;
+  int across = byColumns ? FIELD_WIDTH : FIELD_HEIGHT;
+  int along = byColumns ? FIELD_HEIGHT : FIELD_WIDTH;
+  auto cell = [byColumns](int a, int b) {
+    return byColumns ? b * FIELD_WIDTH + a : a * FIELD_WIDTH + b;
+  };
+
+  int count = 0;
+  for (int a = 0; a < across; a++) {
+    order[count++] = cell(a, 0);
+  }
+  for (int a = across - 1; a > 0; a--) {
+    bool isForward = (across - 1 - a) % 2 == 0;
+    for (int b = 1; b < along; b++) {
+      order[count++] = cell(a, isForward ? b : along - b);
+    }
+  }
+  for (int b = along - 1; b > 0; b--) {
+    order[count++] = cell(0, b);
+  }
+}
+
+SnakeBot::SnakeBot(Mode mode) : mode(mode) {
+  buildCycle(order);
+  for (int i = 0; i < SNAKE_CELLS; i++) {
+    cycle[order[i]] = i;
+  }
+}
+
+int SnakeBot::search(const Grid& blocked, int start, int target) {
+  for (int i = 0; i < SNAKE_CELLS; i++) {
+    distance[i] = -1;
+  }
+  int head = 0;
+  int tail = 0;
+  queue[tail++] = start;
+  distance[start] = 0;
+
+  while (head < tail && (target < 0 || distance[target] < 0)) {
+    int cell = queue[head++];
+    for (int direction = 0; direction < 4; direction++) {
+      int next = neighbour(cell, direction);
+      if (next >= 0 && distance[next] < 0 &&
+          (next == target || !blocked[next])) {
+        distance[next] = distance[cell] + 1;
+        parent[next] = cell;
+        queue[tail++] = next;
+      }
+    }
+  }
+
+  return target < 0 ? -1 : distance[target];
+}
+
+int SnakeBot::countFree(const Grid& blocked, int start) {
+  search(blocked, start, -1);
+  int count = 0;
+  for (int i = 0; i < SNAKE_CELLS; i++) {
+    count += distance[i] >= 0;
+  }
+  return count;
+}
+
+void SnakeBot::moveVirtual(int pathLength, bool eats) {
+  virtualLength = std::min(pathLength + length, length + (eats ? 1 : 0));
+  virtualBody.reset();
+  for (int i = 0; i < virtualLength; i++) {
+    int cell = i < pathLength ? path[pathLength - 1 - i]
+                              : snake[i - pathLength];
+    virtualSnake[i] = cell;
+    virtualBody.set(cell);
+  }
+}
+
+// tail moves away, so snake is safe while it can come next to the tail;
+// returns distance to free cell near tail, -1 if there is none
+int SnakeBot::tailDistance() {
+  int head = virtualSnake[0];
+  int tail = virtualSnake[virtualLength - 1];
+  search(virtualBody, head, -1);
+
+  int best = -1;
+  for (int direction = 0; direction < 4; direction++) {
+    int cell = neighbour(tail, direction);
+    if (cell >= 0 && !virtualBody[cell] && distance[cell] > 0) {
+      best = std::max(best, distance[cell]);
+    }
+  }
+  return best;
+}
+
+int SnakeBot::chooseMove() {
+  int head = snake[0];
+
+  // shortest path to food
+  if (food >= 0) {
+    int pathLength = search(body, head, food);
+    if (pathLength > 0) {
+      for (int cell = food, i = pathLength - 1; i >= 0; i--) {
+        path[i] = cell;
+        cell = parent[cell];
+      }
+      moveVirtual(pathLength, true);
+      if (tailDistance() > 0) {
+        return path[0];
+      }
+    }
+  }
+
+  // no safe way to food, go the long way round to the tail
+  int bestMove = -1;
+  int bestScore = -1;
+  for (int direction = 0; direction < 4; direction++) {
+    int cell = neighbour(head, direction);
+    if (cell < 0 || body[cell]) continue;
+    path[0] = cell;
+    moveVirtual(1, cell == food);
+    int score = tailDistance();
+    if (score > bestScore) {
+      bestScore = score;
+      bestMove = cell;
+    }
+  }
+
+  // tail is lost, take the biggest free area
+  for (int direction = 0; direction < 4 && bestScore < 0; direction++) {
+    int cell = neighbour(head, direction);
+    if (cell < 0 || body[cell]) continue;
+    int score = countFree(body, cell);
+    if (score > bestScore) {
+      bestScore = score;
+      bestMove = cell;
+    }
+  }
+
+  return bestMove;
+}
+
+bool SnakeBot::isOnCycle() const {
+  int tail = cycle[snake[length - 1]];
+  bool isOrdered = true;
+  int last = -1;
+  for (int i = length - 1; i >= 0 && isOrdered; i--) {
+    int position = (cycle[snake[i]] - tail + SNAKE_CELLS) % SNAKE_CELLS;
+    isOrdered = position > last;
+    last = position;
+  }
+  return isOrdered;
+}
+
+// Snake on cycle is safe while head stays behind tail on cycle. Shortcut
+// skips part of cycle, but never food or tail, and only while snake is
+// shorter than half of field.
+int SnakeBot::chooseCycleMove() {
+  int head = snake[0];
+  int next = order[(cycle[head] + 1) % SNAKE_CELLS];
+  if (body[next]) {
+    // body is not laid on cycle yet or tail is right ahead
+    return chooseMove();
+  }
+  if (!isOnCycle()) {
+    return next;
+  }
+
+  auto ahead = [this, head](int cell) {
+    return (cycle[cell] - cycle[head] + SNAKE_CELLS) % SNAKE_CELLS;
+  };
+  int tailGap = ahead(snake[length - 1]);
+  int foodGap = food >= 0 ? ahead(food) : tailGap;
+  int bestMove = next;
+
+  for (int direction = 0; direction < 4 && length < SNAKE_CELLS / 2;
+       direction++) {
+    int cell = neighbour(head, direction);
+    if (cell < 0 || body[cell]) continue;
+    int steps = ahead(cell);
+    if (steps <= foodGap && steps < tailGap - SHORTCUT_MARGIN &&
+        steps > ahead(bestMove)) {
+      bestMove = cell;
+    }
+  }
+  return bestMove;
+}
+
+bool SnakeBot::nextAction(const GameLogic& game, UserAction_t& action) {
+  GameState_t state;
+  game.saveState(state);
+  GameStatus status = static_cast<GameStatus>(state.status);
+  if (state.magic != STATE_MAGIC) {
+    return false;  // board is not classic, state has no field
+  }
+
+  if (status == GameStatus::INIT || status == GameStatus::GAME_OVER ||
+      status == GameStatus::WIN) {
+    action = UserAction_t::Start;
+    return true;
+  }
+  if (status != GameStatus::GAME) {
+    return false;
+  }
+
+  int headValue = 0;
+  length = 1;
+  food = -1;
+  body.reset();
+  for (int cell = 0; cell < SNAKE_CELLS; cell++) {
+    int value = state.field[cell / FIELD_WIDTH][cell % FIELD_WIDTH];
+    if (value == static_cast<int>(SnakeLogic::Field::FOOD)) {
+      food = cell;
+    } else if (value >= FIRST_BODY) {
+      snake[value - FIRST_BODY + 1] = cell;
+      length = std::max(length, value - FIRST_BODY + 2);
+      body.set(cell);
+    } else if (value) {
+      snake[0] = cell;
+      headValue = value;
+      body.set(cell);
+    }
+  }
+
+  int move = -1;
+  if (headValue) {
+    move = mode == Mode::CYCLE ? chooseCycleMove() : chooseMove();
+  }
+  if (move < 0) {
+    // no way out, keep going
+    int direction = headValue - static_cast<int>(SnakeLogic::Field::HEAD_LEFT);
+    action = moves[std::max(0, direction)];
+  }
+  for (int direction = 0; direction < 4 && move >= 0; direction++) {
+    if (neighbour(snake[0], direction) == move) {
+      action = moves[direction];
+    }
+  }
+  return true;
+}
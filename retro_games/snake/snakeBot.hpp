@@ -0,0 +1,63 @@
+#ifndef SNAKE_BOT_HPP
+#define SNAKE_BOT_HPP
+
+#include <bitset>
+
+#include "../gameBot.hpp"
+
+namespace s21 {
+
+#define SNAKE_CELLS (FIELD_WIDTH * FIELD_HEIGHT)
+
+// Snake bot: goes by the shortest path to food if the tail is still
+// reachable after eating, else follows the tail by the longest safe move.
+// Grid and buffers of search are members, nothing is allocated per move.
+class SnakeBot : public GameBot {
+ public:
+  using Grid = std::bitset<SNAKE_CELLS>;  // bit y * FIELD_WIDTH + x
+
+  // PATH: shortest safe path to food, CYCLE: Hamiltonian cycle over whole
+  // field with safe shortcuts, slower but always fills the field
+  enum class Mode { PATH, CYCLE };
+
+  explicit SnakeBot(Mode mode = Mode::PATH);
+  bool nextAction(const GameLogic& game, UserAction_t& action) override;
+  // cell at position on Hamiltonian cycle
+  int getCycleCell(int position) const { return order[position]; }
+
+ private:
+  // distance from start to target over free cells, -1 if unreachable
+  int search(const Grid& blocked, int start, int target);
+  int countFree(const Grid& blocked, int start);
+  // virtual snake after moves along path
+  void moveVirtual(int pathLength, bool eats);
+  int tailDistance();
+  int chooseMove();
+  // body lies on cycle from tail to head in order
+  bool isOnCycle() const;
+  int chooseCycleMove();
+
+  Mode mode;
+  int order[SNAKE_CELLS];  // cells in order of cycle
+  int cycle[SNAKE_CELLS];  // position of cell on cycle
+
+  // snake of current state, head first
+  int snake[SNAKE_CELLS];
+  int length = 0;
+  int food = -1;
+  Grid body;
+
+  // virtual snake to check moves
+  int virtualSnake[SNAKE_CELLS];
+  int virtualLength = 0;
+  Grid virtualBody;
+
+  // buffers of search
+  int queue[SNAKE_CELLS];
+  int distance[SNAKE_CELLS];
+  int parent[SNAKE_CELLS];
+  int path[SNAKE_CELLS];
+};
+}  // namespace s21
+
+#endif  // SNAKE_BOT_HPP
@@ -1,15 +1,20 @@
 #include "snakeLogic.hpp"
 
+#include <type_traits>
+
 using namespace s21;
 using enum SnakeLogic::Field;
 using enum SnakeLogic::Direct;
 
 #define DB_ID 212
+#define START_SIZE 4  // parts of new snake
+#define BODY_CELL (static_cast<int>(HEAD_DOWN) + 1)  // body on large board
 
-static bool checkWin(GameInfo_t& gameInfo) {
+template <class Board>
+static bool checkWin(const Board& board, GameInfo_t& gameInfo) {
   bool fieldIsFull = true;
-  for (int i = 0; i < FIELD_HEIGHT && fieldIsFull; ++i) {
-    for (int j = 0; j < FIELD_WIDTH && fieldIsFull; ++j) {
+  for (int i = 0; i < board.height() && fieldIsFull; ++i) {
+    for (int j = 0; j < board.width() && fieldIsFull; ++j) {
       if (gameInfo.field[i][j] == 0) {
         fieldIsFull = false;
       }
@@ -18,11 +23,13 @@ static bool checkWin(GameInfo_t& gameInfo) {
   return fieldIsFull;
 }
 
-static bool checkCollision(int x, int y, GameInfo_t& gameInfo) {
+template <class Board>
+static bool checkCollision(const Board& board, int x, int y,
+                           GameInfo_t& gameInfo) {
   bool collision = false;
 
   // check bounds field
-  if (x < 0 || x >= FIELD_WIDTH || y < 0 || y >= FIELD_HEIGHT) {
+  if (x < 0 || x >= board.width() || y < 0 || y >= board.height()) {
     collision = true;
   }
 
@@ -40,7 +47,9 @@ struct CellSnake {
   int* cell;
 };
 
-static CellSnake getNextBody(CellSnake& cellSnake, GameInfo_t& gameInfo) {
+template <class Board>
+static CellSnake getNextBody(const Board& board, CellSnake& cellSnake,
+                             GameInfo_t& gameInfo) {
   CellSnake nextBody = {-1, -1, nullptr};
 
   int targetIndex;
@@ -60,7 +69,8 @@ static CellSnake getNextBody(CellSnake& cellSnake, GameInfo_t& gameInfo) {
     int newX = cellSnake.x + dx[i];
     int newY = cellSnake.y + dy[i];
 
-    if (newX >= 0 && newX < FIELD_WIDTH && newY >= 0 && newY < FIELD_HEIGHT) {
+    if (newX >= 0 && newX < board.width() && newY >= 0 &&
+        newY < board.height()) {
       if (gameInfo.field[newY][newX] == targetIndex) {
         nextBody.x = newX;
         nextBody.y = newY;
@@ -73,10 +83,11 @@ static CellSnake getNextBody(CellSnake& cellSnake, GameInfo_t& gameInfo) {
   return nextBody;
 }
 
-static CellSnake getSnakeHead(GameInfo_t& gameInfo) {
+template <class Board>
+static CellSnake getSnakeHead(const Board& board, GameInfo_t& gameInfo) {
   int headX = -1, headY = -1;
-  for (int y = 0; y < FIELD_HEIGHT && headY == -1; y++) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
+  for (int y = 0; y < board.height() && headY == -1; y++) {
+    for (int x = 0; x < board.width(); x++) {
       if (gameInfo.field[y][x] >= static_cast<int>(HEAD_LEFT) &&
           gameInfo.field[y][x] <= static_cast<int>(HEAD_DOWN)) {
         headX = x;
@@ -88,9 +99,67 @@ static CellSnake getSnakeHead(GameInfo_t& gameInfo) {
   return {headX, headY, &gameInfo.field[headY][headX]};
 }
 
-static void setDirection(GameInfo_t& gameInfo, SnakeLogic::Direct& direct) {
-  CellSnake snakeHead = getSnakeHead(gameInfo);
+// direction from cell to neighbour, as index of Direct
+static int linkDirect(int x, int y, int toX, int toY) {
+  int direct = static_cast<int>(DOWN);
+  if (toX < x) {
+    direct = static_cast<int>(LEFT);
+  } else if (toX > x) {
+    direct = static_cast<int>(RIGHT);
+  } else if (toY < y) {
+    direct = static_cast<int>(UP);
+  }
+  return direct;
+}
+
+template <class Board>
+static uint64_t cellKey(const Board& board, int kind, int x, int y) {
+  return GameLogic::hashKey(kind, y * board.width() + x);
+}
+
+// full hash, body part is keyed by direction to previous part,
+// so values of body shifted by move do not change it
+template <class Board>
+static uint64_t snakeHash(const Board& board, GameInfo_t& gameInfo) {
+  const int dx[] = {-1, 1, 0, 0};
+  const int dy[] = {0, 0, -1, 1};
+  const int head = static_cast<int>(HEAD_LEFT);
+  const int firstBody = static_cast<int>(HEAD_DOWN) + 1;
+  uint64_t hash = 0;
+
+  for (int y = 0; y < board.height(); y++) {
+    for (int x = 0; x < board.width(); x++) {
+      int value = gameInfo.field[y][x];
+      if (value == static_cast<int>(FOOD)) {
+        hash ^= cellKey(board, HASH_FOOD, x, y);
+      } else if (value >= head && value < firstBody) {
+        hash ^= cellKey(board, HASH_HEAD + value - head, x, y);
+      }
+      for (int i = 0; i < 4 && value >= firstBody; i++) {
+        int prevX = x + dx[i];
+        int prevY = y + dy[i];
+        if (prevX < 0 || prevX >= board.width() || prevY < 0 ||
+            prevY >= board.height()) {
+          continue;
+        }
+        int prev = gameInfo.field[prevY][prevX];
+        if (prev == value - 1 || (value == firstBody && prev >= head &&
+                                  prev < firstBody)) {
+          hash ^= cellKey(board, HASH_LINK + i, x, y);
+          break;
+        }
+      }
+    }
+  }
+  return hash;
+}
+
+// head turns unless it is turned back to body
+template <class Board>
+static void turnHead(const Board& board, CellSnake snakeHead,
+                     SnakeLogic::Direct& direct, uint64_t& hash) {
   if (snakeHead.x != -1 && snakeHead.y != -1) {
+    int oldHead = *snakeHead.cell;
     SnakeLogic::Field head = static_cast<SnakeLogic::Field>(*snakeHead.cell);
     if (direct == LEFT && head != HEAD_RIGHT) {
       *snakeHead.cell = static_cast<int>(HEAD_LEFT);
@@ -103,24 +172,52 @@ static void setDirection(GameInfo_t& gameInfo, SnakeLogic::Direct& direct) {
     } else {
       direct = NONE;
     }
+    if (*snakeHead.cell != oldHead) {
+      int kind = HASH_HEAD - static_cast<int>(HEAD_LEFT);
+      hash ^=
+          cellKey(board, kind + oldHead, snakeHead.x, snakeHead.y) ^
+          cellKey(board, kind + *snakeHead.cell, snakeHead.x, snakeHead.y);
+    }
   }
 }
 
-static void spawnFood(GameInfo_t& gameInfo) {
+template <class Board>
+static void spawnFood(const Board& board, GameInfo_t& gameInfo,
+                      RandomGenerator& random, uint64_t& hash) {
+  // snake fills whole field, nowhere to put food
+  if (checkWin(board, gameInfo)) return;
+
   int x, y;
   do {
-    x = rand() % FIELD_WIDTH;
-    y = rand() % FIELD_HEIGHT;
+    x = random.next(board.width());
+    y = random.next(board.height());
   } while (gameInfo.field[y][x] != 0);
 
   gameInfo.field[y][x] = static_cast<int>(FOOD);
+  hash ^= cellKey(board, HASH_FOOD, x, y);
+}
+
+static void scoreFood(GameInfo_t& gameInfo) {
+  gameInfo.score += 1;
+
+  while (gameInfo.level < 10 && gameInfo.score >= gameInfo.level * 5) {
+    gameInfo.level++;
+    gameInfo.speed++;
+  }
+
+  // high score is stored by step of snake
+  if (gameInfo.score > gameInfo.high_score) {
+    gameInfo.high_score = gameInfo.score;
+  }
 }
 
-static void eatFood(GameInfo_t& gameInfo) {
+template <class Board>
+static void eatFood(const Board& board, GameInfo_t& gameInfo,
+                    RandomGenerator& random, uint64_t& hash) {
   // search food
   int* cellFood = nullptr;
-  for (int y = 0; y < FIELD_HEIGHT && cellFood == nullptr; y++) {
-    for (int x = 0; x < FIELD_WIDTH; x++) {
+  for (int y = 0; y < board.height() && cellFood == nullptr; y++) {
+    for (int x = 0; x < board.width(); x++) {
       if (gameInfo.field[y][x] == static_cast<int>(FOOD)) {
         cellFood = &gameInfo.field[y][x];
         break;
@@ -129,14 +226,14 @@ static void eatFood(GameInfo_t& gameInfo) {
   }
 
   if (cellFood != nullptr) {
-    CellSnake head = getSnakeHead(gameInfo);
+    CellSnake head = getSnakeHead(board, gameInfo);
 
     // cell with food now is snake head
     *cellFood = *head.cell;
 
     // increase index of all body parts snake
-    for (int y = 0; y < FIELD_HEIGHT; y++) {
-      for (int x = 0; x < FIELD_WIDTH; x++) {
+    for (int y = 0; y < board.height(); y++) {
+      for (int x = 0; x < board.width(); x++) {
         if (gameInfo.field[y][x] > static_cast<int>(HEAD_DOWN)) {
           gameInfo.field[y][x]++;
         }
@@ -147,24 +244,15 @@ static void eatFood(GameInfo_t& gameInfo) {
     gameInfo.field[head.y][head.x] = static_cast<int>(HEAD_DOWN) + 1;
   }
 
-  gameInfo.score += 1;
-
-  while (gameInfo.level < 10 && gameInfo.score >= gameInfo.level * 5) {
-    gameInfo.level++;
-    gameInfo.speed++;
-  }
-
-  if (gameInfo.score > gameInfo.high_score) {
-    gameInfo.high_score = gameInfo.score;
-    GameLogic::saveHighScore(gameInfo.high_score, DB_ID);
-  }
-
-  spawnFood(gameInfo);
+  scoreFood(gameInfo);
+  spawnFood(board, gameInfo, random, hash);
 }
 
-static bool moveSnake(GameInfo_t& gameInfo) {
+template <class Board>
+static bool moveSnake(const Board& board, GameInfo_t& gameInfo,
+                      RandomGenerator& random, uint64_t& hash) {
   bool collision = false;
-  CellSnake head = getSnakeHead(gameInfo);
+  CellSnake head = getSnakeHead(board, gameInfo);
 
   int newX = head.x, newY = head.y;
   SnakeLogic::Field headField = static_cast<SnakeLogic::Field>(*head.cell);
@@ -177,27 +265,40 @@ static bool moveSnake(GameInfo_t& gameInfo) {
   } else if (headField == HEAD_DOWN) {
     newY++;
   }
-  collision = checkCollision(newX, newY, gameInfo);
+  collision = checkCollision(board, newX, newY, gameInfo);
 
   if (!collision) {
+    // old head becomes body linked to new head
+    int direct = *head.cell - static_cast<int>(HEAD_LEFT);
+    hash ^= cellKey(board, HASH_HEAD + direct, head.x, head.y) ^
+            cellKey(board, HASH_LINK + direct, head.x, head.y) ^
+            cellKey(board, HASH_HEAD + direct, newX, newY);
+
     if (gameInfo.field[newY][newX] == static_cast<int>(FOOD)) {
-      eatFood(gameInfo);
+      hash ^= cellKey(board, HASH_FOOD, newX, newY);
+      eatFood(board, gameInfo, random, hash);
     } else {
       gameInfo.field[newY][newX] = *head.cell;
 
+      CellSnake prevCell = head;
       CellSnake currentCell = head;
       while (true) {
-        CellSnake nextCell = getNextBody(currentCell, gameInfo);
+        CellSnake nextCell = getNextBody(board, currentCell, gameInfo);
         if (nextCell.cell == nullptr || nextCell.x == -1 || nextCell.y == -1) {
           break;  // end of snake
         }
         *currentCell.cell = *nextCell.cell;
+        prevCell = currentCell;
         currentCell = nextCell;
       }
 
       //  delete last part body of snake
       if (*currentCell.cell > static_cast<int>(HEAD_DOWN)) {
         *currentCell.cell = 0;
+        direct = linkDirect(currentCell.x, currentCell.y, prevCell.x,
+                            prevCell.y);
+        hash ^=
+            cellKey(board, HASH_LINK + direct, currentCell.x, currentCell.y);
       }
     }
   }
@@ -205,63 +306,270 @@ static bool moveSnake(GameInfo_t& gameInfo) {
   return collision;
 }
 
-static void spawnSnake(GameInfo_t& gameInfo) {
-  const int startSize = 4;
-  SnakeLogic::Direct direction = static_cast<SnakeLogic::Direct>(rand() % 4);
-
-  int startX = rand() % FIELD_WIDTH;
-  int startY = rand() % FIELD_HEIGHT;
+// parts of new snake from head are written to parts
+template <class Board>
+static void spawnSnake(const Board& board, GameInfo_t& gameInfo,
+                       RandomGenerator& random, uint64_t& hash,
+                       CellSnake (&parts)[START_SIZE]) {
+  const int startSize = START_SIZE;
+  SnakeLogic::Direct direction =
+      static_cast<SnakeLogic::Direct>(random.next(4));
+
+  int startX = random.next(board.width());
+  int startY = random.next(board.height());
   if (direction == LEFT) {
-    startX = rand() % (FIELD_WIDTH - 4);
+    startX = random.next(board.width() - 4);
   } else if (direction == RIGHT) {
-    startX = rand() % (FIELD_WIDTH - 4) + 3;
+    startX = random.next(board.width() - 4) + 3;
   } else if (direction == UP) {
-    startY = rand() % (FIELD_HEIGHT - 4);
+    startY = random.next(board.height() - 4);
   } else if (direction == DOWN) {
-    startY = rand() % (FIELD_HEIGHT - 4) + 3;
+    startY = random.next(board.height() - 4) + 3;
   }
 
   int headValue = static_cast<int>(HEAD_LEFT);
   for (int i = 0; i < startSize; i++) {
+    int x = startX;
+    int y = startY;
     if (direction == LEFT) {
-      gameInfo.field[startY][startX + i] = (i == 0) ? headValue : i + 5;
+      x += i;
     } else if (direction == RIGHT) {
-      gameInfo.field[startY][startX - i] = (i == 0) ? headValue : i + 5;
+      x -= i;
     } else if (direction == UP) {
-      gameInfo.field[startY + i][startX] = (i == 0) ? headValue : i + 5;
+      y += i;
     } else if (direction == DOWN) {
-      gameInfo.field[startY - i][startX] = (i == 0) ? headValue : i + 5;
+      y -= i;
     }
+    gameInfo.field[y][x] = (i == 0) ? headValue : i + 5;
+    parts[i] = {x, y, &gameInfo.field[y][x]};
   }
 
-  setDirection(gameInfo, direction);
+  turnHead(board, parts[0], direction, hash);
+}
+
+//
+// ============================================================================
+// Functions for large board
+// ============================================================================
+
+// On board other than classic snake is kept in SnakeTrack, so move, food
+// and win take the same time on any board and for any length. Body cells
+// of such board are not numbered, all of them are BODY_CELL.
+
+static int trackCell(const SnakeTrack& track, size_t part) {
+  return track.body[(track.head + part) % track.body.size()];
+}
+
+static void takeCell(SnakeTrack& track, int cell) {
+  int index = track.freeIndex[cell];
+  int last = track.freeCells.back();
+  track.freeCells[index] = last;
+  track.freeIndex[last] = index;
+  track.freeCells.pop_back();
+}
+
+static void releaseCell(SnakeTrack& track, int cell) {
+  track.freeIndex[cell] = static_cast<int>(track.freeCells.size());
+  track.freeCells.push_back(cell);
+}
+
+static CellSnake trackHead(const DynamicBoard& board, const SnakeTrack& track,
+                           GameInfo_t& gameInfo) {
+  int cell = trackCell(track, 0);
+  int x = cell % board.width();
+  int y = cell / board.width();
+  return {x, y, &gameInfo.field[y][x]};
+}
+
+static void spawnTrackedFood(const DynamicBoard& board, SnakeTrack& track,
+                             GameInfo_t& gameInfo, RandomGenerator& random,
+                             uint64_t& hash) {
+  if (track.freeCells.empty()) return;
+  int size = static_cast<int>(track.freeCells.size());
+  int cell = track.freeCells[random.next(size)];
+  takeCell(track, cell);
+  int x = cell % board.width();
+  int y = cell / board.width();
+  gameInfo.field[y][x] = static_cast<int>(FOOD);
+  hash ^= cellKey(board, HASH_FOOD, x, y);
 }
 
-static void initGame(GameInfo_t& gameInfo) {
-  for (int i = 0; i < FIELD_HEIGHT; i++) {
-    for (int j = 0; j < FIELD_WIDTH; j++) {
+// all cells are free, then new snake takes its cells; buffers are sized
+// by first game
+static void startTrack(const DynamicBoard& board, SnakeTrack& track,
+                       const CellSnake (&parts)[START_SIZE]) {
+  int cells = board.width() * board.height();
+  track.body.resize(cells);
+  track.freeIndex.resize(cells);
+  track.freeCells.resize(cells);
+  for (int cell = 0; cell < cells; cell++) {
+    track.freeCells[cell] = cell;
+    track.freeIndex[cell] = cell;
+  }
+
+  track.head = 0;
+  track.length = START_SIZE;
+  for (int i = 0; i < START_SIZE; i++) {
+    int cell = parts[i].y * board.width() + parts[i].x;
+    track.body[i] = cell;
+    takeCell(track, cell);
+    if (i > 0) {
+      *parts[i].cell = BODY_CELL;
+    }
+  }
+}
+
+static uint64_t trackHash(const DynamicBoard& board, const SnakeTrack& track,
+                          GameInfo_t& gameInfo) {
+  CellSnake head = trackHead(board, track, gameInfo);
+  int direct = *head.cell - static_cast<int>(HEAD_LEFT);
+  uint64_t hash = cellKey(board, HASH_HEAD + direct, head.x, head.y);
+  for (size_t i = 1; i < track.length; i++) {
+    int cell = trackCell(track, i);
+    int prev = trackCell(track, i - 1);
+    int x = cell % board.width();
+    int y = cell / board.width();
+    direct = linkDirect(x, y, prev % board.width(), prev / board.width());
+    hash ^= cellKey(board, HASH_LINK + direct, x, y);
+  }
+  return hash;
+}
+
+// the same move as moveSnake: new head is added to ring, tail is taken
+// from it unless food is eaten
+static bool moveTracked(const DynamicBoard& board, SnakeTrack& track,
+                        GameInfo_t& gameInfo, RandomGenerator& random,
+                        uint64_t& hash) {
+  const int dx[] = {-1, 1, 0, 0};
+  const int dy[] = {0, 0, -1, 1};
+  CellSnake head = trackHead(board, track, gameInfo);
+  int direct = *head.cell - static_cast<int>(HEAD_LEFT);
+  int newX = head.x + dx[direct];
+  int newY = head.y + dy[direct];
+  bool collision = checkCollision(board, newX, newY, gameInfo);
+
+  if (!collision) {
+    hash ^= cellKey(board, HASH_HEAD + direct, head.x, head.y) ^
+            cellKey(board, HASH_LINK + direct, head.x, head.y) ^
+            cellKey(board, HASH_HEAD + direct, newX, newY);
+
+    int& newHead = gameInfo.field[newY][newX];
+    bool isFood = newHead == static_cast<int>(FOOD);
+    newHead = *head.cell;
+    *head.cell = BODY_CELL;
+    int newCell = newY * board.width() + newX;
+    track.head = (track.head + track.body.size() - 1) % track.body.size();
+    track.body[track.head] = newCell;
+    track.length++;
+
+    if (isFood) {
+      hash ^= cellKey(board, HASH_FOOD, newX, newY);
+      scoreFood(gameInfo);
+      spawnTrackedFood(board, track, gameInfo, random, hash);
+    } else {
+      takeCell(track, newCell);
+      int tail = trackCell(track, track.length - 1);
+      int prev = trackCell(track, track.length - 2);
+      int tailX = tail % board.width();
+      int tailY = tail / board.width();
+      gameInfo.field[tailY][tailX] = 0;
+      releaseCell(track, tail);
+      track.length--;
+      direct = linkDirect(tailX, tailY, prev % board.width(),
+                          prev / board.width());
+      hash ^= cellKey(board, HASH_LINK + direct, tailX, tailY);
+    }
+  }
+
+  return collision;
+}
+
+//
+// ============================================================================
+// End functions for large board
+// ============================================================================
+
+template <class Board>
+static void initGame(const Board& board, SnakeTrack& track,
+                     GameInfo_t& gameInfo, RandomGenerator& random,
+                     uint64_t& hash, bool savesHighScore) {
+  for (int i = 0; i < board.height(); i++) {
+    for (int j = 0; j < board.width(); j++) {
       gameInfo.field[i][j] = 0;
     }
   }
 
-  gameInfo.high_score = GameLogic::loadHighScore(DB_ID);
+  if (savesHighScore) {
+    gameInfo.high_score = GameLogic::loadHighScore(DB_ID);
+  }
   gameInfo.score = 0;
   gameInfo.level = 1;
   gameInfo.speed = 1;
   gameInfo.pause = 0;
 
-  spawnSnake(gameInfo);
-  spawnFood(gameInfo);
+  CellSnake parts[START_SIZE];
+  spawnSnake(board, gameInfo, random, hash, parts);
+  if constexpr (std::is_same_v<Board, DynamicBoard>) {
+    startTrack(board, track, parts);
+    hash = trackHash(board, track, gameInfo);
+    spawnTrackedFood(board, track, gameInfo, random, hash);
+  } else {
+    hash = snakeHash(board, gameInfo);
+    spawnFood(board, gameInfo, random, hash);
+  }
 }
 
+template <class Board>
 struct ActionParams {
+  const Board& board;
   UserAction_t action;
   bool hold;
   GameStatus& gameStatus;
   GameInfo_t& gameInfo;
+  RandomGenerator& random;
+  uint64_t& hash;
+  SnakeTrack& track;
+  bool savesHighScore;
 };
 
-static bool movingAction(ActionParams& AP) {
+template <class Board>
+static CellSnake snakeHead(ActionParams<Board>& AP) {
+  if constexpr (std::is_same_v<Board, DynamicBoard>) {
+    return trackHead(AP.board, AP.track, AP.gameInfo);
+  } else {
+    return getSnakeHead(AP.board, AP.gameInfo);
+  }
+}
+
+// one move of snake and its end of game
+template <class Board>
+static void stepSnake(ActionParams<Board>& AP) {
+  bool collision = false;
+  bool isWin = false;
+  int highScore = AP.gameInfo.high_score;
+  if constexpr (std::is_same_v<Board, DynamicBoard>) {
+    collision = moveTracked(AP.board, AP.track, AP.gameInfo, AP.random,
+                            AP.hash);
+    isWin = !collision && AP.track.freeCells.empty();
+  } else {
+    collision = moveSnake(AP.board, AP.gameInfo, AP.random, AP.hash);
+    isWin = !collision && checkWin(AP.board, AP.gameInfo);
+  }
+
+  if (collision) {
+    AP.gameStatus = GameStatus::GAME_OVER;
+    AP.gameInfo.pause = 1;
+  } else if (isWin) {
+    AP.gameStatus = GameStatus::WIN;
+    AP.gameInfo.pause = 1;
+  }
+  if (AP.savesHighScore && AP.gameInfo.high_score > highScore) {
+    GameLogic::saveHighScore(AP.gameInfo.high_score, DB_ID);
+  }
+}
+
+template <class Board>
+static bool movingAction(ActionParams<Board>& AP) {
   bool isMovingSnake = false;
   SnakeLogic::Direct direct = NONE;
   if (AP.action == UserAction_t::Left) {
@@ -275,24 +583,19 @@ static bool movingAction(ActionParams& AP) {
   }
 
   if (direct != NONE) {
-    setDirection(AP.gameInfo, direct);
+    turnHead(AP.board, snakeHead(AP), direct, AP.hash);
   }
 
   if (direct != NONE || AP.action == UserAction_t::Action) {
-    if (moveSnake(AP.gameInfo)) {
-      AP.gameStatus = GameStatus::GAME_OVER;
-      AP.gameInfo.pause = 1;
-    } else if (checkWin(AP.gameInfo)) {
-      AP.gameStatus = GameStatus::WIN;
-      AP.gameInfo.pause = 1;
-    }
+    stepSnake(AP);
     isMovingSnake = true;
   }
 
   return isMovingSnake;
 }
 
-static bool gameAction(ActionParams& AP) {
+template <class Board>
+static bool gameAction(ActionParams<Board>& AP) {
   bool isMovingSnake = false;
   using UA = UserAction_t;
   if (AP.hold && (AP.action == UA::Pause || AP.action == UA::Terminate)) {
@@ -312,16 +615,19 @@ static bool gameAction(ActionParams& AP) {
   return isMovingSnake;
 }
 
-static void gameOverAction(ActionParams& AP) {
+template <class Board>
+static void gameOverAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Start) {
-    initGame(AP.gameInfo);
+    initGame(AP.board, AP.track, AP.gameInfo, AP.random, AP.hash,
+             AP.savesHighScore);
     AP.gameStatus = GameStatus::GAME;
   } else if (AP.action == UserAction_t::Terminate) {
     AP.gameStatus = GameStatus::INIT;
   }
 }
 
-static void pauseAction(ActionParams& AP) {
+template <class Board>
+static void pauseAction(ActionParams<Board>& AP) {
   switch (AP.action) {
     case UserAction_t::Pause:
     case UserAction_t::Start:
@@ -334,75 +640,103 @@ static void pauseAction(ActionParams& AP) {
   }
 }
 
-static void instructionAction(ActionParams& AP) {
+template <class Board>
+static void instructionAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Terminate) {
     AP.gameStatus = GameStatus::INIT;
   } else if (AP.action == UserAction_t::Start) {
-    initGame(AP.gameInfo);
+    initGame(AP.board, AP.track, AP.gameInfo, AP.random, AP.hash,
+             AP.savesHighScore);
     AP.gameStatus = GameStatus::GAME;
   }
 }
 
-static void initAction(ActionParams& AP) {
+template <class Board>
+static void initAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Up) {
     AP.gameStatus = GameStatus::INSTRUCTION;
   } else if (AP.action == UserAction_t::Start) {
-    initGame(AP.gameInfo);
+    initGame(AP.board, AP.track, AP.gameInfo, AP.random, AP.hash,
+             AP.savesHighScore);
     AP.gameStatus = GameStatus::GAME;
   }
 }
 
-void SnakeLogic::userInput(UserAction_t action, bool hold) {
-  std::lock_guard<std::mutex> lock(gameTickMutex);
-  ActionParams actionParams = {action, hold, currentGameStatus, gameInfo};
-
-  switch (currentGameStatus) {
+template <class Board>
+static bool applyInput(ActionParams<Board>& AP) {
+  bool isMovingSnake = false;
+  switch (AP.gameStatus) {
     case GameStatus::INIT:
-      initAction(actionParams);
+      initAction(AP);
       break;
     case GameStatus::INSTRUCTION:
-      instructionAction(actionParams);
+      instructionAction(AP);
       break;
     case GameStatus::PAUSE:
-      pauseAction(actionParams);
+      pauseAction(AP);
       break;
     case GameStatus::GAME_OVER:
-      gameOverAction(actionParams);
+      gameOverAction(AP);
       break;
     case GameStatus::WIN:
-      gameOverAction(actionParams);
+      gameOverAction(AP);
       break;
     case GameStatus::GAME:
-      if (gameAction(actionParams)) {
-        lastTickTime = std::chrono::high_resolution_clock::now();
-      }
+      isMovingSnake = gameAction(AP);
       break;
   }
+  return isMovingSnake;
+}
+
+void SnakeLogic::userInput(UserAction_t action, bool hold) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  bool isMovingSnake = withBoard([&](const auto& board) {
+    ActionParams<std::decay_t<decltype(board)>> actionParams = {
+        board,    action,          hold, currentGameStatus,
+        gameInfo, randomGenerator, hash, track,
+        savesHighScore};
+    return applyInput(actionParams);
+  });
+
+  if (isMovingSnake) {
+    markTick();
+  }
 }
 
 GameInfo_t SnakeLogic::updateCurrentState() { return gameInfo; }
 
+void SnakeLogic::getFocus(int& x, int& y) const {
+  x = 0;
+  y = 0;
+  if (track.length > 0) {
+    int cell = track.body[track.head];
+    x = cell % gameInfo.width;
+    y = cell / gameInfo.width;
+  }
+}
+
 void SnakeLogic::gameTick() {
   std::lock_guard<std::mutex> lock(gameTickMutex);
 
   if (currentGameStatus == GameStatus::GAME && !gameInfo.pause) {
-    if (moveSnake(gameInfo)) {
-      currentGameStatus = GameStatus::GAME_OVER;
-      gameInfo.pause = 1;
-    } else if (checkWin(gameInfo)) {
-      currentGameStatus = GameStatus::WIN;
-      gameInfo.pause = 1;
-    }
+    withBoard([&](const auto& board) {
+      ActionParams<std::decay_t<decltype(board)>> actionParams = {
+          board,    UserAction_t::Action, false, currentGameStatus,
+          gameInfo, randomGenerator,      hash,  track,
+          savesHighScore};
+      stepSnake(actionParams);
+    });
   }
 
-  lastTickTime = std::chrono::high_resolution_clock::now();
+  markTick();
 }
 
-SnakeLogic::SnakeLogic() {
-  srand(time(nullptr));
-  gameInfo.field = new int*[FIELD_HEIGHT];
-  for (int i = 0; i < FIELD_HEIGHT; i++) {
-    gameInfo.field[i] = new int[FIELD_WIDTH]();
+SnakeLogic::SnakeLogic(int width, int height) {
+  gameInfo.width = std::max(width, MIN_FIELD_SIZE);
+  gameInfo.height = std::max(height, MIN_FIELD_SIZE);
+  gameInfo.field = new int*[gameInfo.height];
+  for (int i = 0; i < gameInfo.height; i++) {
+    gameInfo.field[i] = new int[gameInfo.width]();
   }
   gameInfo.score = 0;
   gameInfo.high_score = 0;
@@ -413,10 +747,27 @@ SnakeLogic::SnakeLogic() {
 
 SnakeLogic::~SnakeLogic() {
   if (gameInfo.field != nullptr) {
-    for (int i = 0; i < FIELD_HEIGHT; i++) {
+    for (int i = 0; i < gameInfo.height; i++) {
       delete[] gameInfo.field[i];
     }
     delete[] gameInfo.field;
     gameInfo.field = nullptr;
   }
-}
\ No newline at end of file
+}
+
+void SnakeLogic::saveState(GameState_t& state) const {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  // body order and direction are stored in field values
+  saveCommonState(state, GameType::SNAKE);
+  state.current = {};
+  state.next = {};
+}
+
+bool SnakeLogic::loadState(const GameState_t& state) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  bool isLoaded = loadCommonState(state, GameType::SNAKE);
+  if (isLoaded) {
+    hash = snakeHash(ClassicBoard{}, gameInfo);
+  }
+  return isLoaded;
+}
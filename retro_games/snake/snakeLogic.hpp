@@ -5,16 +5,33 @@
 
 namespace s21 {
 
+// snake on board other than classic, so moves do not scan field
+struct SnakeTrack {
+  std::vector<int> body;       // ring buffer of cells y * width + x
+  size_t head = 0;             // index of head in body
+  size_t length = 0;
+  std::vector<int> freeCells;  // cells without snake and food
+  std::vector<int> freeIndex;  // position of free cell in freeCells
+};
+
 class SnakeLogic : public GameLogic {
  public:
   enum class Field { EMPTY, FOOD, HEAD_LEFT, HEAD_RIGHT, HEAD_UP, HEAD_DOWN };
   enum class Direct { LEFT, RIGHT, UP, DOWN, NONE };
 
-  SnakeLogic();
+  // board is at least MIN_FIELD_SIZE in each direction
+  explicit SnakeLogic(int width = FIELD_WIDTH, int height = FIELD_HEIGHT);
   ~SnakeLogic();
   void userInput(UserAction_t action, bool hold) override;
   GameInfo_t updateCurrentState() override;
   void gameTick() override;
+  void saveState(GameState_t& state) const override;
+  bool loadState(const GameState_t& state) override;
+  // head of snake on large board
+  void getFocus(int& x, int& y) const override;
+
+ protected:
+  SnakeTrack track;
 };
 }  // namespace s21
 
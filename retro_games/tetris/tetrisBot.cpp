@@ -0,0 +1,336 @@
+#include "tetrisBot.hpp"
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+using namespace s21;
+
+using Board = TetrisBot::Board;
+using Piece = TetrisBot::Piece;
+
+#define FULL_ROW ((1 << FIELD_WIDTH) - 1)
+#define NO_SCORE (-std::numeric_limits<double>::infinity())
+
+static bool sameGrid(const Piece& a, const Piece& b) {
+  return a.width == b.width && a.height == b.height &&
+         memcmp(a.grid, b.grid, sizeof(a.grid)) == 0;
+}
+
+// same rule as rotation of shape in engine
+static Piece rotatePiece(const Piece& piece) {
+  GameState_t::Shape_t shape = {};
+  for (int i = 0; i < piece.height; i++) {
+    for (int j = 0; j < piece.width; j++) {
+      shape.grid[j][piece.height - 1 - i] = piece.grid[i][j];
+    }
+  }
+  shape.width = static_cast<int8_t>(piece.height);
+  shape.height = static_cast<int8_t>(piece.width);
+  return TetrisBot::makePiece(shape);
+}
+
+static bool fits(const Board& board, const Piece& piece, int x, int y) {
+  bool isFit = y < FIELD_HEIGHT;
+  for (int i = 0; i < piece.height && isFit; i++) {
+    int row = y - (piece.height - 1 - i);
+    isFit = row < 0 || (board[row] & (piece.rows[i] << x)) == 0;
+  }
+  return isFit;
+}
+
+// drops piece in column x, false if piece ends the game
+static bool dropPiece(const Board& board, const Piece& piece, int x,
+                      Board& result, int& lines) {
+  int y = 0;  // bottom row of piece, as y of shape in engine
+  if (!fits(board, piece, x, y)) return false;
+  while (fits(board, piece, x, y + 1)) {
+    y++;
+  }
+  if (y - piece.height < 0) return false;
+
+  memcpy(result, board, sizeof(Board));
+  for (int i = 0; i < piece.height; i++) {
+    result[y - (piece.height - 1 - i)] |= piece.rows[i] << x;
+  }
+
+  lines = 0;
+  int to = FIELD_HEIGHT - 1;
+  for (int from = FIELD_HEIGHT - 1; from >= 0; from--) {
+    if (result[from] == FULL_ROW) {
+      lines++;
+    } else {
+      result[to--] = result[from];
+    }
+  }
+  while (to >= 0) {
+    result[to--] = 0;
+  }
+  return true;
+}
+
+Piece TetrisBot::makePiece(const GameState_t::Shape_t& shape) {
+  Piece piece = {};
+  memcpy(piece.grid, shape.grid, sizeof(piece.grid));
+  piece.width = shape.width;
+  piece.height = shape.height;
+  for (int i = 0; i < piece.height; i++) {
+    for (int j = 0; j < piece.width; j++) {
+      if (piece.grid[i][j]) {
+        piece.rows[i] |= 1 << j;
+      }
+    }
+  }
+  return piece;
+}
+
+int TetrisBot::getRotations(const Piece& piece, Piece rotations[4]) {
+  int count = 0;
+  Piece rotated = piece;
+  for (int i = 0; i < 4; i++) {
+    bool isNew = true;
+    for (int j = 0; j < count && isNew; j++) {
+      isNew = !sameGrid(rotations[j], rotated);
+    }
+    if (isNew) {
+      rotations[count++] = rotated;
+    }
+    rotated = rotatePiece(rotated);
+  }
+  return count;
+}
+
+double TetrisBot::evaluate(const Board& board, int lines) const {
+  int heights[FIELD_WIDTH] = {};
+  int holes = 0;
+  uint16_t covered = 0;
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    // empty cells under filled ones, whole row at once
+    holes += std::popcount<uint16_t>(covered & ~board[y] & FULL_ROW);
+    uint16_t tops = board[y] & ~covered;
+    for (int x = 0; tops; x++, tops >>= 1) {
+      if (tops & 1) heights[x] = FIELD_HEIGHT - y;
+    }
+    covered |= board[y];
+  }
+
+  int height = 0;
+  int bumpiness = 0;
+  for (int x = 0; x < FIELD_WIDTH; x++) {
+    height += heights[x];
+    if (x > 0) bumpiness += std::abs(heights[x] - heights[x - 1]);
+  }
+
+  return weights.height * height + weights.lines * lines +
+         weights.holes * holes + weights.bumpiness * bumpiness;
+}
+
+//
+// ============================================================================
+// Parallel search
+// ============================================================================
+
+TetrisBot::TetrisBot(int threads, TetrisWeights weights) : weights(weights) {
+  if (threads <= 0) {
+    threads = std::min(4u, std::max(1u, std::thread::hardware_concurrency()));
+  }
+  // calling thread is one of workers
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(&TetrisBot::workerLoop, this);
+  }
+}
+
+TetrisBot::~TetrisBot() {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    stopping = true;
+  }
+  poolWakeUp.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void TetrisBot::workerLoop() {
+  uint64_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(poolMutex);
+  while (true) {
+    poolWakeUp.wait(lock, [&]() {
+      return stopping || generation != seenGeneration;
+    });
+    if (stopping) break;
+    seenGeneration = generation;
+
+    lock.unlock();
+    scoreCandidates();
+    lock.lock();
+    if (--busyWorkers == 0) {
+      poolDone.notify_one();
+    }
+  }
+}
+
+// takes candidates one by one, so fast workers take more of them
+void TetrisBot::scoreCandidates() {
+  const int count = static_cast<int>(candidates.size());
+  for (int i = nextCandidate++; i < count; i = nextCandidate++) {
+    Candidate& candidate = candidates[i];
+    double best = NO_SCORE;
+    Board board;
+    int lines = 0;
+    for (int r = 0; r < nextRotationsCount; r++) {
+      const Piece& piece = nextRotations[r];
+      for (int x = 0; x + piece.width <= FIELD_WIDTH; x++) {
+        if (dropPiece(candidate.board, piece, x, board, lines)) {
+          best = std::max(best, evaluate(board, candidate.lines + lines));
+        }
+      }
+    }
+    // next piece does not fit, game ends after it
+    if (best == NO_SCORE) {
+      best = evaluate(candidate.board, candidate.lines) - 1000;
+    }
+    candidate.placement.score = best;
+  }
+}
+
+TetrisBot::Placement TetrisBot::findPlacement(const Board& board,
+                                              const Piece& current,
+                                              const Piece& next) {
+  Piece rotations[4];
+  int rotationsCount = getRotations(current, rotations);
+  nextRotationsCount = getRotations(next, nextRotations);
+
+  candidates.clear();
+  for (int r = 0; r < rotationsCount; r++) {
+    for (int x = 0; x + rotations[r].width <= FIELD_WIDTH; x++) {
+      Candidate candidate;
+      candidate.placement = {rotations[r], x, NO_SCORE};
+      if (dropPiece(board, rotations[r], x, candidate.board, candidate.lines)) {
+        candidates.push_back(candidate);
+      }
+    }
+  }
+
+  nextCandidate = 0;
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    generation++;
+    busyWorkers = static_cast<int>(workers.size());
+  }
+  poolWakeUp.notify_all();
+  scoreCandidates();
+  {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    poolDone.wait(lock, [this]() { return busyWorkers == 0; });
+  }
+
+  // every placement ends the game, keep piece as it is
+  Placement best = {current, 0, NO_SCORE};
+  for (const Candidate& candidate : candidates) {
+    if (candidate.placement.score > best.score) {
+      best = candidate.placement;
+    }
+  }
+  return best;
+}
+
+//
+// ============================================================================
+// Moving piece to placement
+// ============================================================================
+
+static void getBoard(const GameState_t& state, Board& board) {
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    board[y] = 0;
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      if (state.field[y][x]) board[y] |= 1 << x;
+    }
+  }
+
+  // falling piece is drawn on field too
+  const GameState_t::Shape_t& shape = state.current;
+  for (int i = 0; i < shape.height; i++) {
+    for (int j = 0; j < shape.width; j++) {
+      int y = shape.y - (shape.height - 1 - i);
+      if (shape.grid[i][j] && y >= 0) {
+        board[y] &= ~(1 << (shape.x + j));
+      }
+    }
+  }
+}
+
+// the same grid for all rotations of piece
+static void getCanonical(const Piece& piece,
+                         uint8_t canonical[NEXT_HEIGHT][NEXT_WIDTH]) {
+  Piece rotations[4];
+  int count = TetrisBot::getRotations(piece, rotations);
+  memcpy(canonical, rotations[0].grid, sizeof(rotations[0].grid));
+  for (int i = 1; i < count; i++) {
+    if (memcmp(rotations[i].grid, canonical, sizeof(rotations[i].grid)) < 0) {
+      memcpy(canonical, rotations[i].grid, sizeof(rotations[i].grid));
+    }
+  }
+}
+
+bool TetrisBot::samePlan(const Board& board, const GameState_t& state) const {
+  uint8_t canonical[NEXT_HEIGHT][NEXT_WIDTH];
+  getCanonical(makePiece(state.current), canonical);
+  return hasPlan && memcmp(board, planBoard, sizeof(Board)) == 0 &&
+         memcmp(canonical, planPiece, sizeof(canonical)) == 0 &&
+         memcmp(&state.next, &planNext, sizeof(planNext)) == 0;
+}
+
+bool TetrisBot::nextAction(const GameLogic& game, UserAction_t& action) {
+  GameState_t state;
+  game.saveState(state);
+  GameStatus status = static_cast<GameStatus>(state.status);
+  if (state.magic != STATE_MAGIC) {
+    return false;  // board is not classic, state has no field
+  }
+
+  if (status == GameStatus::INIT || status == GameStatus::GAME_OVER ||
+      status == GameStatus::WIN) {
+    hasPlan = false;
+    action = UserAction_t::Start;
+    return true;
+  }
+  if (status != GameStatus::GAME || !state.hasShapes) {
+    return false;
+  }
+
+  Board board;
+  getBoard(state, board);
+  Piece current = makePiece(state.current);
+  if (!samePlan(board, state)) {
+    plan = findPlacement(board, current, makePiece(state.next));
+    memcpy(planBoard, board, sizeof(Board));
+    getCanonical(current, planPiece);
+    planNext = state.next;
+    hasPlan = true;
+    rotateAttempts = 0;
+    lastX = -1;
+  }
+
+  // the move did not happen, piece needs to go down first
+  bool isBlocked = (lastAction == UserAction_t::Left ||
+                    lastAction == UserAction_t::Right) &&
+                   state.current.x == lastX;
+  if (!sameGrid(current, plan.piece) && rotateAttempts < 4) {
+    action = UserAction_t::Action;
+    rotateAttempts++;
+  } else if (!isBlocked && state.current.x < plan.x) {
+    action = UserAction_t::Right;
+  } else if (!isBlocked && state.current.x > plan.x) {
+    action = UserAction_t::Left;
+  } else if (state.current.x == plan.x) {
+    action = UserAction_t::HardDrop;
+  } else {
+    action = UserAction_t::Down;
+  }
+
+  lastX = state.current.x;
+  lastAction = action;
+  return true;
+}
@@ -0,0 +1,92 @@
+#ifndef TETRIS_BOT_HPP
+#define TETRIS_BOT_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include "../gameBot.hpp"
+
+namespace s21 {
+
+// weights of board heuristic, bigger score is better board
+struct TetrisWeights {
+  double height = -0.510066;
+  double lines = 0.760666;
+  double holes = -0.35663;
+  double bumpiness = -0.184483;
+};
+
+// Tetris bot: tries every rotation and column of current piece, then of
+// next piece on each resulting board, and moves piece to the placement with
+// the best heuristic. Placements of current piece are scored in parallel.
+class TetrisBot : public GameBot {
+ public:
+  // rows of board as bit masks, bit x is column x
+  using Board = uint16_t[FIELD_HEIGHT];
+
+  struct Piece {
+    uint8_t grid[NEXT_HEIGHT][NEXT_WIDTH];  // same grid as in engine
+    uint16_t rows[NEXT_HEIGHT];
+    int width;
+    int height;
+  };
+
+  struct Placement {
+    Piece piece;
+    int x;
+    double score;
+  };
+
+  explicit TetrisBot(int threads = 0, TetrisWeights weights = {});
+  ~TetrisBot();
+
+  bool nextAction(const GameLogic& game, UserAction_t& action) override;
+  // best placement of current piece with next piece taken into account
+  Placement findPlacement(const Board& board, const Piece& current,
+                          const Piece& next);
+
+  static Piece makePiece(const GameState_t::Shape_t& shape);
+  // all distinct rotations in engine order, returns their count
+  static int getRotations(const Piece& piece, Piece rotations[4]);
+  double evaluate(const Board& board, int lines) const;
+
+ private:
+  struct Candidate {
+    Placement placement;
+    Board board;
+    int lines;
+  };
+
+  void scoreCandidates();
+  void workerLoop();
+  bool samePlan(const Board& board, const GameState_t& state) const;
+
+  TetrisWeights weights;
+  std::vector<Candidate> candidates;
+  Piece nextRotations[4];
+  int nextRotationsCount = 0;
+  std::atomic<int> nextCandidate = 0;
+
+  std::vector<std::thread> workers;
+  std::mutex poolMutex;
+  std::condition_variable poolWakeUp;
+  std::condition_variable poolDone;
+  uint64_t generation = 0;
+  int busyWorkers = 0;
+  bool stopping = false;
+
+  // plan for current piece
+  bool hasPlan = false;
+  Board planBoard = {};
+  GameState_t::Shape_t planNext = {};
+  uint8_t planPiece[NEXT_HEIGHT][NEXT_WIDTH] = {};
+  Placement plan = {};
+  int rotateAttempts = 0;
+  int lastX = -1;
+  UserAction_t lastAction = UserAction_t::Down;
+};
+}  // namespace s21
+
+#endif  // TETRIS_BOT_HPP
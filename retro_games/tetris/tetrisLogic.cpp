@@ -1,6 +1,8 @@
 #include "tetrisLogic.hpp"
 
+#include <bit>
 #include <cstdlib>
+#include <type_traits>
 
 using namespace s21;
 
@@ -13,7 +15,7 @@ using namespace s21;
 // ============================================================================
 
 typedef enum {
-  Random,
+  NoShape,
   Stick,      // I
   Square,     // O
   TShape,     // T
@@ -23,13 +25,15 @@ typedef enum {
   ZShapeRev   // revert Z
 } ShapeType;
 
-typedef struct {
+struct TetrisLogic::Shape {
   int** grid;
   int width;
   int height;
   int x;
   int y;
-} Shape;
+};
+
+using Shape = TetrisLogic::Shape;
 
 static void initializeStick(Shape* shape) {
   shape->width = 1;
@@ -93,7 +97,7 @@ static void initializeZShapeRev(Shape* shape) {
   shape->grid[1][1] = 1;
 }
 
-void (*initializeFunctions[])(Shape*) = {nullptr,  // for Random
+void (*initializeFunctions[])(Shape*) = {nullptr,  // for NoShape
                                          initializeStick,
                                          initializeSquare,
                                          initializeTShape,
@@ -102,25 +106,17 @@ void (*initializeFunctions[])(Shape*) = {nullptr,  // for Random
                                          initializeZShape,
                                          initializeZShapeRev};
 
-static Shape* createShape(ShapeType shapeType) {
+// empty shape, game allocates its two shapes once and spawns reuse them
+static Shape* createShape() {
   Shape* createdShape = (Shape*)malloc(sizeof(Shape));
   createdShape->grid = (int**)malloc(NEXT_HEIGHT * sizeof(int*));
   for (int i = 0; i < NEXT_HEIGHT; i++) {
     createdShape->grid[i] = (int*)calloc(NEXT_WIDTH, sizeof(int));
   }
+  createdShape->width = 0;
+  createdShape->height = 0;
   createdShape->x = 0;
   createdShape->y = 0;
-
-  if (shapeType == Random) {
-    int countShapes =
-        sizeof(initializeFunctions) / sizeof(initializeFunctions[0]);
-    shapeType = (ShapeType)(1 + (rand() % (countShapes - 1)));
-  }
-
-  if (shapeType >= Stick && shapeType <= ZShapeRev) {
-    initializeFunctions[shapeType](createdShape);
-  }
-
   return createdShape;
 }
 
@@ -140,57 +136,6 @@ static void destroyShape(Shape*& shape) {
 // End functions for initializing shapes
 // ============================================================================
 
-//
-// ============================================================================
-// Functions for storing game information
-// ============================================================================
-
-static Shape* createShapeCopy(const Shape* shape) {
-  Shape* newShape = (Shape*)malloc(sizeof(Shape));
-
-  newShape->width = shape->width;
-  newShape->height = shape->height;
-  newShape->x = shape->x;
-  newShape->y = shape->y;
-
-  newShape->grid = (int**)malloc(NEXT_HEIGHT * sizeof(int*));
-  for (int i = 0; i < NEXT_HEIGHT; i++) {
-    newShape->grid[i] = (int*)malloc(NEXT_WIDTH * sizeof(int));
-    for (int j = 0; j < NEXT_WIDTH; j++) {
-      newShape->grid[i][j] = shape->grid[i][j];
-    }
-  }
-
-  return newShape;
-}
-
-// return active figure
-static Shape** getCurrentShape() {
-  static Shape* currentShape = nullptr;
-  return &currentShape;
-}
-
-static void setCurrentShape(Shape* shape) {
-  Shape** currentShapePtr = getCurrentShape();
-  *currentShapePtr = createShapeCopy(shape);
-}
-
-// return next shape
-static Shape** getNextShape() {
-  static Shape* nextShape = nullptr;
-  return &nextShape;
-}
-
-static void setNextShape(Shape* shape) {
-  Shape** nextShapePtr = getNextShape();
-  *nextShapePtr = createShapeCopy(shape);
-}
-
-//
-// ============================================================================
-// End functions for storing game information
-// ============================================================================
-
 //
 // ============================================================================
 // Functions for moving shapes
@@ -200,10 +145,7 @@ typedef enum { RotateRight, RotateLeft } RotateSide;
 
 static void rotateShapeSimple(Shape* shape, RotateSide side) {
   // temp grid for rotate
-  int** newGrid = (int**)malloc(NEXT_HEIGHT * sizeof(int*));
-  for (int i = 0; i < NEXT_HEIGHT; i++) {
-    newGrid[i] = (int*)calloc(NEXT_WIDTH, sizeof(int));
-  }
+  int newGrid[NEXT_HEIGHT][NEXT_WIDTH] = {};
 
   // make rotate
   for (int i = 0; i < shape->height; i++) {
@@ -216,18 +158,17 @@ static void rotateShapeSimple(Shape* shape, RotateSide side) {
     }
   }
 
-  // refresh origin shape
+  // refresh origin shape, its rows stay in place for GameInfo_t::next
   for (int i = 0; i < NEXT_HEIGHT; i++) {
-    free(shape->grid[i]);
+    memcpy(shape->grid[i], newGrid[i], sizeof(newGrid[i]));
   }
-  free(shape->grid);
-  shape->grid = newGrid;
   int temp = shape->width;
   shape->width = shape->height;
   shape->height = temp;
 }
 
-static bool checkCollision(Shape* shape, int** field) {
+template <class Board>
+static bool checkCollision(const Board& board, Shape* shape, int** field) {
   bool collision = false;
   for (int i = 0; i < shape->height && !collision; i++) {
     for (int j = 0; j < shape->width && !collision; j++) {
@@ -238,8 +179,8 @@ static bool checkCollision(Shape* shape, int** field) {
       if (newY < 0) newY = 0;
 
       // check bound and field collision
-      bool boundX = newX >= FIELD_WIDTH || newX < 0;
-      bool boundY = newY >= FIELD_HEIGHT || newY < 0;
+      bool boundX = newX >= board.width() || newX < 0;
+      bool boundY = newY >= board.height() || newY < 0;
       if (boundX || boundY || field[newY][newX] != 0) {
         collision = true;
       }
@@ -249,7 +190,9 @@ static bool checkCollision(Shape* shape, int** field) {
 }
 
 // add, or remove shape from field
-static void updateShapeOnField(Shape* shape, int** field, bool add) {
+template <class Board>
+static void updateShapeOnField(const Board& board, Shape* shape, int** field,
+                               bool add) {
   for (int i = shape->height - 1; i >= 0; i--) {
     for (int j = 0; j < shape->width; j++) {
       if (!shape->grid[i][j]) continue;
@@ -259,59 +202,101 @@ static void updateShapeOnField(Shape* shape, int** field, bool add) {
       int y = shape->y - (shape->height - i - 1);
 
       // check bounds of field
-      if (y >= 0 && y < FIELD_HEIGHT && x >= 0 && x < FIELD_WIDTH) {
+      if (y >= 0 && y < board.height() && x >= 0 && x < board.width()) {
         field[y][x] = add ? shape->grid[i][j] : 0;
       }
     }
   }
 }
 
-static bool moveShape(int dx, int dy, GameInfo_t& gameInfo) {
+template <class Board>
+static bool moveShape(const Board& board, int dx, int dy, Shape* currentShape,
+                      GameInfo_t& gameInfo) {
   bool isCollision = false;
-  Shape* currentShape = *getCurrentShape();
-  updateShapeOnField(currentShape, gameInfo.field, false);
+  updateShapeOnField(board, currentShape, gameInfo.field, false);
 
   currentShape->x += dx;
   currentShape->y += dy;
 
-  if (checkCollision(currentShape, gameInfo.field)) {
+  if (checkCollision(board, currentShape, gameInfo.field)) {
     currentShape->x -= dx;
     currentShape->y -= dy;
     isCollision = true;
   }
 
-  updateShapeOnField(currentShape, gameInfo.field, true);
+  updateShapeOnField(board, currentShape, gameInfo.field, true);
   return isCollision;
 }
 
-static void spawnNewShape(GameInfo_t& gameInfo) {
-  Shape* tempShape = nullptr;
-  destroyShape(*getCurrentShape());
+// piece by its code into shape, shape is created on first use
+static void setPiece(Shape*& shape, uint8_t piece) {
+  if (shape == nullptr) {
+    shape = createShape();
+  }
+  for (int i = 0; i < NEXT_HEIGHT; i++) {
+    memset(shape->grid[i], 0, NEXT_WIDTH * sizeof(int));
+  }
+  shape->x = 0;
+  shape->y = 0;
 
-  if (*getNextShape() == nullptr) {
-    tempShape = createShape(Random);
-    setCurrentShape(tempShape);
-    destroyShape(tempShape);
-  } else {
-    setCurrentShape(*getNextShape());
-    destroyShape(*getNextShape());
+  int type = piece & ((1 << PIECE_TURNS_SHIFT) - 1);
+  if (type >= Stick && type <= ZShapeRev) {
+    initializeFunctions[type](shape);
+  }
+  for (int i = 0; i < piece >> PIECE_TURNS_SHIFT; i++) {
+    rotateShapeSimple(shape, RotateRight);
   }
+}
 
-  tempShape = createShape(Random);
-  setNextShape(tempShape);
-  destroyShape(tempShape);
+// random type left in bag, bag of all types again when empty; random
+// turns from 0 to 3
+static uint8_t dealPiece(PieceQueue& queue, RandomGenerator& random) {
+  if (queue.bag == 0) {
+    queue.bag = (1 << PIECE_TYPES) - 1;
+  }
+  // type is the left-th bit set in bag
+  int left = random.next(std::popcount(queue.bag));
+  int type = -1;
+  while (left >= 0) {
+    type++;
+    left -= queue.bag >> type & 1;
+  }
+  queue.bag &= ~(1 << type);
+  int turns = random.next(4);
+  return static_cast<uint8_t>((type + 1) | turns << PIECE_TURNS_SHIFT);
+}
 
-  // Random rotate shape from 0 to 3
-  int rotations = rand() % 4;
-  for (int i = 0; i < rotations; i++) {
-    rotateShapeSimple(*getNextShape(), RotateRight);
+static void fillQueue(PieceQueue& queue, int size, RandomGenerator& random) {
+  queue.head = 0;
+  queue.size = size;
+  queue.bag = 0;
+  for (int i = 0; i < size; i++) {
+    queue.pieces[i] = dealPiece(queue, random);
   }
-  gameInfo.next = (*getNextShape())->grid;
+}
+
+// head of queue, its place in ring takes a new piece
+static uint8_t takePiece(PieceQueue& queue, RandomGenerator& random) {
+  uint8_t piece = queue.pieces[queue.head];
+  queue.pieces[queue.head] = dealPiece(queue, random);
+  queue.head = (queue.head + 1) % queue.size;
+  return piece;
+}
+
+// next piece falls, head of queue is the new next; shapes are reused, so
+// spawn allocates nothing
+template <class Board>
+static void spawnNewShape(const Board& board, Shape*& currentShape,
+                          Shape*& nextShape, PieceQueue& queue,
+                          GameInfo_t& gameInfo, RandomGenerator& random) {
+  setPiece(currentShape, takePiece(queue, random));
+  setPiece(nextShape, queue.pieces[queue.head]);
+  gameInfo.next = nextShape->grid;
 
   // Random position on the X-axis
-  int randomX = rand() % (FIELD_WIDTH - (*getCurrentShape())->width);
-  (*getCurrentShape())->x = randomX;
-  updateShapeOnField((*getCurrentShape()), gameInfo.field, true);
+  int randomX = random.next(board.width() - currentShape->width);
+  currentShape->x = randomX;
+  updateShapeOnField(board, currentShape, gameInfo.field, true);
 }
 
 //
@@ -319,37 +304,351 @@ static void spawnNewShape(GameInfo_t& gameInfo) {
 // End functions for moving shapes
 // ============================================================================
 
+//
+// ============================================================================
+// Functions for features of board
+// ============================================================================
+
+// wells and totals from columns, O(width)
+template <class Board>
+static void updateSummary(const Board& board, BoardFeatures& features) {
+  features.aggregateHeight = 0;
+  features.totalHoles = 0;
+  features.bumpiness = 0;
+  features.maxHeight = 0;
+  for (int x = 0; x < board.width(); x++) {
+    int height = features.heights[x];
+    int left = x > 0 ? features.heights[x - 1] : board.height();
+    int right =
+        x < board.width() - 1 ? features.heights[x + 1] : board.height();
+    features.wells[x] = std::max(0, std::min(left, right) - height);
+    features.aggregateHeight += height;
+    features.totalHoles += features.holes[x];
+    features.maxHeight = std::max(features.maxHeight, height);
+    if (x > 0) {
+      features.bumpiness += std::abs(height - features.heights[x - 1]);
+    }
+  }
+}
+
+template <class Board>
+static void countColumn(const Board& board, int** field, int x,
+                        BoardFeatures& features) {
+  int y = 0;
+  while (y < board.height() && field[y][x] == 0) {
+    y++;
+  }
+  features.heights[x] = board.height() - y;
+  features.holes[x] = 0;
+  for (; y < board.height(); y++) {
+    features.holes[x] += field[y][x] == 0;
+  }
+}
+
+// full scan, for new or loaded board
+template <class Board>
+static void countBoardFeatures(const Board& board, int** field,
+                               Shape* fallingShape, BoardFeatures& features) {
+  if (fallingShape != nullptr) {
+    updateShapeOnField(board, fallingShape, field, false);
+  }
+  for (int x = 0; x < board.width(); x++) {
+    countColumn(board, field, x, features);
+  }
+  if (fallingShape != nullptr) {
+    updateShapeOnField(board, fallingShape, field, true);
+  }
+  updateSummary(board, features);
+}
+
+// XOR of keys of cells of shape on field
+template <class Board>
+static uint64_t shapeHash(const Board& board, const Shape* shape, int kind) {
+  uint64_t hash = 0;
+  for (int i = 0; shape != nullptr && i < shape->height; i++) {
+    for (int j = 0; j < shape->width; j++) {
+      int y = shape->y - (shape->height - i - 1);
+      if (shape->grid[i][j] && y >= 0) {
+        hash ^= GameLogic::hashKey(kind, y * board.width() + shape->x + j);
+      }
+    }
+  }
+  return hash;
+}
+
+// full hash of locked cells, for new or loaded board
+template <class Board>
+static uint64_t boardHash(const Board& board, int** field,
+                          Shape* fallingShape) {
+  if (fallingShape != nullptr) {
+    updateShapeOnField(board, fallingShape, field, false);
+  }
+  uint64_t hash = 0;
+  for (int y = 0; y < board.height(); y++) {
+    for (int x = 0; x < board.width(); x++) {
+      if (field[y][x] == 1) {
+        hash ^= GameLogic::hashKey(HASH_FILLED, y * board.width() + x);
+      }
+    }
+  }
+  if (fallingShape != nullptr) {
+    updateShapeOnField(board, fallingShape, field, true);
+  }
+  return hash;
+}
+
+// piece became part of board, only its columns change
+template <class Board>
+static void lockShape(const Board& board, const Shape* shape,
+                      BoardFeatures& features, uint64_t& hash) {
+  hash ^= shapeHash(board, shape, HASH_FILLED);
+  for (int j = 0; j < shape->width; j++) {
+    int x = shape->x + j;
+    int oldTop = board.height() - features.heights[x];
+    int newTop = oldTop;
+    int cellsAbove = 0;
+
+    for (int i = 0; i < shape->height; i++) {
+      if (!shape->grid[i][j]) continue;
+      int y = shape->y - (shape->height - i - 1);
+      if (y >= oldTop) {
+        features.holes[x]--;  // piece was moved under overhang
+      } else {
+        newTop = std::min(newTop, y);
+        cellsAbove++;
+      }
+    }
+
+    // empty cells between old top and piece become holes
+    features.holes[x] += oldTop - newTop - cellsAbove;
+    features.heights[x] = board.height() - newTop;
+  }
+  updateSummary(board, features);
+}
+
+// bottom row of shape where it lands, from bottom of shape and heights
+template <class Board>
+static int landingRow(const Board& board, const Shape* shape,
+                      const BoardFeatures& features) {
+  int row = board.height() - 1;
+  for (int j = 0; j < shape->width; j++) {
+    int bottom = shape->height - 1;
+    while (bottom >= 0 && !shape->grid[bottom][j]) {
+      bottom--;
+    }
+    if (bottom >= 0) {
+      int top = board.height() - features.heights[shape->x + j];
+      row = std::min(row, top - 1 + (shape->height - 1 - bottom));
+    }
+  }
+  return row;
+}
+
+// shape must be removed from field
+template <class Board>
+static int findLandingRow(const Board& board, Shape* shape, int** field,
+                          const BoardFeatures& features) {
+  int row = landingRow(board, shape, features);
+  if (row < shape->y) {
+    // shape is under overhang, tops of columns are above it
+    int oldY = shape->y;
+    row = oldY;
+    shape->y = row + 1;
+    while (!checkCollision(board, shape, field)) {
+      shape->y = ++row + 1;
+    }
+    shape->y = oldY;
+  }
+  return row;
+}
+
+template <class Board>
+static void hardDrop(const Board& board, Shape* shape, GameInfo_t& gameInfo,
+                     const BoardFeatures& features) {
+  updateShapeOnField(board, shape, gameInfo.field, false);
+  shape->y = findLandingRow(board, shape, gameInfo.field, features);
+  updateShapeOnField(board, shape, gameInfo.field, true);
+}
+
+static void eraseGhost(GhostPiece& ghost, int** field) {
+  for (int i = 0; i < ghost.count; i++) {
+    if (field[ghost.y[i]][ghost.x[i]] == GHOST_CELL) {
+      field[ghost.y[i]][ghost.x[i]] = 0;
+    }
+  }
+  ghost.count = 0;
+}
+
+// ghost is under falling piece, piece is drawn over it
+template <class Board>
+static void drawGhost(const Board& board, GhostPiece& ghost, Shape* shape,
+                      GameInfo_t& gameInfo, const BoardFeatures& features) {
+  eraseGhost(ghost, gameInfo.field);
+  updateShapeOnField(board, shape, gameInfo.field, false);
+
+  int row = findLandingRow(board, shape, gameInfo.field, features);
+  for (int i = 0; i < shape->height; i++) {
+    for (int j = 0; j < shape->width; j++) {
+      int x = shape->x + j;
+      int y = row - (shape->height - i - 1);
+      if (shape->grid[i][j] && y >= 0 && gameInfo.field[y][x] == 0) {
+        gameInfo.field[y][x] = GHOST_CELL;
+        ghost.x[ghost.count] = x;
+        ghost.y[ghost.count++] = y;
+      }
+    }
+  }
+
+  updateShapeOnField(board, shape, gameInfo.field, true);
+}
+
+//
+// ============================================================================
+// End functions for features of board
+// ============================================================================
+
 static void gameOver(GameInfo_t& gameInfo, GameStatus& gameStatus) {
   gameInfo.pause = 1;
   gameStatus = GameStatus::GAME_OVER;
 }
 
-static int removeClearLines(GameInfo_t& gameInfo) {
+// Rows from top take place of garbage at bottom, so rows are not copied.
+// Every column goes up by lines, column of hole gets lines of holes under
+// its cells; only rows with cells are rehashed. Board must be without
+// piece and fit garbage.
+template <class Board>
+static void pushGarbage(const Board& board, int lines, int hole,
+                        GameInfo_t& gameInfo, BoardFeatures& features,
+                        uint64_t& hash) {
+  int** field = gameInfo.field;
+  std::rotate(field, field + lines, field + board.height());
+  for (int y = board.height() - lines; y < board.height(); y++) {
+    for (int x = 0; x < board.width(); x++) {
+      field[y][x] = x != hole;
+    }
+  }
+
+  for (int x = 0; x < board.width(); x++) {
+    if (features.heights[x] > 0) {
+      features.heights[x] += lines;
+      features.holes[x] += x == hole ? lines : 0;
+    } else if (x != hole) {
+      features.heights[x] = lines;
+    }
+  }
+  updateSummary(board, features);
+
+  hash = 0;
+  for (int y = board.height() - features.maxHeight; y < board.height(); y++) {
+    for (int x = 0; x < board.width(); x++) {
+      if (field[y][x] == 1) {
+        hash ^= GameLogic::hashKey(HASH_FILLED, y * board.width() + x);
+      }
+    }
+  }
+}
+
+// game is over if locked cells are pushed to top row, as by lock of piece,
+// or piece has no place above garbage
+template <class Board>
+static void addGarbageLines(const Board& board, int lines, int hole,
+                            Shape* shape, GameInfo_t& gameInfo,
+                            GameStatus& gameStatus, BoardFeatures& features,
+                            uint64_t& hash) {
+  if (features.maxHeight + lines >= board.height()) {
+    gameOver(gameInfo, gameStatus);
+    return;
+  }
+
+  updateShapeOnField(board, shape, gameInfo.field, false);
+  pushGarbage(board, lines, hole, gameInfo, features, hash);
+  while (shape->y > 0 && checkCollision(board, shape, gameInfo.field)) {
+    shape->y--;
+  }
+  if (checkCollision(board, shape, gameInfo.field)) {
+    gameOver(gameInfo, gameStatus);
+  }
+  updateShapeOnField(board, shape, gameInfo.field, true);
+}
+
+// keys of locked cells of rows from first to last
+template <class Board>
+static uint64_t rowsHash(const Board& board, int** field, int first,
+                         int last) {
+  uint64_t hash = 0;
+  for (int y = first; y <= last; y++) {
+    for (int x = 0; x < board.width(); x++) {
+      if (field[y][x] == 1) {
+        hash ^= GameLogic::hashKey(HASH_FILLED, y * board.width() + x);
+      }
+    }
+  }
+  return hash;
+}
+
+// Field is a table of row pointers in visual order, so full rows are
+// removed by moving pointers: rows left go down over them and the full
+// rows are cleared at top of stack. Only rows of stack are looked at and
+// only rows down to the lowest full one change, they are rehashed.
+template <class Board>
+static int removeClearLines(const Board& board, GameInfo_t& gameInfo,
+                            BoardFeatures& features, uint64_t& hash) {
+  int** field = gameInfo.field;
+  int top = board.height() - features.maxHeight;
   int removedLines = 0;
+  int lowest = -1;
+  bool recount[MAX_FIELD_WIDTH] = {};
 
-  for (int y = FIELD_HEIGHT - 1; y >= 0; y--) {
+  // kept row goes to place of the lowest full row below it, full rows
+  // go up
+  for (int y = board.height() - 1; y >= top; y--) {
     bool isLineClear = true;
-    for (int x = 0; x < FIELD_WIDTH; x++) {
-      isLineClear &= gameInfo.field[y][x] != 0;
+    for (int x = 0; x < board.width() && isLineClear; x++) {
+      isLineClear = field[y][x] != 0;
     }
 
     if (isLineClear) {
-      removedLines++;
-
-      for (int j = y; j > 0; j--) {
-        for (int x = 0; x < FIELD_WIDTH; x++) {
-          gameInfo.field[j][x] = gameInfo.field[j - 1][x];
+      if (removedLines++ == 0) {
+        lowest = y;
+        hash ^= rowsHash(board, field, top, lowest);
+      }
+      // columns lower down by one, except columns with top on this line,
+      // their holes under it may open
+      for (int x = 0; x < board.width(); x++) {
+        if (features.heights[x] == board.height() - y - removedLines + 1) {
+          recount[x] = true;
+        } else if (!recount[x]) {
+          features.heights[x]--;
         }
       }
-      y++;
+    } else if (removedLines > 0) {
+      std::swap(field[y], field[y + removedLines]);
+    }
+  }
+
+  for (int y = top; y < top + removedLines; y++) {
+    memset(field[y], 0, board.width() * sizeof(int));
+  }
+  if (removedLines > 0) {
+    hash ^= rowsHash(board, field, top, lowest);
+  }
+
+  for (int x = 0; x < board.width() && removedLines; x++) {
+    if (recount[x]) {
+      countColumn(board, gameInfo.field, x, features);
     }
   }
+  updateSummary(board, features);
 
   return removedLines;
 }
 
-static void clearFullLines(GameInfo_t& gameInfo, GameStatus& gameStatus) {
-  int clearedLines = removeClearLines(gameInfo);
+// returns number of cleared lines
+template <class Board>
+static int clearFullLines(const Board& board, GameInfo_t& gameInfo,
+                          GameStatus& gameStatus, BoardFeatures& features,
+                          uint64_t& hash, bool savesHighScore) {
+  int clearedLines = removeClearLines(board, gameInfo, features, hash);
 
   switch (clearedLines) {
     case 1:
@@ -368,7 +667,9 @@ static void clearFullLines(GameInfo_t& gameInfo, GameStatus& gameStatus) {
 
   if (gameInfo.score > gameInfo.high_score) {
     gameInfo.high_score = gameInfo.score;
-    GameLogic::saveHighScore(gameInfo.high_score, DB_ID);
+    if (savesHighScore) {
+      GameLogic::saveHighScore(gameInfo.high_score, DB_ID);
+    }
   }
 
   while (gameInfo.score >= gameInfo.level * 600) {
@@ -380,81 +681,109 @@ static void clearFullLines(GameInfo_t& gameInfo, GameStatus& gameStatus) {
     gameStatus = GameStatus::WIN;
     gameInfo.pause = 1;
   }
+  return clearedLines;
 }
 
-static void startGame(GameStatus& gameStatus, GameInfo_t& gameInfo) {
+template <class Board>
+static void startGame(const Board& board, GameStatus& gameStatus,
+                      GameInfo_t& gameInfo, Shape*& currentShape,
+                      Shape*& nextShape, PieceQueue& queue, int previewSize,
+                      RandomGenerator& random, BoardFeatures& features,
+                      uint64_t& hash, bool savesHighScore) {
   gameStatus = GameStatus::GAME;
 
-  for (int i = 0; i < FIELD_HEIGHT; i++) {
-    for (int j = 0; j < FIELD_WIDTH; j++) {
+  for (int i = 0; i < board.height(); i++) {
+    for (int j = 0; j < board.width(); j++) {
       gameInfo.field[i][j] = 0;
     }
   }
-  gameInfo.high_score = GameLogic::loadHighScore(DB_ID);
+  if (savesHighScore) {
+    gameInfo.high_score = GameLogic::loadHighScore(DB_ID);
+  }
   gameInfo.score = SCORE;
   gameInfo.level = 1;
   gameInfo.speed = 1;
   gameInfo.pause = 0;
+  features = {};
+  updateSummary(board, features);
+  hash = 0;
 
-  spawnNewShape(gameInfo);
+  fillQueue(queue, previewSize, random);
+  spawnNewShape(board, currentShape, nextShape, queue, gameInfo, random);
 }
 
-static void rotateShape(bool hold, GameInfo_t& gameInfo) {
+template <class Board>
+static void rotateShape(const Board& board, bool hold, Shape* currentShape,
+                        GameInfo_t& gameInfo) {
   (void)hold;
-  Shape* currentShape = *getCurrentShape();
   int oldX = currentShape->x;
-  updateShapeOnField(currentShape, gameInfo.field, false);
+  updateShapeOnField(board, currentShape, gameInfo.field, false);
   rotateShapeSimple(currentShape, RotateRight);
-  while (currentShape->x + currentShape->width > FIELD_WIDTH) {
+  while (currentShape->x + currentShape->width > board.width()) {
     currentShape->x--;
   }
 
   // collision with other shapes on field
-  if (checkCollision(currentShape, gameInfo.field)) {
+  if (checkCollision(board, currentShape, gameInfo.field)) {
     rotateShapeSimple(currentShape, RotateLeft);
     currentShape->x = oldX;
   }
 
-  updateShapeOnField(currentShape, gameInfo.field, true);
+  updateShapeOnField(board, currentShape, gameInfo.field, true);
 }
 
-TetrisLogic::TetrisLogic() {
-  srand(time(nullptr));
+TetrisLogic::TetrisLogic(int width, int height) {
+  ghostCell = GHOST_CELL;
+  gameInfo.width = std::clamp(width, MIN_FIELD_SIZE, MAX_FIELD_WIDTH);
+  gameInfo.height = std::max(height, MIN_FIELD_SIZE);
   gameInfo.field = nullptr;
   gameInfo.next = nullptr;
-  gameInfo.field = (int**)malloc(FIELD_HEIGHT * sizeof(int*));
-  for (int i = 0; i < FIELD_HEIGHT; i++) {
-    gameInfo.field[i] = (int*)calloc(FIELD_WIDTH, sizeof(int));
+  gameInfo.field = (int**)malloc(gameInfo.height * sizeof(int*));
+  for (int i = 0; i < gameInfo.height; i++) {
+    gameInfo.field[i] = (int*)calloc(gameInfo.width, sizeof(int));
   }
   gameInfo.score = 0;
   gameInfo.high_score = 0;
   gameInfo.level = 1;
   gameInfo.speed = 1;
   gameInfo.pause = 1;
+  withBoard([&](const auto& board) { updateSummary(board, boardFeatures); });
 }
 
 TetrisLogic::~TetrisLogic() {
   if (gameInfo.field != nullptr) {
-    for (int i = 0; i < FIELD_HEIGHT; i++) {
+    for (int i = 0; i < gameInfo.height; i++) {
       free(gameInfo.field[i]);
     }
     free(gameInfo.field);
     gameInfo.field = nullptr;
   }
 
-  destroyShape(*getCurrentShape());
-  destroyShape(*getNextShape());
+  destroyShape(currentShape);
+  destroyShape(nextShape);
   gameInfo.next = nullptr;
 }
 
+template <class Board>
 struct ActionParams {
+  const Board& board;
   UserAction_t action;
   bool hold;
   GameStatus& gameStatus;
   GameInfo_t& gameInfo;
+  Shape*& currentShape;
+  Shape*& nextShape;
+  RandomGenerator& random;
+  BoardFeatures& features;
+  uint64_t& hash;
+  int& clearedLines;
+  bool savesHighScore;
+  PieceQueue& queue;
+  int previewSize;  // of new game
 };
 
-static bool gameAction(ActionParams& AP) {
+template <class Board>
+static bool gameAction(ActionParams<Board>& AP) {
   bool isGameTick = false;
   using UA = UserAction_t;
   if (AP.hold && (AP.action == UA::Pause || AP.action == UA::Terminate)) {
@@ -469,28 +798,35 @@ static bool gameAction(ActionParams& AP) {
     AP.gameInfo.pause = 1;
   } else if (!AP.gameInfo.pause) {
     if (AP.action == UA::Left) {
-      moveShape(-1, 0, AP.gameInfo);
+      moveShape(AP.board, -1, 0, AP.currentShape, AP.gameInfo);
     } else if (AP.action == UA::Right) {
-      moveShape(1, 0, AP.gameInfo);
+      moveShape(AP.board, 1, 0, AP.currentShape, AP.gameInfo);
     } else if (AP.action == UA::Action || AP.action == UA::Up) {
-      rotateShape(AP.hold, AP.gameInfo);
+      rotateShape(AP.board, AP.hold, AP.currentShape, AP.gameInfo);
     } else if (AP.action == UA::Down) {
       isGameTick = true;
+    } else if (AP.action == UA::HardDrop) {
+      hardDrop(AP.board, AP.currentShape, AP.gameInfo, AP.features);
+      isGameTick = true;  // locks piece
     }
   }
 
   return isGameTick;
 }
 
-static void gameOverAction(ActionParams& AP) {
+template <class Board>
+static void gameOverAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Start) {
-    startGame(AP.gameStatus, AP.gameInfo);
+    startGame(AP.board, AP.gameStatus, AP.gameInfo, AP.currentShape,
+              AP.nextShape, AP.queue, AP.previewSize, AP.random, AP.features,
+              AP.hash, AP.savesHighScore);
   } else if (AP.action == UserAction_t::Terminate) {
     AP.gameStatus = GameStatus::INIT;
   }
 }
 
-static void pauseAction(ActionParams& AP) {
+template <class Board>
+static void pauseAction(ActionParams<Board>& AP) {
   switch (AP.action) {
     case UserAction_t::Pause:
     case UserAction_t::Start:
@@ -503,66 +839,271 @@ static void pauseAction(ActionParams& AP) {
   }
 }
 
-static void instructionAction(ActionParams& AP) {
+template <class Board>
+static void instructionAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Terminate) {
     AP.gameStatus = GameStatus::INIT;
   } else if (AP.action == UserAction_t::Start) {
-    startGame(AP.gameStatus, AP.gameInfo);
+    startGame(AP.board, AP.gameStatus, AP.gameInfo, AP.currentShape,
+              AP.nextShape, AP.queue, AP.previewSize, AP.random, AP.features,
+              AP.hash, AP.savesHighScore);
   }
 }
 
-static void initAction(ActionParams& AP) {
+template <class Board>
+static void initAction(ActionParams<Board>& AP) {
   if (AP.action == UserAction_t::Up) {
     AP.gameStatus = GameStatus::INSTRUCTION;
   } else if (AP.action == UserAction_t::Start) {
-    startGame(AP.gameStatus, AP.gameInfo);
+    startGame(AP.board, AP.gameStatus, AP.gameInfo, AP.currentShape,
+              AP.nextShape, AP.queue, AP.previewSize, AP.random, AP.features,
+              AP.hash, AP.savesHighScore);
   }
 }
 
-void TetrisLogic::userInput(UserAction_t action, bool hold) {
-  ActionParams actionParams = {action, hold, currentGameStatus, gameInfo};
-
-  switch (currentGameStatus) {
-    case GameStatus::INIT: {
-      std::lock_guard<std::mutex> lock(gameTickMutex);
-      initAction(actionParams);
-    } break;
+// returns true if piece must fall by game tick
+template <class Board>
+static bool applyInput(ActionParams<Board>& AP) {
+  bool isGameTick = false;
+  switch (AP.gameStatus) {
+    case GameStatus::INIT:
+      initAction(AP);
+      break;
     case GameStatus::INSTRUCTION:
-      instructionAction(actionParams);
+      instructionAction(AP);
       break;
     case GameStatus::PAUSE:
-      pauseAction(actionParams);
+      pauseAction(AP);
       break;
     case GameStatus::GAME_OVER:
-      gameOverAction(actionParams);
+      gameOverAction(AP);
       break;
     case GameStatus::WIN:
-      gameOverAction(actionParams);
+      gameOverAction(AP);
       break;
     case GameStatus::GAME:
-      if (gameAction(actionParams)) {
-        gameTick();
-      }
+      isGameTick = gameAction(AP);
       break;
   }
+  return isGameTick;
+}
+
+// piece falls by one row, locks if it can not
+template <class Board>
+static void fallShape(ActionParams<Board>& AP, GhostPiece& ghost) {
+  const Board& board = AP.board;
+  eraseGhost(ghost, AP.gameInfo.field);
+  if (moveShape(board, 0, 1, AP.currentShape, AP.gameInfo)) {
+    if (AP.currentShape->y - AP.currentShape->height < 0) {
+      gameOver(AP.gameInfo, AP.gameStatus);
+    } else {
+      lockShape(board, AP.currentShape, AP.features, AP.hash);
+      AP.clearedLines +=
+          clearFullLines(board, AP.gameInfo, AP.gameStatus, AP.features,
+                         AP.hash, AP.savesHighScore);
+      spawnNewShape(board, AP.currentShape, AP.nextShape, AP.queue,
+                    AP.gameInfo, AP.random);
+    }
+  }
+  if (AP.gameStatus == GameStatus::GAME) {
+    drawGhost(board, ghost, AP.currentShape, AP.gameInfo, AP.features);
+  }
+}
+
+void TetrisLogic::userInput(UserAction_t action, bool hold) {
+  // input, fall and ghost are one step for game tick thread
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  withBoard([&](const auto& board) {
+    ActionParams<std::decay_t<decltype(board)>> actionParams = {
+        board,         action,       hold,         currentGameStatus,
+        gameInfo,      currentShape, nextShape,    randomGenerator,
+        boardFeatures, hash,         clearedLines, savesHighScore,
+        queue,         previewSize};
+    // ghost is not a part of board for moves and collisions
+    eraseGhost(ghost, gameInfo.field);
+    // piece of this board falls, derived game may tick more on gameTick
+    if (applyInput(actionParams) && currentGameStatus == GameStatus::GAME) {
+      fallShape(actionParams, ghost);
+      markTick();
+    }
+    if (currentGameStatus == GameStatus::GAME && currentShape != nullptr) {
+      drawGhost(board, ghost, currentShape, gameInfo, boardFeatures);
+    }
+  });
 }
 
 GameInfo_t TetrisLogic::updateCurrentState() { return gameInfo; }
 
+int TetrisLogic::takeClearedLines() {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  int lines = clearedLines;
+  clearedLines = 0;
+  return lines;
+}
+
+void TetrisLogic::addGarbage(int lines, int hole) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  if (currentGameStatus != GameStatus::GAME || lines <= 0) return;
+
+  eraseGhost(ghost, gameInfo.field);
+  withBoard([&](const auto& board) {
+    addGarbageLines(board, std::min(lines, board.height()),
+                    std::clamp(hole, 0, board.width() - 1), currentShape,
+                    gameInfo, currentGameStatus, boardFeatures, hash);
+    if (currentGameStatus == GameStatus::GAME) {
+      drawGhost(board, ghost, currentShape, gameInfo, boardFeatures);
+    }
+  });
+}
+
+void TetrisLogic::getFocus(int& x, int& y) const {
+  x = currentShape ? currentShape->x : 0;
+  y = currentShape ? currentShape->y : 0;
+}
+
+uint64_t TetrisLogic::getHash() const {
+  uint64_t nextHash = 0;
+  for (int i = 0; nextShape != nullptr && i < NEXT_HEIGHT; i++) {
+    for (int j = 0; j < NEXT_WIDTH; j++) {
+      if (nextShape->grid[i][j]) {
+        nextHash ^= hashKey(HASH_NEXT, i * NEXT_WIDTH + j);
+      }
+    }
+  }
+  // falling piece is small, it is hashed when asked
+  return withBoard([&](const auto& board) {
+    return hash ^ shapeHash(board, currentShape, HASH_PIECE) ^ nextHash;
+  });
+}
+
 void TetrisLogic::gameTick() {
   std::lock_guard<std::mutex> lock(gameTickMutex);
 
   GameStatus GS = currentGameStatus;
   if (GS != GameStatus::GAME) return;
-  if (moveShape(0, 1, gameInfo)) {
-    Shape* currentShape = *getCurrentShape();
-    if (currentShape->y - currentShape->height < 0) {
-      gameOver(gameInfo, currentGameStatus);
+  withBoard([&](const auto& board) {
+    ActionParams<std::decay_t<decltype(board)>> actionParams = {
+        board,         UserAction_t::Down, false,        currentGameStatus,
+        gameInfo,      currentShape,       nextShape,    randomGenerator,
+        boardFeatures, hash,               clearedLines, savesHighScore,
+        queue,         previewSize};
+    fallShape(actionParams, ghost);
+  });
+
+  markTick();
+}
+
+static void saveShape(const Shape* shape, GameState_t::Shape_t& state) {
+  for (int i = 0; i < NEXT_HEIGHT; i++) {
+    for (int j = 0; j < NEXT_WIDTH; j++) {
+      state.grid[i][j] = static_cast<uint8_t>(shape->grid[i][j]);
+    }
+  }
+  state.width = static_cast<int8_t>(shape->width);
+  state.height = static_cast<int8_t>(shape->height);
+  state.x = static_cast<int8_t>(shape->x);
+  state.y = static_cast<int8_t>(shape->y);
+}
+
+static void loadShape(const GameState_t::Shape_t& state, Shape*& shape) {
+  if (shape == nullptr) {
+    shape = createShape();
+  }
+  for (int i = 0; i < NEXT_HEIGHT; i++) {
+    for (int j = 0; j < NEXT_WIDTH; j++) {
+      shape->grid[i][j] = state.grid[i][j];
+    }
+  }
+  shape->width = state.width;
+  shape->height = state.height;
+  shape->x = state.x;
+  shape->y = state.y;
+}
+
+GameState_t::Shape_t TetrisLogic::pieceShape(uint8_t piece) {
+  int cells[NEXT_HEIGHT][NEXT_WIDTH];
+  int* rows[NEXT_HEIGHT];
+  for (int i = 0; i < NEXT_HEIGHT; i++) {
+    rows[i] = cells[i];
+  }
+  Shape shape = {rows, 0, 0, 0, 0};
+  Shape* piecePointer = &shape;
+  setPiece(piecePointer, piece);
+  GameState_t::Shape_t state;
+  saveShape(&shape, state);
+  return state;
+}
+
+void TetrisLogic::setPreviewSize(int size) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  previewSize = std::clamp(size, 1, PREVIEW_SIZE);
+}
+
+// pieces of queue from the next one on
+static int copyQueue(const PieceQueue& queue, uint8_t* pieces) {
+  for (int i = 0; i < queue.size; i++) {
+    pieces[i] = queue.pieces[(queue.head + i) % queue.size];
+  }
+  return queue.size;
+}
+
+int TetrisLogic::getPreview(uint8_t* pieces) const {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  return copyQueue(queue, pieces);
+}
+
+void TetrisLogic::saveState(GameState_t& state) const {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  saveCommonState(state, GameType::TETRIS);
+  for (int i = 0; i < ghost.count && isClassicBoard(); i++) {
+    if (state.field[ghost.y[i]][ghost.x[i]] == GHOST_CELL) {
+      state.field[ghost.y[i]][ghost.x[i]] = 0;
+    }
+  }
+
+  if (currentShape != nullptr && nextShape != nullptr) {
+    state.hasShapes = 1;
+    saveShape(currentShape, state.current);
+    saveShape(nextShape, state.next);
+    state.previewSize = copyQueue(queue, state.preview);
+    state.bag = queue.bag;
+  } else {
+    state.current = {};
+    state.next = {};
+    state.previewSize = previewSize;
+  }
+}
+
+bool TetrisLogic::loadState(const GameState_t& state) {
+  std::lock_guard<std::mutex> lock(gameTickMutex);
+  bool isLoaded = loadCommonState(state, GameType::TETRIS);
+
+  if (isLoaded) {
+    if (state.previewSize > 0) {
+      previewSize = std::min<int>(state.previewSize, PREVIEW_SIZE);
+    }
+    queue = {{}, 0, 0, state.bag};
+    gameInfo.next = nullptr;
+    if (state.hasShapes) {
+      // shapes of game are kept, so spawns do not allocate them
+      loadShape(state.current, currentShape);
+      loadShape(state.next, nextShape);
+      gameInfo.next = nextShape->grid;
+      queue.size = previewSize;
+      std::copy(state.preview, state.preview + queue.size, queue.pieces);
     } else {
-      clearFullLines(gameInfo, currentGameStatus);
-      spawnNewShape(gameInfo);
+      destroyShape(currentShape);
+      destroyShape(nextShape);
+    }
+    // state is loaded only into classic board
+    ClassicBoard board;
+    ghost.count = 0;
+    countBoardFeatures(board, gameInfo.field, currentShape, boardFeatures);
+    hash = boardHash(board, gameInfo.field, currentShape);
+    if (currentGameStatus == GameStatus::GAME && currentShape != nullptr) {
+      drawGhost(board, ghost, currentShape, gameInfo, boardFeatures);
     }
   }
 
-  lastTickTime = std::chrono::high_resolution_clock::now();
+  return isLoaded;
 }
\ No newline at end of file
@@ -4,17 +4,83 @@
 #include "../gameLogic.hpp"
 
 namespace s21 {
-#define NEXT_WIDTH 4
-#define NEXT_HEIGHT 4
+#define MAX_FIELD_WIDTH 64   // columns of BoardFeatures
+#define PIECE_TYPES 7        // pieces of bag
+#define PIECE_TURNS_SHIFT 3  // code of piece: type from 1, turns right above
+
+// features of locked cells of board, without falling piece; columns from
+// width of board on are not used
+struct BoardFeatures {
+  int heights[MAX_FIELD_WIDTH];
+  int holes[MAX_FIELD_WIDTH];  // empty cells under top of column
+  int wells[MAX_FIELD_WIDTH];  // depth under lower neighbour, walls are high
+  int aggregateHeight;
+  int totalHoles;
+  int bumpiness;
+  int maxHeight;
+};
+
+// cells of ghost piece drawn on field as GHOST_CELL
+struct GhostPiece {
+  int count;
+  int x[NEXT_WIDTH * NEXT_HEIGHT];
+  int y[NEXT_WIDTH * NEXT_HEIGHT];
+};
+
+// coming pieces in ring buffer, head is the next piece; bag has bit of
+// each piece type not dealt yet
+struct PieceQueue {
+  uint8_t pieces[PREVIEW_SIZE];
+  int head;
+  int size;
+  uint8_t bag;
+};
 
 class TetrisLogic : public GameLogic {
  public:
-  TetrisLogic();
+  struct Shape;
+
+  // board is at least MIN_FIELD_SIZE in each direction and at most
+  // MAX_FIELD_WIDTH wide
+  explicit TetrisLogic(int width = FIELD_WIDTH, int height = FIELD_HEIGHT);
   ~TetrisLogic();
   void userInput(UserAction_t action, bool hold) override;
   GameInfo_t updateCurrentState() override;
   void gameTick() override;
+  void saveState(GameState_t& state) const override;
+  bool loadState(const GameState_t& state) override;
+  uint64_t getHash() const override;
+  // falling piece
+  void getFocus(int& x, int& y) const override;
+  // kept up to date when piece locks and lines are cleared
+  const BoardFeatures& getBoardFeatures() const { return boardFeatures; }
+  // lines cleared since last call
+  int takeClearedLines();
+  // pushes rows of garbage from bottom, each full but cell at column hole;
+  // game is over if locked cells reach top row
+  void addGarbage(int lines, int hole);
+
+  // Pieces are dealt from a bag of all PIECE_TYPES in random order, the bag
+  // is filled again when empty; each piece gets random turns when dealt.
+  // Preview is the queue of dealt pieces from the next one on, size is
+  // from 1 (next piece only) to PREVIEW_SIZE and is taken by new game.
+  void setPreviewSize(int size);
+  int getPreviewSize() const { return previewSize; }
+  // codes of coming pieces into pieces[PREVIEW_SIZE], the next one first;
+  // returns their count, 0 before game
+  int getPreview(uint8_t* pieces) const;
+  // grid of piece by its code, as grid of next piece
+  static GameState_t::Shape_t pieceShape(uint8_t piece);
+
+ protected:
+  Shape* currentShape = nullptr;
+  Shape* nextShape = nullptr;
+  BoardFeatures boardFeatures = {};
+  GhostPiece ghost = {};
+  PieceQueue queue = {{}, 0, 0, 0};
+  int previewSize = 1;
+  int clearedLines = 0;
 };
 }  // namespace s21
 
-#endif  // TETRIS_LOGIC_HPP
\ No newline at end of file
+#endif  // TETRIS_LOGIC_HPP
@@ -0,0 +1,187 @@
+#include "tetrisVersus.hpp"
+
+#include "tetrisBot.hpp"
+
+using namespace s21;
+
+// board of opponent, its score is not a high score of player
+class TetrisVersus::Opponent : public TetrisLogic {
+ public:
+  Opponent(int width, int height) : TetrisLogic(width, height) {
+    savesHighScore = false;
+  }
+};
+
+// rows of garbage for lines cleared at once
+static int garbageRows(int lines) {
+  return lines >= 4 ? lines : std::max(0, lines - 1);
+}
+
+static bool isInPlay(const TetrisLogic& board) {
+  return board.getCurrentGameStatus() == GameStatus::GAME;
+}
+
+TetrisVersus::TetrisVersus(int boards, int width, int height)
+    : TetrisLogic(width, height) {
+  boards = std::clamp(boards, 2, MAX_VERSUS_BOARDS);
+  bots.resize(boards);
+  sentLines.resize(boards);
+  linesCleared.resize(boards);
+  for (int i = 1; i < boards; i++) {
+    opponents.push_back(std::make_unique<Opponent>(width, height));
+    // one thread for all bots, they take turns on tick
+    bots[i] = std::make_unique<TetrisBot>(1);
+  }
+}
+
+TetrisVersus::~TetrisVersus() = default;
+
+const TetrisLogic& TetrisVersus::getBoard(int index) const {
+  if (index == 0) return *this;
+  return *opponents[index - 1];
+}
+
+TetrisLogic& TetrisVersus::board(int index) {
+  if (index == 0) return *this;
+  return *opponents[index - 1];
+}
+
+void TetrisVersus::setBot(int index, std::unique_ptr<GameBot> bot) {
+  std::lock_guard<std::mutex> lock(matchMutex);
+  if (bot || index == 0) {
+    bots[index] = std::move(bot);
+  }
+}
+
+// all boards start with the same seed and preview, so they get the same
+// pieces
+void TetrisVersus::startMatch() {
+  uint64_t seed = randomGenerator.getState();
+  setSeed(seed);
+  garbageRandom.setSeed(seed + 1);
+  for (auto& opponent : opponents) {
+    opponent->setSeed(seed);
+    opponent->setPreviewSize(previewSize);
+    opponent->userInput(UserAction_t::Start, false);
+  }
+  TetrisLogic::userInput(UserAction_t::Start, false);
+  for (int i = 0; i < getBoardsCount(); i++) {
+    board(i).takeClearedLines();
+    sentLines[i] = 0;
+    linesCleared[i] = 0;
+  }
+  winner = -1;
+  finished = false;
+}
+
+// each bot plays only its board in play, bot of ended game would start it
+void TetrisVersus::playBots() {
+  UserAction_t action;
+  for (int i = 0; i < getBoardsCount(); i++) {
+    bool isPlaying = bots[i] != nullptr;
+    for (int j = 0; j < VERSUS_BOT_ACTIONS && isPlaying; j++) {
+      isPlaying = isInPlay(board(i)) && bots[i]->nextAction(board(i), action);
+      if (isPlaying && i == 0) {
+        TetrisLogic::userInput(action, false);
+      } else if (isPlaying) {
+        opponents[i - 1]->userInput(action, false);
+      }
+      exchangeGarbage();
+    }
+  }
+}
+
+// garbage goes to the next board in play after sender, by order of boards
+void TetrisVersus::exchangeGarbage() {
+  int count = getBoardsCount();
+  for (int i = 0; i < count; i++) {
+    int lines = board(i).takeClearedLines();
+    int rows = garbageRows(lines);
+    linesCleared[i] += lines;
+    int target = (i + 1) % count;
+    while (target != i && !isInPlay(board(target))) {
+      target = (target + 1) % count;
+    }
+    if (rows > 0 && target != i) {
+      board(target).addGarbage(rows, garbageRandom.next(gameInfo.width));
+      sentLines[i] += rows;
+    }
+  }
+}
+
+void TetrisVersus::updateResult() {
+  int inPlay = 0;
+  int last = -1;
+  int levelWinner = -1;
+  for (int i = 0; i < getBoardsCount(); i++) {
+    GameStatus status = board(i).getCurrentGameStatus();
+    // paused board of player is still in match
+    if (status == GameStatus::GAME || status == GameStatus::PAUSE) {
+      inPlay++;
+      last = i;
+    } else if (status == GameStatus::WIN && levelWinner < 0) {
+      levelWinner = i;
+    }
+  }
+
+  if (levelWinner >= 0 || inPlay < 2) {
+    finished = true;
+    winner = levelWinner >= 0 ? levelWinner : inPlay == 1 ? last : -1;
+    if (winner == 0) {
+      currentGameStatus = GameStatus::WIN;
+      gameInfo.pause = 1;
+    } else if (currentGameStatus == GameStatus::GAME) {
+      currentGameStatus = GameStatus::GAME_OVER;
+      gameInfo.pause = 1;
+    }
+  }
+}
+
+void TetrisVersus::userInput(UserAction_t action, bool hold) {
+  std::lock_guard<std::mutex> lock(matchMutex);
+  GameStatus status = currentGameStatus;
+  bool isStart = action == UserAction_t::Start &&
+                 status != GameStatus::GAME && status != GameStatus::PAUSE;
+  if (isStart) {
+    startMatch();
+  } else {
+    TetrisLogic::userInput(action, hold);
+    if (!finished) {
+      exchangeGarbage();
+      updateResult();
+    }
+  }
+}
+
+// boards go on after board 0 is out, until match is decided
+void TetrisVersus::gameTick() {
+  std::lock_guard<std::mutex> lock(matchMutex);
+  GameStatus status = currentGameStatus;
+  bool isRunning = !finished && (status == GameStatus::GAME ||
+                                 status == GameStatus::GAME_OVER);
+  if (!isRunning) return;
+
+  playBots();
+  TetrisLogic::gameTick();
+  for (auto& opponent : opponents) {
+    opponent->gameTick();
+  }
+  exchangeGarbage();
+  updateResult();
+  markTick();
+}
+
+bool TetrisVersus::loadState(const GameState_t& state) {
+  (void)state;
+  return false;
+}
+
+std::vector<GameInfo_t> TetrisVersus::getOpponentViews(int width,
+                                                       int height) const {
+  std::lock_guard<std::mutex> lock(matchMutex);
+  std::vector<GameInfo_t> views;
+  for (const auto& opponent : opponents) {
+    views.push_back(opponent->getViewport(width, height));
+  }
+  return views;
+}
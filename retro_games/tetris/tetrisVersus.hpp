@@ -0,0 +1,72 @@
+#ifndef TETRIS_VERSUS_HPP
+#define TETRIS_VERSUS_HPP
+
+#include <memory>
+#include <vector>
+
+#include "../gameBot.hpp"
+#include "tetrisLogic.hpp"
+
+namespace s21 {
+
+#define MAX_VERSUS_BOARDS 8
+#define VERSUS_BOT_ACTIONS 4  // actions of each bot on one tick
+
+// Match of several Tetris boards: board 0 is the game itself, the others
+// are opponents owned by match. All boards get the same pieces and fall on
+// the same tick, so match goes in lockstep on one thread. Lines cleared on
+// a board go as garbage to the next board in play: 2 lines give 1 row,
+// 3 give 2, 4 give 4; hole of garbage is taken from random of match.
+// Boards with bot are played by it on tick. Opponents get TetrisBot, board
+// 0 is played by user unless setBot gives it a bot too, then match runs
+// headless by gameTick alone. Match ends when at most one board is in play
+// or a board wins by level; board 0 gets WIN if it is the winner.
+// Match is not restored from board 0, loadState fails.
+class TetrisVersus : public TetrisLogic {
+ public:
+  // boards from 2 to MAX_VERSUS_BOARDS
+  explicit TetrisVersus(int boards, int width = FIELD_WIDTH,
+                        int height = FIELD_HEIGHT);
+  ~TetrisVersus();
+  void userInput(UserAction_t action, bool hold) override;
+  void gameTick() override;
+  bool loadState(const GameState_t& state) override;
+
+  int getBoardsCount() const { return static_cast<int>(bots.size()); }
+  // for the thread owning the game, 0 is this game
+  const TetrisLogic& getBoard(int index) const;
+  // nullptr leaves board to userInput, only board 0 gets it
+  void setBot(int index, std::unique_ptr<GameBot> bot);
+  // rows of garbage board sent to others
+  int getSentLines(int index) const { return sentLines[index]; }
+  // lines board cleared in match
+  int getLinesCleared(int index) const { return linesCleared[index]; }
+  bool isFinished() const { return finished; }
+  // board which won finished match, -1 for draw or while match goes
+  int getWinner() const { return winner; }
+  // copies of opponent boards by window of width x height, board out of
+  // match has pause set
+  std::vector<GameInfo_t> getOpponentViews(int width, int height) const;
+
+ protected:
+  class Opponent;
+
+  TetrisLogic& board(int index);
+  void startMatch();
+  void playBots();
+  void exchangeGarbage();
+  void updateResult();
+
+  std::vector<std::unique_ptr<TetrisLogic>> opponents;
+  std::vector<std::unique_ptr<GameBot>> bots;
+  std::vector<int> sentLines;
+  std::vector<int> linesCleared;
+  RandomGenerator garbageRandom;
+  int winner = -1;
+  bool finished = true;
+  // input and tick may come from different threads
+  mutable std::mutex matchMutex;
+};
+}  // namespace s21
+
+#endif  // TETRIS_VERSUS_HPP
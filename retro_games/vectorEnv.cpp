@@ -0,0 +1,168 @@
+#include "vectorEnv.hpp"
+
+#include <algorithm>
+
+using namespace s21;
+
+// calls are qualified with Game:: so they are not virtual
+
+template <class Game>
+static void restart(Game& game) {
+  if (game.getCurrentGameStatus() == GameStatus::PAUSE) {
+    game.Game::userInput(UserAction_t::Pause, false);
+  }
+  if (game.getCurrentGameStatus() == GameStatus::GAME) {
+    game.Game::userInput(UserAction_t::Terminate, false);
+  }
+  game.Game::userInput(UserAction_t::Start, false);
+}
+
+static bool isMove(UserAction_t action) {
+  return action >= UserAction_t::Left && action <= UserAction_t::HardDrop;
+}
+
+template <class Game>
+VectorEnv<Game>::VectorEnv(int size, int threads)
+    : count(size),
+      games(new Game[size]),
+      rewards(new int32_t[size]()),
+      dones(new uint8_t[size]()) {
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  this->threads = std::max(1, std::min(threads, size));
+  // restarts would wait for file of high scores one by one
+  for (int i = 0; i < size; i++) {
+    games[i].setSavesHighScore(false);
+  }
+  // calling thread is worker 0
+  for (int i = 1; i < this->threads; i++) {
+    workers.emplace_back(&VectorEnv::workerLoop, this, i);
+  }
+}
+
+template <class Game>
+VectorEnv<Game>::~VectorEnv() {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    stopping = true;
+  }
+  poolWakeUp.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+template <class Game>
+void VectorEnv<Game>::runRange(Task task, int worker) {
+  int begin = static_cast<int>(static_cast<int64_t>(count) * worker / threads);
+  int end =
+      static_cast<int>(static_cast<int64_t>(count) * (worker + 1) / threads);
+  (this->*task)(begin, end);
+}
+
+template <class Game>
+void VectorEnv<Game>::workerLoop(int worker) {
+  uint64_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(poolMutex);
+  while (true) {
+    poolWakeUp.wait(lock, [&]() {
+      return stopping || generation != seenGeneration;
+    });
+    if (stopping) break;
+    seenGeneration = generation;
+
+    lock.unlock();
+    runRange(task, worker);
+    lock.lock();
+    if (--busyWorkers == 0) {
+      poolDone.notify_one();
+    }
+  }
+}
+
+// each worker takes the same games every time, they stay in its cache
+template <class Game>
+void VectorEnv<Game>::run(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    this->task = task;
+    generation++;
+    busyWorkers = static_cast<int>(workers.size());
+  }
+  poolWakeUp.notify_all();
+  runRange(task, 0);
+  {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    poolDone.wait(lock, [this]() { return busyWorkers == 0; });
+  }
+}
+
+template <class Game>
+void VectorEnv<Game>::resetRange(int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    games[i].setSeed(seeds[i]);
+    restart(games[i]);
+    rewards[i] = 0;
+    dones[i] = 0;
+  }
+}
+
+template <class Game>
+void VectorEnv<Game>::stepRange(int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    Game& game = games[i];
+    int score = game.getGameInfo().score;
+    uint64_t ticks = game.getTickCount();
+    if (isMove(actions[i])) {
+      game.Game::userInput(actions[i], false);
+    }
+    if (game.getTickCount() == ticks) {
+      game.Game::gameTick();
+    }
+
+    GameStatus status = game.getCurrentGameStatus();
+    rewards[i] = game.getGameInfo().score - score;
+    dones[i] = status == GameStatus::GAME_OVER || status == GameStatus::WIN;
+    if (dones[i]) {
+      restart(game);
+    }
+  }
+}
+
+template <class Game>
+void VectorEnv<Game>::observeRange(int begin, int end) {
+  for (int i = begin; i < end; i++) {
+    const Game& game = games[i];
+    int** field = game.getGameInfo().field;
+    uint8_t* plane = observations + i * FIELD_HEIGHT * FIELD_WIDTH;
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        plane[y * FIELD_WIDTH + x] = game.observedCell(field[y][x]);
+      }
+    }
+  }
+}
+
+template <class Game>
+void VectorEnv<Game>::reset(const uint64_t* seeds) {
+  this->seeds = seeds;
+  run(&VectorEnv::resetRange);
+}
+
+template <class Game>
+void VectorEnv<Game>::step(const UserAction_t* actions) {
+  this->actions = actions;
+  run(&VectorEnv::stepRange);
+}
+
+template <class Game>
+void VectorEnv<Game>::observe(uint8_t* observations) {
+  this->observations = observations;
+  run(&VectorEnv::observeRange);
+}
+
+namespace s21 {
+template class VectorEnv<TetrisLogic>;
+template class VectorEnv<SnakeLogic>;
+}  // namespace s21
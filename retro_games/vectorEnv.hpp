@@ -0,0 +1,75 @@
+#ifndef VECTOR_ENV_HPP
+#define VECTOR_ENV_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "snake/snakeLogic.hpp"
+#include "tetris/tetrisLogic.hpp"
+
+namespace s21 {
+
+// Batch of games of one type stepped together, for training of agents.
+// Games are kept by value and called without virtual dispatch, batch is
+// split between persistent threads. Arrays are indexed by game:
+//   observations  uint8_t[size][FIELD_HEIGHT][FIELD_WIDTH], field values
+//   rewards       int32_t[size], score got by last step
+//   dones         uint8_t[size], game ended by last step
+// Ended game is started again in the same step, so its observation is the
+// first frame of the new game. High scores of games are not read from or
+// written to storage of player.
+template <class Game>
+class VectorEnv {
+ public:
+  // threads <= 0 takes number of cores
+  explicit VectorEnv(int size, int threads = 0);
+  ~VectorEnv();
+
+  int size() const { return count; }
+  // new game in every env, seeds[size]
+  void reset(const uint64_t* seeds);
+  // Left..HardDrop are moves of player, other actions are no input. The
+  // game ticks after move, unless the move itself was a tick (snake moves,
+  // piece goes down).
+  void step(const UserAction_t* actions);
+  void observe(uint8_t* observations);
+  const int32_t* getRewards() const { return rewards.get(); }
+  const uint8_t* getDones() const { return dones.get(); }
+  const Game& getGame(int index) const { return games[index]; }
+
+ private:
+  using Task = void (VectorEnv::*)(int begin, int end);
+  void run(Task task);
+  void runRange(Task task, int worker);
+  void workerLoop(int worker);
+  void resetRange(int begin, int end);
+  void stepRange(int begin, int end);
+  void observeRange(int begin, int end);
+
+  int count;
+  std::unique_ptr<Game[]> games;
+  std::unique_ptr<int32_t[]> rewards;
+  std::unique_ptr<uint8_t[]> dones;
+  // arguments of current task
+  const uint64_t* seeds = nullptr;
+  const UserAction_t* actions = nullptr;
+  uint8_t* observations = nullptr;
+
+  int threads;
+  std::vector<std::thread> workers;
+  std::mutex poolMutex;
+  std::condition_variable poolWakeUp;
+  std::condition_variable poolDone;
+  Task task = nullptr;
+  uint64_t generation = 0;
+  int busyWorkers = 0;
+  bool stopping = false;
+};
+
+extern template class VectorEnv<TetrisLogic>;
+extern template class VectorEnv<SnakeLogic>;
+}  // namespace s21
+
+#endif  // VECTOR_ENV_HPP
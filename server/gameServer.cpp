@@ -0,0 +1,400 @@
+#include "gameServer.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include "../gui/gameView.hpp"
+#include "../retro_games/gameEngine.hpp"
+
+using namespace s21;
+using namespace std::chrono;
+
+// epoll user data of service descriptors, sessions have id >= FIRST_SESSION
+enum : uint64_t { LISTEN_ID, WAKE_ID, FIRST_SESSION };
+
+#define MAX_EVENTS 64
+
+//
+// ============================================================================
+// Remote view of session, renders frames to client socket
+// ============================================================================
+
+class SessionView : public GameView {
+ public:
+  explicit SessionView(int fd) : fd(fd) {}
+
+  void render(const GameInfo_t& gameInfo, GameStatus gameStatus,
+              GameType gameType) override {
+    latest.type = static_cast<uint8_t>(MessageType::FRAME);
+    packFrame(gameInfo, gameStatus, gameType, latest.frame);
+    latest.frame.number = ++frameNumber;
+    hasLatest = true;
+    if (!flush()) {
+      failed = true;
+    }
+  }
+
+  GameType selectGame() override { return requestedGame; }
+
+  void requestGame(GameType gameType) { requestedGame = gameType; }
+
+  // send frame in flight, slow client gets only the latest frame
+  bool flush() {
+    bool isOk = true;
+    while (isOk) {
+      if (sent == sizeof(outgoing)) {
+        if (!hasLatest) break;
+        outgoing = latest;
+        hasLatest = false;
+        sent = 0;
+      }
+      ssize_t count =
+          send(fd, reinterpret_cast<char*>(&outgoing) + sent,
+               sizeof(outgoing) - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (count > 0) {
+        sent += count;
+      } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      } else {
+        isOk = false;
+      }
+    }
+    return isOk;
+  }
+
+  bool isBlocked() const { return sent != sizeof(outgoing); }
+  bool isFailed() const { return failed; }
+
+ private:
+  int fd;
+  GameType requestedGame = GameType::NONE;
+  ServerMessage outgoing = {};
+  ServerMessage latest = {};
+  size_t sent = sizeof(ServerMessage);
+  bool hasLatest = false;
+  bool failed = false;
+  uint32_t frameNumber = 0;
+};
+
+//
+// ============================================================================
+// Session and worker state
+// ============================================================================
+
+struct Session {
+  uint64_t id;
+  int fd;
+  SessionView view;
+  GameType gameType = GameType::NONE;
+  GameEngine model;  // no game before HELLO
+  steady_clock::time_point nextTick;
+  ClientMessage message = {};
+  size_t received = 0;
+  bool watchOutput = false;
+
+  Session(uint64_t id, int fd) : id(id), fd(fd), view(fd) {}
+};
+
+struct TickEntry {
+  steady_clock::time_point deadline;
+  uint64_t id;
+
+  bool operator>(const TickEntry& rhs) const {
+    return deadline > rhs.deadline;
+  }
+};
+
+struct GameServer::Worker {
+  std::thread thread;
+  int epollFd = -1;
+  int wakeFd = -1;
+  uint64_t nextId = FIRST_SESSION;
+  std::unordered_map<uint64_t, std::unique_ptr<Session>> sessions;
+  std::priority_queue<TickEntry, std::vector<TickEntry>,
+                      std::greater<TickEntry>>
+      ticks;
+};
+
+//
+// ============================================================================
+// Functions for processing sessions
+// ============================================================================
+
+// send current state to client, returns speed of game for next tick
+static int renderSession(Session& session) {
+  const GameInfo_t& gameInfo = session.model.getGameInfo();
+  session.view.render(gameInfo, session.model.getCurrentGameStatus(),
+                      session.gameType);
+  return gameInfo.speed;
+}
+
+// wait writable socket only while client does not read frames
+static void updateInterest(int epollFd, Session& session) {
+  bool blocked = session.view.isBlocked();
+  if (blocked != session.watchOutput) {
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    if (blocked) event.events |= EPOLLOUT;
+    event.data.u64 = session.id;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+    session.watchOutput = blocked;
+  }
+}
+
+static void scheduleTick(GameServer::Worker& worker, Session& session,
+                         int speed) {
+  session.nextTick = steady_clock::now() + milliseconds(getDelay(speed));
+  worker.ticks.push({session.nextTick, session.id});
+}
+
+// returns false if session must be closed
+static bool handleMessage(GameServer::Worker& worker, Session& session) {
+  bool isOpen = true;
+  const ClientMessage& msg = session.message;
+  const uint8_t lastAction = static_cast<uint8_t>(UserAction_t::HardDrop);
+
+  switch (static_cast<MessageType>(msg.type)) {
+    case MessageType::HELLO:
+      if (!session.model) {
+        session.view.requestGame(static_cast<GameType>(msg.arg));
+        session.gameType = session.view.selectGame();
+        session.model.reset(session.gameType);
+        isOpen = static_cast<bool>(session.model);
+        if (isOpen) {
+          // file of high scores would hold up all sessions of this thread
+          session.model.get()->setSavesHighScore(false);
+          scheduleTick(worker, session, renderSession(session));
+        }
+      }
+      break;
+    case MessageType::INPUT:
+      if (session.model && msg.arg <= lastAction) {
+        UserAction_t action = static_cast<UserAction_t>(msg.arg);
+        GameStatus gameStatus = session.model.getCurrentGameStatus();
+        if (gameStatus == GameStatus::INIT &&
+            action == UserAction_t::Terminate) {
+          isOpen = false;
+        } else {
+          session.model.userInput(action, msg.hold != 0);
+          renderSession(session);
+        }
+      }
+      break;
+    default:
+      isOpen = false;
+      break;
+  }
+
+  return isOpen && !session.view.isFailed();
+}
+
+static bool readMessages(GameServer::Worker& worker, Session& session) {
+  bool isOpen = true;
+  while (isOpen) {
+    char* buffer = reinterpret_cast<char*>(&session.message);
+    ssize_t count = recv(session.fd, buffer + session.received,
+                         sizeof(session.message) - session.received,
+                         MSG_DONTWAIT);
+    if (count > 0) {
+      session.received += count;
+      if (session.received == sizeof(session.message)) {
+        session.received = 0;
+        isOpen = handleMessage(worker, session);
+      }
+    } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    } else {
+      isOpen = false;  // client closed connection or error
+    }
+  }
+  return isOpen;
+}
+
+//
+// ============================================================================
+// End functions for processing sessions
+// ============================================================================
+
+GameServer::GameServer(const std::string& socketPath, int workersCount)
+    : socketPath(socketPath), workersCount(workersCount) {}
+
+GameServer::~GameServer() { stop(); }
+
+bool GameServer::start() {
+  if (running) return true;
+
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(addr.sun_path)) return false;
+  strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+  listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) return false;
+
+  unlink(socketPath.c_str());
+  if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      listen(listenFd, SOMAXCONN) < 0) {
+    close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+
+  running = true;
+  for (int i = 0; i < std::max(1, workersCount); i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    worker->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    // every worker accepts clients itself, kernel wakes only one of them
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    event.data.u64 = LISTEN_ID;
+    epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_ID;
+    epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFd, &event);
+
+    Worker* workerPtr = worker.get();
+    worker->thread = std::thread([this, workerPtr]() { workerLoop(*workerPtr); });
+    workers.push_back(std::move(worker));
+  }
+
+  return true;
+}
+
+void GameServer::stop() {
+  if (!running) return;
+  running = false;
+
+  for (auto& worker : workers) {
+    uint64_t value = 1;
+    if (write(worker->wakeFd, &value, sizeof(value)) < 0) {
+      // worker wakes up by epoll timeout anyway
+    }
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+    for (auto& [id, session] : worker->sessions) {
+      close(session->fd);
+    }
+    sessionCount -= worker->sessions.size();
+    close(worker->epollFd);
+    close(worker->wakeFd);
+  }
+  workers.clear();
+
+  close(listenFd);
+  listenFd = -1;
+  unlink(socketPath.c_str());
+}
+
+void GameServer::acceptSessions(Worker& worker) {
+  while (true) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) break;
+
+    auto session = std::make_unique<Session>(worker.nextId++, fd);
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.u64 = session->id;
+    if (epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+      close(fd);
+    } else {
+      worker.sessions.emplace(session->id, std::move(session));
+      sessionCount++;
+    }
+  }
+}
+
+void GameServer::closeSession(Worker& worker, uint64_t id) {
+  auto it = worker.sessions.find(id);
+  if (it != worker.sessions.end()) {
+    epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    worker.sessions.erase(it);
+    sessionCount--;
+  }
+}
+
+void GameServer::tickSessions(Worker& worker) {
+  auto now = steady_clock::now();
+  while (!worker.ticks.empty() && worker.ticks.top().deadline <= now) {
+    TickEntry entry = worker.ticks.top();
+    worker.ticks.pop();
+
+    // skip entries of closed sessions and rescheduled ticks
+    auto it = worker.sessions.find(entry.id);
+    if (it == worker.sessions.end() || it->second->nextTick != entry.deadline) {
+      continue;
+    }
+
+    Session& session = *it->second;
+    int speed = 1;
+    if (session.model.getCurrentGameStatus() == GameStatus::GAME) {
+      session.model.gameTick();
+      speed = renderSession(session);
+    } else {
+      speed = session.model.getGameInfo().speed;
+    }
+
+    if (session.view.isFailed()) {
+      closeSession(worker, session.id);
+    } else {
+      updateInterest(worker.epollFd, session);
+      scheduleTick(worker, session, speed);
+    }
+  }
+}
+
+void GameServer::workerLoop(Worker& worker) {
+  epoll_event events[MAX_EVENTS];
+
+  while (running) {
+    int timeout = -1;
+    if (!worker.ticks.empty()) {
+      auto wait = worker.ticks.top().deadline - steady_clock::now();
+      auto waitMs = duration_cast<milliseconds>(wait).count();
+      timeout = waitMs < 0 ? 0 : static_cast<int>(waitMs) + 1;
+    }
+
+    int count = epoll_wait(worker.epollFd, events, MAX_EVENTS, timeout);
+    for (int i = 0; i < count && running; i++) {
+      uint64_t id = events[i].data.u64;
+      if (id == LISTEN_ID) {
+        acceptSessions(worker);
+      } else if (id == WAKE_ID) {
+        uint64_t value;
+        while (read(worker.wakeFd, &value, sizeof(value)) > 0) {
+        }
+      } else {
+        auto it = worker.sessions.find(id);
+        if (it == worker.sessions.end()) continue;
+
+        Session& session = *it->second;
+        bool isOpen = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+        if (isOpen && (events[i].events & EPOLLOUT)) {
+          isOpen = session.view.flush();
+        }
+        if (isOpen && (events[i].events & (EPOLLIN | EPOLLRDHUP))) {
+          isOpen = readMessages(worker, session);
+        }
+
+        if (isOpen) {
+          updateInterest(worker.epollFd, session);
+        } else {
+          closeSession(worker, id);
+        }
+      }
+    }
+
+    tickSessions(worker);
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "protocol.hpp"
+
+namespace s21 {
+// Headless server: every connection on a unix domain socket is a separate
+// game session. Sessions are spread over a small pool of workers, each worker
+// multiplexes its sessions with own epoll instance and ticks them by deadline.
+class GameServer {
+ public:
+  struct Worker;
+
+  explicit GameServer(const std::string& socketPath, int workersCount = 2);
+  ~GameServer();
+
+  bool start();
+  void stop();
+  int getSessionCount() const { return sessionCount; }
+
+ private:
+  void workerLoop(Worker& worker);
+  void acceptSessions(Worker& worker);
+  void closeSession(Worker& worker, uint64_t id);
+  void tickSessions(Worker& worker);
+
+  std::string socketPath;
+  int workersCount;
+  int listenFd = -1;
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::atomic<bool> running = false;
+  std::atomic<int> sessionCount = 0;
+};
+}  // namespace s21
+
+#endif  // GAME_SERVER_HPP
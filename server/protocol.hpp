@@ -0,0 +1,36 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstdint>
+
+#include "../controller/frame.hpp"
+
+namespace s21 {
+// Binary protocol of the game server, host byte order (local socket only).
+//
+// client -> server: fixed 4 byte ClientMessage
+//   HELLO  arg = GameType            create game for this connection
+//   INPUT  arg = UserAction_t, hold  send user action to the game
+//   BYE                              close session
+// server -> client: ServerMessage with FRAME after every state change
+enum class MessageType : uint8_t { HELLO = 1, INPUT, BYE, FRAME };
+
+struct ClientMessage {
+  uint8_t type;
+  uint8_t arg;
+  uint8_t hold;
+  uint8_t reserved;
+};
+
+struct ServerMessage {
+  uint8_t type;
+  uint8_t reserved[3];
+  Frame_t frame;
+};
+
+static_assert(sizeof(ClientMessage) == 4, "ClientMessage must be 4 bytes");
+static_assert(sizeof(ServerMessage) == 4 + sizeof(Frame_t),
+              "ServerMessage must be packed");
+}  // namespace s21
+
+#endif  // PROTOCOL_HPP
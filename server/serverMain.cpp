@@ -0,0 +1,38 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+#include "gameServer.hpp"
+
+using namespace s21;
+
+#define DEFAULT_SOCKET "/tmp/retro_games.sock"
+
+int main(int argc, char** argv) {
+  const char* socketPath = argc > 1 ? argv[1] : DEFAULT_SOCKET;
+  int workersCount = argc > 2 ? atoi(argv[2]) : 0;
+  if (workersCount <= 0) {
+    workersCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // block signals before start workers, main thread waits them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  GameServer server(socketPath, workersCount);
+  if (!server.start()) {
+    std::cerr << "failed to listen socket " << socketPath << std::endl;
+    return 1;
+  }
+  std::cout << "retro games server listen " << socketPath << " with "
+            << workersCount << " workers" << std::endl;
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+  server.stop();
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+#include "testArena.hpp"
+
+#include "../retro_games/snake/snakeBot.hpp"
+
+using namespace s21;
+
+// cells of field by value: free, food, heads and bodies
+static void countCells(const GameLogic& game, int& food, int& heads,
+                       int& bodies) {
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  food = heads = bodies = 0;
+  for (int y = 0; y < gameInfo.height; y++) {
+    for (int x = 0; x < gameInfo.width; x++) {
+      int value = gameInfo.field[y][x];
+      food += value == static_cast<int>(SnakeLogic::Field::FOOD);
+      heads += value >= static_cast<int>(SnakeLogic::Field::HEAD_LEFT) &&
+               value <= static_cast<int>(SnakeLogic::Field::HEAD_DOWN);
+      bodies += value > static_cast<int>(SnakeLogic::Field::HEAD_DOWN);
+    }
+  }
+}
+
+static int totalLength(const SnakeArena& game) {
+  int length = 0;
+  for (int i = 0; i < game.getSnakesCount(); i++) {
+    length += static_cast<int>(game.getSnake(i).length);
+  }
+  return length;
+}
+
+TEST(SnakeArenaGameTest, start) {
+  SnakeArena game(8, 5, 30, 30);
+  game.setSeed(3);
+  EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::INIT);
+  game.userInput(UserAction_t::Start, false);
+  EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::GAME);
+  EXPECT_EQ(game.getSnakesCount(), 8);
+  EXPECT_EQ(game.getAliveCount(), 8);
+
+  int food = 0, heads = 0, bodies = 0;
+  countCells(game, food, heads, bodies);
+  EXPECT_EQ(food, 5);
+  EXPECT_EQ(heads, 8);
+  EXPECT_EQ(bodies, 8 * 3);
+  EXPECT_FALSE(game.getSnake(0).isBot);
+  EXPECT_TRUE(game.getSnake(1).isBot);
+
+  // count of snakes is limited
+  SnakeArena large(1000, 0, 100, 100);
+  EXPECT_EQ(large.getSnakesCount(), MAX_ARENA_SNAKES);
+}
+
+TEST_F(SnakeArenaTest, head_on_same_cell) {
+  startEmpty();
+  placeSnake(1, 5, 10, Direct::RIGHT);
+  placeSnake(2, 7, 10, Direct::LEFT);
+  EXPECT_EQ(getAliveCount(), 4);
+
+  gameTick();
+  EXPECT_FALSE(getSnake(1).isAlive);
+  EXPECT_FALSE(getSnake(2).isAlive);
+  EXPECT_EQ(getAliveCount(), 2);
+  EXPECT_EQ(cell(6, 10), 0);
+  EXPECT_EQ(cell(5, 10), 0);
+  EXPECT_EQ(cell(6, 2), head(Direct::RIGHT));
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME);
+}
+
+TEST_F(SnakeArenaTest, head_on_swap) {
+  startEmpty();
+  placeSnake(1, 5, 10, Direct::RIGHT);
+  placeSnake(2, 6, 10, Direct::DOWN);
+  steer(2, Direct::LEFT);
+
+  gameTick();
+  EXPECT_FALSE(getSnake(1).isAlive);
+  EXPECT_FALSE(getSnake(2).isAlive);
+}
+
+TEST_F(SnakeArenaTest, head_takes_leaving_tail) {
+  startEmpty();
+  placeSnake(2, 10, 5, Direct::UP);  // tail at 10, 8
+  placeSnake(1, 9, 8, Direct::DOWN);
+  steer(1, Direct::RIGHT);
+
+  gameTick();
+  EXPECT_TRUE(getSnake(1).isAlive);
+  EXPECT_TRUE(getSnake(2).isAlive);
+  EXPECT_EQ(cell(10, 8), head(Direct::RIGHT));
+  EXPECT_EQ(cell(10, 4), head(Direct::UP));
+  EXPECT_EQ(getSnake(1).length, 4u);
+}
+
+TEST_F(SnakeArenaTest, head_hits_body) {
+  startEmpty();
+  placeSnake(2, 10, 5, Direct::UP);
+  placeSnake(1, 9, 6, Direct::DOWN);
+  steer(1, Direct::RIGHT);
+
+  gameTick();
+  EXPECT_FALSE(getSnake(1).isAlive);
+  EXPECT_TRUE(getSnake(2).isAlive);
+}
+
+TEST_F(SnakeArenaTest, player_input) {
+  startEmpty();
+
+  // turn does not move, turn back to last move is ignored
+  userInput(UserAction_t::Up, false);
+  EXPECT_EQ(cell(5, 2), head(Direct::UP));
+  userInput(UserAction_t::Left, false);
+  EXPECT_EQ(cell(5, 2), head(Direct::UP));
+
+  // action moves all snakes
+  userInput(UserAction_t::Action, false);
+  EXPECT_EQ(cell(5, 1), head(Direct::UP));
+  EXPECT_EQ(cell(6, 17), head(Direct::RIGHT));
+
+  userInput(UserAction_t::Pause, false);
+  userInput(UserAction_t::Action, false);
+  EXPECT_EQ(cell(5, 1), head(Direct::UP));
+  userInput(UserAction_t::Pause, false);
+
+  // player at wall loses
+  userInput(UserAction_t::Action, false);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME);
+  userInput(UserAction_t::Action, false);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME_OVER);
+}
+
+TEST_F(SnakeArenaTest, last_snake_wins) {
+  startEmpty();
+  removeSnake(3);
+  placeSnake(1, 15, 10, Direct::RIGHT);
+  gameTick();
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME);
+
+  // snake 1 goes to wall
+  for (int i = 0; i < 20 && getSnake(1).isAlive; i++) {
+    gameTick();
+  }
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::WIN);
+}
+
+TEST(SnakeArenaGameTest, same_seed_same_game) {
+  SnakeArena first(16, 8, 40, 40);
+  SnakeArena second(16, 8, 40, 40);
+  for (SnakeArena* game : {&first, &second}) {
+    game->setSeed(11);
+    game->setBot(0, true);
+    game->userInput(UserAction_t::Start, false);
+    for (int i = 0; i < 500; i++) {
+      game->gameTick();
+    }
+  }
+  EXPECT_EQ(first.getHash(), second.getHash());
+  EXPECT_TRUE(first.getGameInfo() == second.getGameInfo());
+  for (int i = 0; i < first.getSnakesCount(); i++) {
+    EXPECT_EQ(first.getSnake(i).score, second.getSnake(i).score);
+  }
+}
+
+TEST(SnakeArenaGameTest, state_is_not_saved) {
+  SnakeArena game(4, 4);
+  game.userInput(UserAction_t::Start, false);
+  GameState_t state;
+  game.saveState(state);
+  EXPECT_NE(state.magic, static_cast<uint32_t>(STATE_MAGIC));
+  EXPECT_FALSE(game.loadState(state));
+
+  SnakeBot bot;
+  UserAction_t action;
+  EXPECT_FALSE(bot.nextAction(game, action));
+}
+
+TEST(SnakeArenaGameTest, many_snakes_ticks) {
+  // dozens of bots, grid stays the same as snakes and food
+  SnakeArena game(48, 48, 200, 200);
+  game.setSeed(5);
+  game.setBot(0, true);
+  game.userInput(UserAction_t::Start, false);
+  EXPECT_EQ(game.getAliveCount(), 48);
+
+  const int ticks = 5000;
+  int done = 0;
+  for (; done < ticks && game.getCurrentGameStatus() == GameStatus::GAME;
+       done++) {
+    game.gameTick();
+  }
+  int score = 0;
+  for (int i = 0; i < game.getSnakesCount(); i++) {
+    score += game.getSnake(i).score;
+  }
+
+  int food = 0, heads = 0, bodies = 0;
+  countCells(game, food, heads, bodies);
+  EXPECT_GT(score, 0);
+  EXPECT_EQ(food, 48);
+  EXPECT_EQ(heads, game.getAliveCount());
+  EXPECT_EQ(heads + bodies, totalLength(game));
+}
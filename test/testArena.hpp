@@ -0,0 +1,37 @@
+#ifndef TEST_ARENA_HPP
+#define TEST_ARENA_HPP
+
+#include <gtest/gtest.h>
+
+#include "../retro_games/snake/snakeArena.hpp"
+
+namespace s21 {
+
+// arena 20x20 of 4 snakes without food, snakes are placed by test
+class SnakeArenaTest : public ::testing::Test, public SnakeArena {
+ protected:
+  SnakeArenaTest() : SnakeArena(4, 0, 20, 20) {}
+
+  // started game with player at top and snake 3 at bottom, both go right;
+  // snakes 1 and 2 are removed and all snakes are steered by test
+  void startEmpty() {
+    setSeed(1);
+    userInput(UserAction_t::Start, false);
+    for (int i = 0; i < getSnakesCount(); i++) {
+      removeSnake(i);
+      setBot(i, false);
+    }
+    placeSnake(0, 5, 2, Direct::RIGHT);
+    placeSnake(3, 5, 17, Direct::RIGHT);
+  }
+
+  int cell(int x, int y) const { return getGameInfo().field[y][x]; }
+
+  static int head(Direct direct) {
+    return static_cast<int>(Field::HEAD_LEFT) + static_cast<int>(direct);
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_ARENA_HPP
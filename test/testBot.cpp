@@ -0,0 +1,140 @@
+#include "testBot.hpp"
+
+using namespace s21;
+
+TEST_F(TetrisBotTest, rotations) {
+  TetrisBot::Piece rotations[4];
+  EXPECT_EQ(TetrisBot::getRotations(stick(), rotations), 2);
+  EXPECT_EQ(rotations[1].width, 4);
+  EXPECT_EQ(rotations[1].rows[0], 0xF);
+  EXPECT_EQ(TetrisBot::getRotations(square(), rotations), 1);
+}
+
+TEST_F(TetrisBotTest, evaluate) {
+  TetrisBot bot(1);
+  TetrisBot::Board board = {};
+  EXPECT_EQ(bot.evaluate(board, 0), 0);
+
+  TetrisBot::Board holes = {};
+  holes[FIELD_HEIGHT - 2] = 0x3FF;
+  TetrisBot::Board flat = {};
+  flat[FIELD_HEIGHT - 1] = 0x3FF;
+  flat[FIELD_HEIGHT - 2] = 0x1FF;
+  EXPECT_LT(bot.evaluate(holes, 0), bot.evaluate(flat, 0));
+  EXPECT_GT(bot.evaluate(board, 1), bot.evaluate(board, 0));
+}
+
+TEST_F(TetrisBotTest, fills_well) {
+  TetrisBot bot(2);
+  TetrisBot::Board board = {};
+  for (int y = FIELD_HEIGHT - 4; y < FIELD_HEIGHT; y++) {
+    board[y] = 0x1FF;  // all columns but the last one
+  }
+
+  TetrisBot::Placement placement = bot.findPlacement(board, stick(), square());
+  EXPECT_EQ(placement.x, FIELD_WIDTH - 1);
+  EXPECT_EQ(placement.piece.width, 1);
+}
+
+TEST_F(TetrisBotTest, same_moves_with_threads) {
+  TetrisBot single(1);
+  TetrisBot parallel(4);
+  TetrisLogic first;
+  TetrisLogic second;
+  first.setSeed(5);
+  second.setSeed(5);
+
+  play(single, first, 2000);
+  play(parallel, second, 2000);
+
+  GameState_t a, b;
+  first.saveState(a);
+  second.saveState(b);
+  EXPECT_EQ(memcmp(&a, &b, sizeof(GameState_t)), 0);
+}
+
+TEST_F(TetrisBotTest, headless_game) {
+  TetrisBot bot;
+  TetrisLogic game;
+  game.setSeed(11);
+  const int actions = 20000;
+
+  play(bot, game, actions);
+  EXPECT_GT(game.updateCurrentState().score, 1000);
+}
+
+TEST(SnakeBotTest, soak_game) {
+  SnakeBot bot;
+  SnakeLogic game;
+  game.setSeed(17);
+  UserAction_t action;
+  int games = 0;
+  int bestScore = 0;
+  int actions = 0;
+
+  for (; actions < 20000 && games < 3; actions++) {
+    ASSERT_TRUE(bot.nextAction(game, action));
+    if (action == UserAction_t::Start && actions > 0) games++;
+    game.userInput(action, false);
+    bestScore = std::max(bestScore, game.updateCurrentState().score);
+  }
+  EXPECT_GE(bestScore, 50);
+}
+
+TEST(SnakeBotTest, avoids_trap) {
+  SnakeLogic game;
+  game.userInput(UserAction_t::Start, false);
+  GameState_t state;
+  game.saveState(state);
+  memset(state.field, 0, sizeof(state.field));
+  // head at (1, 1) going left, body goes right, food in corner (0, 0)
+  state.field[1][1] = static_cast<uint8_t>(SnakeLogic::Field::HEAD_LEFT);
+  for (int x = 2; x < 6; x++) {
+    state.field[1][x] = static_cast<uint8_t>(x + 4);
+  }
+  state.field[0][0] = static_cast<uint8_t>(SnakeLogic::Field::FOOD);
+  ASSERT_TRUE(game.loadState(state));
+
+  SnakeBot bot;
+  UserAction_t action;
+  ASSERT_TRUE(bot.nextAction(game, action));
+  EXPECT_TRUE(action == UserAction_t::Left || action == UserAction_t::Up);
+  for (int i = 0; i < 50; i++) {
+    bot.nextAction(game, action);
+    game.userInput(action, false);
+  }
+  EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::GAME);
+  EXPECT_GT(game.updateCurrentState().score, 0);
+}
+
+TEST(SnakeBotTest, hamiltonian_cycle) {
+  SnakeBot bot(SnakeBot::Mode::CYCLE);
+  std::vector<bool> isVisited(SNAKE_CELLS, false);
+  for (int i = 0; i < SNAKE_CELLS; i++) {
+    int cell = bot.getCycleCell(i);
+    int next = bot.getCycleCell((i + 1) % SNAKE_CELLS);
+    int dx = std::abs(cell % FIELD_WIDTH - next % FIELD_WIDTH);
+    int dy = std::abs(cell / FIELD_WIDTH - next / FIELD_WIDTH);
+    EXPECT_EQ(dx + dy, 1) << "cells " << cell << " and " << next;
+    EXPECT_FALSE(isVisited[cell]);
+    isVisited[cell] = true;
+  }
+}
+
+TEST(SnakeBotTest, solver_fills_field) {
+  for (uint64_t seed = 1; seed <= 5; seed++) {
+    SnakeBot bot(SnakeBot::Mode::CYCLE);
+    SnakeLogic game;
+    game.setSeed(seed);
+    UserAction_t action;
+    game.userInput(UserAction_t::Start, false);
+
+    for (int moves = 0; moves < 100000 &&
+                        game.getCurrentGameStatus() == GameStatus::GAME;
+         moves++) {
+      ASSERT_TRUE(bot.nextAction(game, action));
+      game.userInput(action, false);
+    }
+    EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::WIN);
+  }
+}
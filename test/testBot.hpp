@@ -0,0 +1,51 @@
+#ifndef TEST_BOT_HPP
+#define TEST_BOT_HPP
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../retro_games/snake/snakeBot.hpp"
+#include "../retro_games/snake/snakeLogic.hpp"
+#include "../retro_games/tetris/tetrisBot.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+
+namespace s21 {
+
+class TetrisBotTest : public ::testing::Test {
+ protected:
+  static TetrisBot::Piece stick() {
+    GameState_t::Shape_t shape = {};
+    for (int i = 0; i < 4; i++) {
+      shape.grid[i][0] = 1;
+    }
+    shape.width = 1;
+    shape.height = 4;
+    return TetrisBot::makePiece(shape);
+  }
+
+  static TetrisBot::Piece square() {
+    GameState_t::Shape_t shape = {};
+    shape.grid[0][0] = shape.grid[0][1] = 1;
+    shape.grid[1][0] = shape.grid[1][1] = 1;
+    shape.width = 2;
+    shape.height = 2;
+    return TetrisBot::makePiece(shape);
+  }
+
+  // plays game by bot, returns count of actions
+  static int play(TetrisBot& bot, TetrisLogic& game, int actions) {
+    int count = 0;
+    UserAction_t action;
+    while (count < actions && bot.nextAction(game, action)) {
+      if (action == UserAction_t::Start && count > 0) break;  // game over
+      game.userInput(action, false);
+      count++;
+    }
+    return count;
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_BOT_HPP
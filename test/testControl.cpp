@@ -0,0 +1,105 @@
+#include "testControl.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace s21;
+
+TEST_F(ControlChannelTest, round_trip) {
+  ControlChannel channel;
+  ControlClient client;
+  EXPECT_FALSE(client.open(name));
+  ASSERT_TRUE(channel.open(name, 4));
+  ASSERT_TRUE(client.open(name));
+
+  uint32_t sequence;
+  ASSERT_TRUE(client.send(UserAction_t::Left, true, sequence));
+  EXPECT_EQ(sequence, 0u);
+  ControlCommand command;
+  ASSERT_TRUE(channel.poll(command));
+  EXPECT_FALSE(channel.poll(command));
+  EXPECT_EQ(command.sequence, sequence);
+  EXPECT_EQ(command.action, static_cast<uint8_t>(UserAction_t::Left));
+  EXPECT_EQ(command.hold, 1);
+
+  ControlAck ack = {};
+  EXPECT_FALSE(client.waitAck(sequence, ack, 1000));
+  ack.sequence = command.sequence;
+  ack.version = 7;
+  channel.acknowledge(ack);
+  ControlAck received;
+  ASSERT_TRUE(client.waitAck(sequence, received));
+  EXPECT_EQ(received.version, 7u);
+}
+
+TEST_F(ControlChannelTest, full_queue) {
+  ControlChannel channel;
+  ControlClient client;
+  ASSERT_TRUE(channel.open(name, 4));
+  ASSERT_TRUE(client.open(name));
+
+  uint32_t sequence;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(client.send(UserAction_t::Down, false, sequence));
+  }
+  EXPECT_FALSE(client.send(UserAction_t::Down, false, sequence));
+  ControlCommand command;
+  ASSERT_TRUE(channel.poll(command));
+  EXPECT_TRUE(client.send(UserAction_t::Down, false, sequence));
+  EXPECT_EQ(sequence, 4u);
+}
+
+TEST_F(ControlChannelTest, controller_commands) {
+  ControlClient client;
+  startGame(client);
+
+  uint32_t start, left, unknown;
+  ASSERT_TRUE(client.send(UserAction_t::Start, false, start));
+  ASSERT_TRUE(client.send(UserAction_t::Left, false, left));
+  ASSERT_TRUE(client.send(static_cast<UserAction_t>(200), false, unknown));
+  playCommands();
+
+  ControlAck ack;
+  ASSERT_TRUE(client.waitAck(start, ack));
+  EXPECT_EQ(ack.status, static_cast<uint8_t>(GameStatus::GAME));
+  EXPECT_EQ(ack.gameType, static_cast<uint8_t>(GameType::TETRIS));
+  EXPECT_EQ(ack.applied, 1);
+  uint64_t version = ack.version;
+  ASSERT_TRUE(client.waitAck(left, ack));
+  EXPECT_EQ(ack.version, version + 1);
+  ASSERT_TRUE(client.waitAck(unknown, ack));
+  EXPECT_EQ(ack.applied, 0);
+  EXPECT_EQ(ack.version, version + 1);
+}
+
+// loop of controller applies each command and acks it
+TEST_F(ControlChannelTest, round_trip_from_loop) {
+  ControlClient client;
+  startGame(client);
+  std::atomic<bool> isRunning = true;
+  std::thread loop([this, &isRunning]() {
+    while (isRunning) {
+      waitLoop();
+      playCommands();
+    }
+  });
+
+  const int count = 2000;
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right};
+  uint32_t sequence;
+  ControlAck ack;
+  ASSERT_TRUE(client.send(UserAction_t::Start, false, sequence));
+  ASSERT_TRUE(client.waitAck(sequence, ack));
+  uint64_t version = ack.version;
+
+  for (int i = 0; i < count; i++) {
+    ASSERT_TRUE(client.send(actions[i % 2], false, sequence));
+    ASSERT_TRUE(client.waitAck(sequence, ack));
+    EXPECT_EQ(ack.sequence, sequence);
+    EXPECT_EQ(ack.applied, 1);
+  }
+  isRunning = false;
+  loop.join();
+  EXPECT_EQ(ack.version, version + count);
+  EXPECT_EQ(ack.status, static_cast<uint8_t>(GameStatus::GAME));
+}
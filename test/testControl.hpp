@@ -0,0 +1,41 @@
+#ifndef TEST_CONTROL_HPP
+#define TEST_CONTROL_HPP
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "../controller/gameController.hpp"
+
+namespace s21 {
+
+class SilentView : public GameView {
+ public:
+  void render(const GameInfo_t&, GameStatus, GameType) override {}
+  GameType selectGame() override { return GameType::NONE; }
+};
+
+class ControlChannelTest : public ::testing::Test, public GameController {
+ protected:
+  void SetUp() override {
+    name = "/retro_games_control_" + std::to_string(getpid());
+    setView(std::make_unique<SilentView>());
+  }
+
+  // controller with tetris and channel opened by client
+  void startGame(ControlClient& client) {
+    auto channel = std::make_unique<ControlChannel>();
+    ASSERT_TRUE(channel->open(name));
+    setControl(std::move(channel));
+    ASSERT_TRUE(client.open(name));
+    gameType = GameType::TETRIS;
+    model = createGame(gameType);
+  }
+
+  std::string name;
+};
+
+}  // namespace s21
+
+#endif  // TEST_CONTROL_HPP
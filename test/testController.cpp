@@ -202,3 +202,70 @@ TEST_F(GameControllerTest, sendInput) {
     controllerThread.join();
   }
 }
+
+TEST_F(GameControllerTest, arenaOption) {
+  std::string args[] = {"game", "--no-journal", "--arena", "6"};
+  char* argv[] = {args[0].data(), args[1].data(), args[2].data(),
+                  args[3].data()};
+  EXPECT_TRUE(applyOptions(4, argv));
+  auto game = createGame(GameType::SNAKE);
+  auto* arena = dynamic_cast<SnakeArena*>(game.get());
+  ASSERT_NE(arena, nullptr);
+  EXPECT_EQ(arena->getSnakesCount(), 6);
+  EXPECT_NE(dynamic_cast<TetrisLogic*>(createGame(GameType::TETRIS).get()),
+            nullptr);
+
+  args[3] = "1";
+  argv[3] = args[3].data();
+  EXPECT_FALSE(applyOptions(4, argv));
+}
+
+TEST_F(GameControllerTest, versusOption) {
+  std::string args[] = {"game", "--versus", "3"};
+  char* argv[] = {args[0].data(), args[1].data(), args[2].data()};
+  EXPECT_TRUE(applyOptions(3, argv));
+  EXPECT_EQ(journal, nullptr);
+  model = createGame(GameType::TETRIS);
+  ASSERT_NE(getVersus(), nullptr);
+  EXPECT_EQ(getVersus()->getBoardsCount(), 3);
+  renderFrame(viewState(), model->getCurrentGameStatus());
+  EXPECT_EQ(mockView->opponents, 2);
+  model = createGame(GameType::SNAKE);
+  EXPECT_EQ(getVersus(), nullptr);
+
+  args[2] = "9";
+  argv[2] = args[2].data();
+  EXPECT_FALSE(applyOptions(3, argv));
+}
+
+TEST_F(GameControllerTest, previewOption) {
+  std::string args[] = {"game", "--no-journal", "--preview", "4"};
+  char* argv[] = {args[0].data(), args[1].data(), args[2].data(),
+                  args[3].data()};
+  EXPECT_TRUE(applyOptions(4, argv));
+  model = createGame(GameType::TETRIS);
+  gameType = GameType::TETRIS;
+  model->userInput(UserAction_t::Start, false);
+  renderFrame(viewState(), model->getCurrentGameStatus());
+  // next piece is shown by field of next
+  EXPECT_EQ(mockView->preview, 3);
+
+  args[3] = "7";
+  argv[3] = args[3].data();
+  EXPECT_FALSE(applyOptions(4, argv));
+}
+
+TEST_F(GameControllerTest, autoplayOption) {
+  std::string args[] = {"game", "--no-journal", "--board", "12x24",
+                        "--autoplay"};
+  char* argv[] = {args[0].data(), args[1].data(), args[2].data(),
+                  args[3].data(), args[4].data()};
+  EXPECT_FALSE(applyOptions(5, argv));
+  args[4] = "--solver";
+  argv[4] = args[4].data();
+  EXPECT_FALSE(applyOptions(5, argv));
+
+  args[3] = "10x20";
+  argv[3] = args[3].data();
+  EXPECT_TRUE(applyOptions(5, argv));
+}
@@ -17,10 +17,21 @@ class MockGameView : public GameView {
       return;
   }
 
+  void renderOpponents(const std::vector<GameInfo_t>& boards) override {
+    opponents = static_cast<int>(boards.size());
+  }
+
+  void renderPreview(const std::vector<PieceGrid>& pieces) override {
+    preview = static_cast<int>(pieces.size());
+  }
+
   GameType selectGame() override { return currentGameType; }
 
   void setCurrentGameType(GameType gameType) { currentGameType = gameType; }
 
+  int opponents = 0;  // boards of last renderOpponents
+  int preview = 0;    // pieces of last renderPreview
+
  private:
   GameType currentGameType;
 };
@@ -0,0 +1,55 @@
+#include "testEngine.hpp"
+
+#include <cstring>
+
+using namespace s21;
+
+TEST_F(GameEngineTest, types) {
+  GameEngine engine;
+  EXPECT_FALSE(engine);
+  EXPECT_EQ(engine.getType(), GameType::NONE);
+  EXPECT_EQ(engine.get(), nullptr);
+  // calls without game do nothing
+  engine.gameTick();
+  engine.userInput(UserAction_t::Start, false);
+  GameState_t state = {};
+  EXPECT_FALSE(engine.loadState(state));
+
+  engine.reset(GameType::TETRIS);
+  EXPECT_TRUE(engine);
+  EXPECT_EQ(engine.getType(), GameType::TETRIS);
+  EXPECT_NE(dynamic_cast<TetrisLogic*>(engine.get()), nullptr);
+  engine.reset(GameType::SNAKE, 30, 40);
+  EXPECT_EQ(engine.getType(), GameType::SNAKE);
+  EXPECT_NE(dynamic_cast<SnakeLogic*>(engine.get()), nullptr);
+  EXPECT_EQ(engine.getGameInfo().width, 30);
+  EXPECT_EQ(engine.getGameInfo().height, 40);
+  engine.reset(GameType::NONE);
+  EXPECT_FALSE(engine);
+}
+
+TEST_F(GameEngineTest, same_as_virtual) {
+  for (GameType type : {GameType::TETRIS, GameType::SNAKE}) {
+    GameEngine engine(type);
+    std::unique_ptr<GameLogic> game = createGame(type);
+    engine.setSeed(5);
+    game->setSeed(5);
+    RandomGenerator random(5);
+
+    for (int i = 0; i < 2000; i++) {
+      playStep(engine, *game, random);
+      GameState_t first, second;
+      engine.saveState(first);
+      game->saveState(second);
+      ASSERT_EQ(memcmp(&first, &second, sizeof(first)), 0) << "step " << i;
+      ASSERT_EQ(engine.getCurrentGameStatus(), game->getCurrentGameStatus());
+    }
+
+    // state goes back into engine
+    GameState_t state;
+    game->saveState(state);
+    GameEngine restored(type);
+    ASSERT_TRUE(restored.loadState(state));
+    EXPECT_EQ(restored.get()->getHash(), game->getHash());
+  }
+}
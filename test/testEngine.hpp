@@ -0,0 +1,47 @@
+#ifndef TEST_ENGINE_HPP
+#define TEST_ENGINE_HPP
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "../retro_games/gameEngine.hpp"
+
+namespace s21 {
+
+class GameEngineTest : public ::testing::Test {
+ protected:
+  void SetUp() override { GameLogic::setHighScoreStorage(false); }
+  void TearDown() override { GameLogic::setHighScoreStorage(true); }
+
+  static std::unique_ptr<GameLogic> createGame(GameType type) {
+    std::unique_ptr<GameLogic> game;
+    if (type == GameType::TETRIS) {
+      game = std::make_unique<TetrisLogic>();
+    } else {
+      game = std::make_unique<SnakeLogic>();
+    }
+    return game;
+  }
+
+  // random move or tick of step, game is started again when it ends
+  static void playStep(GameEngine& engine, GameLogic& game,
+                       RandomGenerator& random) {
+    UserAction_t action = static_cast<UserAction_t>(
+        static_cast<int>(UserAction_t::Left) + random.next(6));
+    if (game.getCurrentGameStatus() != GameStatus::GAME) {
+      action = UserAction_t::Start;
+    }
+    if (random.next(3)) {
+      engine.userInput(action, false);
+      game.userInput(action, false);
+    } else {
+      engine.gameTick();
+      game.gameTick();
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_ENGINE_HPP
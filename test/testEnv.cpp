@@ -0,0 +1,127 @@
+#include "testEnv.hpp"
+
+using namespace s21;
+
+TEST_F(VectorEnvTest, reset_observe) {
+  const int count = 7;
+  VectorEnv<TetrisLogic> env(count, 3);
+  auto seeds = makeSeeds(count);
+  env.reset(seeds.data());
+
+  std::vector<uint8_t> observations(count * FIELD_HEIGHT * FIELD_WIDTH);
+  env.observe(observations.data());
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(env.getGame(i).getCurrentGameStatus(), GameStatus::GAME);
+    EXPECT_EQ(env.getRewards()[i], 0);
+    EXPECT_EQ(env.getDones()[i], 0);
+    int** field = env.getGame(i).getGameInfo().field;
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        // ghost is not observed
+        int cell = field[y][x] == GHOST_CELL ? 0 : field[y][x];
+        EXPECT_EQ(observations[(i * FIELD_HEIGHT + y) * FIELD_WIDTH + x],
+                  cell);
+      }
+    }
+  }
+}
+
+TEST_F(VectorEnvTest, same_steps_with_threads) {
+  const int count = 16;
+  VectorEnv<TetrisLogic> single(count, 1);
+  VectorEnv<TetrisLogic> parallel(count, 4);
+  auto seeds = makeSeeds(count);
+  single.reset(seeds.data());
+  parallel.reset(seeds.data());
+
+  std::vector<UserAction_t> actions(count);
+  std::vector<uint8_t> first(count * FIELD_HEIGHT * FIELD_WIDTH);
+  std::vector<uint8_t> second(first.size());
+  for (int step = 0; step < 300; step++) {
+    makeActions(actions, step);
+    single.step(actions.data());
+    parallel.step(actions.data());
+    single.observe(first.data());
+    parallel.observe(second.data());
+    ASSERT_EQ(first, second) << "step " << step;
+    for (int i = 0; i < count; i++) {
+      ASSERT_EQ(single.getRewards()[i], parallel.getRewards()[i]);
+      ASSERT_EQ(single.getDones()[i], parallel.getDones()[i]);
+    }
+  }
+}
+
+TEST_F(VectorEnvTest, snake_done_restarts) {
+  const int count = 4;
+  VectorEnv<SnakeLogic> env(count, 2);
+  auto seeds = makeSeeds(count);
+  env.reset(seeds.data());
+
+  // snake can go only so far to one side
+  std::vector<UserAction_t> actions(count);
+  std::vector<int> dones(count, 0);
+  for (int step = 0; step < FIELD_HEIGHT + 1; step++) {
+    actions.assign(count, step % 2 ? UserAction_t::Left : UserAction_t::Up);
+    env.step(actions.data());
+    for (int i = 0; i < count; i++) {
+      dones[i] += env.getDones()[i];
+      EXPECT_EQ(env.getGame(i).getCurrentGameStatus(), GameStatus::GAME);
+    }
+  }
+  for (int i = 0; i < count; i++) {
+    EXPECT_GT(dones[i], 0);
+  }
+}
+
+TEST_F(VectorEnvTest, batch_of_games) {
+  const int count = 256;
+  const int steps = 200;
+  VectorEnv<TetrisLogic> env(count);
+  auto seeds = makeSeeds(count);
+  env.reset(seeds.data());
+
+  std::vector<UserAction_t> actions(count);
+  std::vector<uint8_t> observations(count * FIELD_HEIGHT * FIELD_WIDTH);
+  int64_t reward = 0;
+  int dones = 0;
+  for (int step = 0; step < steps; step++) {
+    makeActions(actions, step);
+    env.step(actions.data());
+    env.observe(observations.data());
+    for (int i = 0; i < count; i++) {
+      reward += env.getRewards()[i];
+      dones += env.getDones()[i];
+    }
+  }
+  EXPECT_GE(reward, 0);
+  EXPECT_GT(dones, 0);
+}
+
+TEST_F(VectorEnvTest, tetris_one_tick_per_step) {
+  expectOneTickPerStep<TetrisLogic>();
+}
+
+TEST_F(VectorEnvTest, snake_one_tick_per_step) {
+  expectOneTickPerStep<SnakeLogic>();
+}
+
+// many restarts of batch do not touch scores of player
+TEST_F(VectorEnvTest, high_scores_not_stored) {
+  const int count = 8;
+  std::string scores = readScores();
+  VectorEnv<SnakeLogic> env(count, 2);
+  auto seeds = makeSeeds(count);
+  env.reset(seeds.data());
+
+  std::vector<UserAction_t> actions(count);
+  int dones = 0;
+  for (int step = 0; step < 300; step++) {
+    makeActions(actions, step);
+    env.step(actions.data());
+    for (int i = 0; i < count; i++) {
+      dones += env.getDones()[i];
+    }
+  }
+  EXPECT_GT(dones, 0);
+  EXPECT_EQ(readScores(), scores);
+}
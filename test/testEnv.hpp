@@ -0,0 +1,66 @@
+#ifndef TEST_ENV_HPP
+#define TEST_ENV_HPP
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../retro_games/vectorEnv.hpp"
+
+namespace s21 {
+
+class VectorEnvTest : public ::testing::Test {
+ protected:
+  // content of file of high scores, empty if there is none
+  static std::string readScores() {
+    std::ifstream file(DB_FILE, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), {});
+  }
+
+  static std::vector<uint64_t> makeSeeds(int count) {
+    std::vector<uint64_t> seeds(count);
+    for (int i = 0; i < count; i++) {
+      seeds[i] = 1000 + i;
+    }
+    return seeds;
+  }
+
+  // the same random actions for the same step and game
+  static void makeActions(std::vector<UserAction_t>& actions, int step) {
+    RandomGenerator random(step);
+    for (auto& action : actions) {
+      int move = random.next(6);
+      action = static_cast<UserAction_t>(
+          static_cast<int>(UserAction_t::Left) + move);
+    }
+  }
+
+  // move that was a tick is not followed by another one
+  template <class Game>
+  static void expectOneTickPerStep() {
+    const int count = 8;
+    VectorEnv<Game> env(count, 2);
+    auto seeds = makeSeeds(count);
+    env.reset(seeds.data());
+
+    std::vector<UserAction_t> actions(count);
+    std::vector<uint64_t> ticks(count);
+    for (int step = 0; step < 200; step++) {
+      makeActions(actions, step);
+      for (int i = 0; i < count; i++) {
+        ticks[i] = env.getGame(i).getTickCount();
+      }
+      env.step(actions.data());
+      for (int i = 0; i < count; i++) {
+        EXPECT_EQ(env.getGame(i).getTickCount(), ticks[i] + 1);
+      }
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_ENV_HPP
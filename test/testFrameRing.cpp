@@ -0,0 +1,120 @@
+#include "testFrameRing.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace s21;
+
+TEST_F(FrameRingTest, publish_read) {
+  FrameRing ring;
+  ASSERT_TRUE(ring.open(name, 8));
+  FrameRingReader reader;
+  ASSERT_TRUE(reader.open(name));
+
+  Frame_t frame;
+  EXPECT_EQ(reader.getWritten(), 0u);
+  EXPECT_FALSE(reader.readLatest(frame));
+
+  userInput(UserAction_t::Start, false);
+  ring.publish(gameInfo, GameStatus::GAME, GameType::TETRIS);
+  ASSERT_TRUE(reader.readLatest(frame));
+
+  Frame_t expected;
+  packFrame(gameInfo, GameStatus::GAME, GameType::TETRIS, expected);
+  expected.number = 0;
+  EXPECT_EQ(memcmp(&frame, &expected, sizeof(Frame_t)), 0);
+}
+
+TEST_F(FrameRingTest, overwritten_frames) {
+  FrameRing ring;
+  ASSERT_TRUE(ring.open(name, 4));
+  FrameRingReader reader;
+  ASSERT_TRUE(reader.open(name));
+
+  for (int i = 0; i < 10; i++) {
+    fillInfo(i);
+    ring.publish(gameInfo, GameStatus::GAME, GameType::TETRIS);
+  }
+
+  Frame_t frame;
+  EXPECT_EQ(reader.getWritten(), 10u);
+  EXPECT_FALSE(reader.read(5, frame));
+  EXPECT_FALSE(reader.read(10, frame));
+  for (uint64_t number = 6; number < 10; number++) {
+    ASSERT_TRUE(reader.read(number, frame));
+    EXPECT_EQ(frame.number, number);
+    EXPECT_EQ(frame.score, static_cast<int>(number));
+  }
+}
+
+TEST_F(FrameRingTest, closed_ring) {
+  FrameRingReader reader;
+  EXPECT_FALSE(reader.open(name));
+  {
+    FrameRing ring;
+    ASSERT_TRUE(ring.open(name));
+  }
+  // object is removed with writer
+  EXPECT_FALSE(reader.open(name));
+}
+
+TEST_F(FrameRingTest, no_torn_frames) {
+  FrameRing ring;
+  ASSERT_TRUE(ring.open(name, 2));
+  FrameRingReader reader;
+  ASSERT_TRUE(reader.open(name));
+  std::atomic<bool> isWriting = true;
+
+  std::thread writer([&]() {
+    for (int i = 0; i < 200000; i++) {
+      fillInfo(i);
+      ring.publish(gameInfo, GameStatus::GAME, GameType::TETRIS);
+    }
+    isWriting = false;
+  });
+
+  int reads = 0;
+  Frame_t frame;
+  while (isWriting) {
+    if (reader.readLatest(frame)) {
+      ASSERT_TRUE(isConsistent(frame)) << "frame " << frame.number;
+      reads++;
+    }
+  }
+  writer.join();
+  EXPECT_GT(reads, 0);
+}
+
+// input thread and game loop both publish frames
+TEST_F(FrameRingTest, two_writers) {
+  FrameRing ring;
+  ASSERT_TRUE(ring.open(name, 2));
+  FrameRingReader reader;
+  ASSERT_TRUE(reader.open(name));
+  TetrisLogic other;
+  std::atomic<int> writing = 2;
+
+  auto write = [&](GameInfo_t info, int first) {
+    for (int i = first; i < 200000; i += 2) {
+      fillInfo(info, i);
+      ring.publish(info, GameStatus::GAME, GameType::TETRIS);
+    }
+    writing--;
+  };
+  std::thread even(write, gameInfo, 0);
+  std::thread odd(write, other.updateCurrentState(), 1);
+
+  int reads = 0;
+  Frame_t frame;
+  while (writing > 0) {
+    if (reader.readLatest(frame)) {
+      ASSERT_TRUE(isConsistent(frame)) << "frame " << frame.number;
+      reads++;
+    }
+  }
+  even.join();
+  odd.join();
+  EXPECT_GT(reads, 0);
+  EXPECT_EQ(reader.getWritten(), 200000u);
+}
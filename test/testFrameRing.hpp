@@ -0,0 +1,47 @@
+#ifndef TEST_FRAME_RING_HPP
+#define TEST_FRAME_RING_HPP
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "../controller/frameRing.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+
+namespace s21 {
+
+class FrameRingTest : public ::testing::Test, public TetrisLogic {
+ protected:
+  void SetUp() override {
+    name = "/retro_games_test_" + std::to_string(getpid());
+  }
+
+  // frame of game with every cell equal to low byte of score
+  void fillInfo(int score) { fillInfo(gameInfo, score); }
+  static void fillInfo(GameInfo_t& info, int score) {
+    info.score = score;
+    info.level = score % 10 + 1;
+    for (int y = 0; y < FIELD_HEIGHT; y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        info.field[y][x] = score & 0xFF;
+      }
+    }
+  }
+
+  static bool isConsistent(const Frame_t& frame) {
+    bool isSame = frame.level == frame.score % 10 + 1;
+    for (int y = 0; y < FIELD_HEIGHT && isSame; y++) {
+      for (int x = 0; x < FIELD_WIDTH && isSame; x++) {
+        isSame = frame.field[y][x] == (frame.score & 0xFF);
+      }
+    }
+    return isSame;
+  }
+
+  std::string name;
+};
+
+}  // namespace s21
+
+#endif  // TEST_FRAME_RING_HPP
@@ -0,0 +1,102 @@
+#include "testJournal.hpp"
+
+using namespace s21;
+
+TEST_F(GameJournalTest, restore_after_crash) {
+  GameJournal journal;
+  ASSERT_TRUE(journal.open(path, 64));
+  TetrisLogic game;
+  game.setSeed(3);
+  journal.checkpoint(game);
+  journal.userInput(game, UserAction_t::Start, false);
+  play(journal, game, 500);  // several checkpoints
+  EXPECT_LT(journal.getEventsCount(), 64u);
+
+  // process died, mapped file is all that is left
+  GameJournal reopened;
+  ASSERT_TRUE(reopened.open(path, 64));
+  EXPECT_EQ(reopened.getSavedGame(), GameType::TETRIS);
+
+  TetrisLogic restored;
+  ASSERT_TRUE(reopened.restore(restored));
+  EXPECT_TRUE(sameGames(game, restored));
+
+  // restored game goes on the same way
+  play(journal, game, 100);
+  play(reopened, restored, 100);
+  EXPECT_TRUE(sameGames(game, restored));
+}
+
+TEST_F(GameJournalTest, torn_checkpoint) {
+  {
+    GameJournal journal;
+    ASSERT_TRUE(journal.open(path, 16));
+    SnakeLogic game;
+    journal.checkpoint(game);
+    journal.userInput(game, UserAction_t::Start, false);
+    play(journal, game, 20);
+  }
+
+  // damage state of newest checkpoint
+  FILE* file = fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  Checkpoint slots[2];
+  fseek(file, sizeof(JournalHeader), SEEK_SET);
+  ASSERT_EQ(fread(slots, sizeof(Checkpoint), 2, file), 2u);
+  int newest = slots[0].sequence > slots[1].sequence ? 0 : 1;
+  fseek(file, sizeof(JournalHeader) + newest * sizeof(Checkpoint) + 40,
+        SEEK_SET);
+  fputc(0xFF, file);
+  fclose(file);
+
+  GameJournal journal;
+  ASSERT_TRUE(journal.open(path, 16));
+  EXPECT_EQ(journal.getSavedGame(), GameType::SNAKE);
+  SnakeLogic restored;
+  EXPECT_TRUE(journal.restore(restored));
+
+  journal.clear();
+  EXPECT_EQ(journal.getSavedGame(), GameType::NONE);
+  EXPECT_FALSE(journal.restore(restored));
+}
+
+TEST_F(GameJournalTest, other_capacity) {
+  {
+    GameJournal journal;
+    ASSERT_TRUE(journal.open(path, 16));
+    TetrisLogic game;
+    journal.checkpoint(game);
+  }
+  GameJournal journal;
+  ASSERT_TRUE(journal.open(path, 32));
+  EXPECT_EQ(journal.getSavedGame(), GameType::NONE);
+  EXPECT_FALSE(journal.open("/nonexistent/dir/journal.db"));
+}
+
+TEST_F(GameJournalTest, controller_resume) {
+  auto saved = std::make_unique<GameJournal>();
+  ASSERT_TRUE(saved->open(path, 32));
+  SnakeLogic game;
+  saved->checkpoint(game);
+  saved->userInput(game, UserAction_t::Start, false);
+  play(*saved, game, 5);
+  saved.reset();
+
+  auto journal = std::make_unique<GameJournal>();
+  ASSERT_TRUE(journal->open(path, 32));
+  setJournal(std::move(journal));
+  auto resumeView = std::make_unique<ResumeView>();
+  ResumeView* viewPtr = resumeView.get();
+  setView(std::move(resumeView));
+
+  ASSERT_TRUE(resumeGame());
+  EXPECT_EQ(viewPtr->offeredGame, GameType::SNAKE);
+  EXPECT_EQ(gameType, GameType::SNAKE);
+  EXPECT_TRUE(sameGames(game, *model));
+
+  // new game is offered after game was closed
+  closeGame();
+  viewPtr->offeredGame = GameType::NONE;
+  EXPECT_FALSE(resumeGame());
+  EXPECT_EQ(viewPtr->offeredGame, GameType::NONE);
+}
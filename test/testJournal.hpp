@@ -0,0 +1,55 @@
+#ifndef TEST_JOURNAL_HPP
+#define TEST_JOURNAL_HPP
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../controller/gameController.hpp"
+
+namespace s21 {
+
+class ResumeView : public GameView {
+ public:
+  void render(const GameInfo_t&, GameStatus, GameType) override {}
+  GameType selectGame() override { return GameType::NONE; }
+  bool offerResume(GameType gameType) override {
+    offeredGame = gameType;
+    return resume;
+  }
+
+  bool resume = true;
+  GameType offeredGame = GameType::NONE;
+};
+
+class GameJournalTest : public ::testing::Test, public GameController {
+ protected:
+  void TearDown() override { unlink(path.c_str()); }
+
+  // same inputs for original and restored game
+  static void play(GameJournal& journal, GameLogic& game, int steps) {
+    const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Action,
+                                    UserAction_t::Right, UserAction_t::Down};
+    for (int i = 0; i < steps; i++) {
+      if (i % 3 == 0) {
+        journal.userInput(game, actions[(i / 3) % 4], false);
+      }
+      journal.gameTick(game);
+    }
+  }
+
+  static bool sameGames(const GameLogic& a, const GameLogic& b) {
+    GameState_t stateA, stateB;
+    a.saveState(stateA);
+    b.saveState(stateB);
+    return memcmp(&stateA, &stateB, sizeof(GameState_t)) == 0;
+  }
+
+  std::string path =
+      "/tmp/retro_games_" + std::to_string(getpid()) + "_journal.db";
+};
+
+}  // namespace s21
+
+#endif  // TEST_JOURNAL_HPP
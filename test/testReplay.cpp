@@ -0,0 +1,176 @@
+#include "testReplay.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace s21;
+
+TEST_F(ReplayTest, record_and_verify) {
+  std::vector<std::string> recorded;
+  for (uint64_t seed = 1; seed <= 20; seed++) {
+    GameType type = seed % 2 ? GameType::TETRIS : GameType::SNAKE;
+    // preview of tetris is taken from header
+    previewSize = 1 + seed % PREVIEW_SIZE;
+    recorded.push_back(record(type, seed, 1000));
+  }
+  // other files are not replays
+  FILE* file = fopen((directory + "/notes.txt").c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  fclose(file);
+
+  std::vector<std::string> paths = ReplayVerifier::listReplays(directory);
+  ASSERT_EQ(paths.size(), recorded.size());
+  std::vector<ReplayResult> results = ReplayVerifier(4).verify(paths);
+  ASSERT_EQ(results.size(), paths.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i].verdict, ReplayVerdict::MATCH) << paths[i];
+    EXPECT_EQ(results[i].score, results[i].recordedScore);
+  }
+}
+
+TEST_F(ReplayTest, divergence) {
+  std::string scorePath = record(GameType::TETRIS, 1, 2000);
+  std::string eventPath = record(GameType::SNAKE, 2, 2000);
+  std::string brokenPath = record(GameType::SNAKE, 3, 100);
+
+  ReplayHeader header;
+  std::vector<ReplayEvent> events;
+  ASSERT_TRUE(readReplay(scorePath, header, events));
+
+  // claimed score is higher than the game gives
+  FILE* file = fopen(scorePath.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  header.score += 100;
+  fwrite(&header, sizeof(header), 1, file);
+  fclose(file);
+
+  // one input changed in the middle of session
+  ASSERT_TRUE(readReplay(eventPath, header, events));
+  size_t i = events.size() / 2;
+  while (events[i].type != static_cast<uint8_t>(ReplayEventType::INPUT)) {
+    i++;
+  }
+  events[i].action = static_cast<uint8_t>(
+      events[i].action == static_cast<uint8_t>(UserAction_t::Left)
+          ? UserAction_t::Right
+          : UserAction_t::Left);
+  file = fopen(eventPath.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file, sizeof(header) + i * sizeof(ReplayEvent), SEEK_SET);
+  fwrite(&events[i], sizeof(ReplayEvent), 1, file);
+  fclose(file);
+
+  std::filesystem::resize_file(brokenPath, sizeof(ReplayHeader) + 2);
+
+  std::vector<ReplayResult> results =
+      ReplayVerifier(2).verify({scorePath, eventPath, brokenPath});
+  EXPECT_EQ(results[0].verdict, ReplayVerdict::DIVERGED);
+  EXPECT_EQ(results[0].recordedScore, results[0].score + 100);
+  EXPECT_EQ(results[1].verdict, ReplayVerdict::DIVERGED);
+  EXPECT_EQ(results[2].verdict, ReplayVerdict::UNREADABLE);
+}
+
+TEST_F(ReplayTest, controller_records_game) {
+  setReplayDirectory(directory);
+  gameType = GameType::SNAKE;
+  model = createGame(gameType);
+  startReplay();
+  applyAction(UserAction_t::Start, false);
+  for (int i = 0; i < 50; i++) {
+    applyAction(UserAction_t::Action, false);
+  }
+  closeGame();
+
+  std::vector<std::string> paths = ReplayVerifier::listReplays(directory);
+  ASSERT_EQ(paths.size(), 1u);
+  ReplayHeader header;
+  std::vector<ReplayEvent> events;
+  ASSERT_TRUE(readReplay(paths[0], header, events));
+  EXPECT_EQ(header.gameType, static_cast<uint8_t>(GameType::SNAKE));
+  EXPECT_EQ(events.size(), 51u);
+  EXPECT_EQ(ReplayVerifier().verify(paths)[0].verdict, ReplayVerdict::MATCH);
+}
+
+TEST_F(ReplayTest, verify_many) {
+  const int count = 400;
+  for (int i = 0; i < count; i++) {
+    record(i % 2 ? GameType::TETRIS : GameType::SNAKE, 100 + i, 2000);
+  }
+  std::vector<std::string> paths = ReplayVerifier::listReplays(directory);
+
+  std::vector<ReplayResult> results = ReplayVerifier().verify(paths);
+  ASSERT_EQ(results.size(), static_cast<size_t>(count));
+  for (const ReplayResult& result : results) {
+    ASSERT_EQ(result.verdict, ReplayVerdict::MATCH);
+  }
+}
+
+TEST_F(ReplayTest, seek) {
+  std::string path = record(GameType::TETRIS, 7, 3000);
+  ReplayPlayer player;
+  ASSERT_TRUE(player.open(path));
+  ASSERT_EQ(player.getLength(), 3000u);
+
+  // states of game played from the start
+  TetrisLogic game;
+  ASSERT_TRUE(player.seek(game, 0));
+  std::vector<GameState_t> states(player.getLength() + 1);
+  game.saveState(states[0]);
+  for (uint32_t i = 1; i < states.size(); i++) {
+    ASSERT_TRUE(player.step(game));
+    game.saveState(states[i]);
+  }
+  EXPECT_FALSE(player.step(game));
+  EXPECT_EQ(game.getHash(), player.getHeader().hash);
+
+  // other game goes back and forth
+  TetrisLogic seeker;
+  RandomGenerator random(7);
+  for (int i = 0; i < 200; i++) {
+    uint32_t target = random.next(player.getLength() + 1);
+    ASSERT_TRUE(player.seek(seeker, target));
+    EXPECT_EQ(player.getPosition(), target);
+    GameState_t state;
+    seeker.saveState(state);
+    ASSERT_EQ(memcmp(&state, &states[target], sizeof(state)), 0) << target;
+  }
+  EXPECT_FALSE(player.seek(seeker, player.getLength() + 1));
+  SnakeLogic snake;
+  EXPECT_FALSE(player.seek(snake, 10));
+}
+
+TEST_F(ReplayTest, verify_split) {
+  std::string path = record(GameType::SNAKE, 8, 5000);
+  std::string copyPath = directory + "/copy" + REPLAY_EXTENSION;
+  ReplayVerifier verifier(4);
+  ReplayResult result = verifier.verifySplit(path);
+  EXPECT_EQ(result.verdict, ReplayVerdict::MATCH);
+  EXPECT_EQ(result.score, result.recordedScore);
+
+  // keyframe in the middle does not follow from previous segment
+  ReplayHeader header;
+  std::vector<ReplayEvent> events;
+  ReplayIndex index;
+  std::vector<GameState_t> keyframes;
+  ASSERT_TRUE(readReplay(path, header, events, index, keyframes));
+  ASSERT_GT(keyframes.size(), 10u);
+  std::filesystem::copy_file(path, copyPath);
+  GameState_t& keyframe = keyframes[keyframes.size() / 2];
+  keyframe.score += 1;
+  FILE* file = fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  fseek(file,
+        index.keyframesOffset + keyframes.size() / 2 * sizeof(GameState_t),
+        SEEK_SET);
+  fwrite(&keyframe, sizeof(keyframe), 1, file);
+  fclose(file);
+  EXPECT_EQ(verifier.verifySplit(path).verdict, ReplayVerdict::DIVERGED);
+  // whole replay does not read keyframes
+  EXPECT_EQ(verifier.verify({path})[0].verdict, ReplayVerdict::MATCH);
+
+  // replay without index can not be split
+  std::filesystem::resize_file(copyPath, index.keyframesOffset);
+  EXPECT_EQ(verifier.verifySplit(copyPath).verdict,
+            ReplayVerdict::UNREADABLE);
+  EXPECT_FALSE(ReplayPlayer().open(copyPath));
+}
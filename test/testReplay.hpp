@@ -0,0 +1,66 @@
+#ifndef TEST_REPLAY_HPP
+#define TEST_REPLAY_HPP
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <filesystem>
+
+#include "../controller/gameController.hpp"
+#include "../controller/replayVerifier.hpp"
+
+namespace s21 {
+
+class ReplayTest : public ::testing::Test, public GameController {
+ protected:
+  void SetUp() override {
+    GameLogic::setHighScoreStorage(false);
+    std::filesystem::create_directory(directory);
+  }
+
+  void TearDown() override {
+    GameLogic::setHighScoreStorage(true);
+    std::filesystem::remove_all(directory);
+  }
+
+  // session of random inputs and ticks, game is restarted when it ends
+  static void play(ReplayRecorder& recorder, GameLogic& game, int steps,
+                   uint64_t seed) {
+    const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                    UserAction_t::Up, UserAction_t::Down,
+                                    UserAction_t::Action,
+                                    UserAction_t::HardDrop};
+    RandomGenerator random(seed);
+    for (int i = 0; i < steps; i++) {
+      UserAction_t action = actions[random.next(6)];
+      if (game.getCurrentGameStatus() != GameStatus::GAME) {
+        action = UserAction_t::Start;
+      }
+      if (random.next(3)) {
+        game.userInput(action, false);
+        recorder.userInput(game, action, false);
+      } else {
+        game.gameTick();
+        recorder.gameTick(game);
+      }
+    }
+  }
+
+  std::string record(GameType type, uint64_t seed, int steps) {
+    std::unique_ptr<GameLogic> game = createGame(type);
+    ReplayRecorder recorder;
+    recorder.start(*game, type, seed);
+    play(recorder, *game, steps, seed);
+    std::string path =
+        directory + "/" + std::to_string(seed) + REPLAY_EXTENSION;
+    EXPECT_TRUE(recorder.save(*game, path));
+    return path;
+  }
+
+  std::string directory =
+      "/tmp/retro_games_" + std::to_string(getpid()) + "_replays";
+};
+
+}  // namespace s21
+
+#endif  // TEST_REPLAY_HPP
@@ -0,0 +1,131 @@
+#include "testScheduler.hpp"
+
+using namespace s21;
+using namespace std::chrono;
+
+TEST_F(TickSchedulerTest, ticks_many_games) {
+  const int count = 300;
+  TickScheduler scheduler(4, TEST_DELAY);
+  std::vector<std::atomic<int>> ticks(count);
+
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(addStartedGame(scheduler, i),
+              static_cast<TickScheduler::GameId>(i));
+  }
+  scheduler.setTickCallback(
+      [&ticks](TickScheduler::GameId id, GameLogic&) { ticks[id]++; });
+
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 15));
+  scheduler.stop();
+
+  uint64_t total = 0;
+  for (int i = 0; i < count; i++) {
+    EXPECT_GE(ticks[i], 5);
+    total += ticks[i];
+  }
+  EXPECT_EQ(total, scheduler.getTickCount());
+}
+
+TEST_F(TickSchedulerTest, remove_game) {
+  TickScheduler scheduler(2, TEST_DELAY);
+  std::atomic<int> removedTicks = 0;
+  std::atomic<int> keptTicks = 0;
+
+  TickScheduler::GameId removed = addStartedGame(scheduler, 0);
+  TickScheduler::GameId kept = addStartedGame(scheduler, 1);
+  scheduler.setTickCallback([&](TickScheduler::GameId id, GameLogic&) {
+    (id == removed ? removedTicks : keptTicks)++;
+  });
+  scheduler.removeGame(removed);
+  scheduler.userInput(removed, UserAction_t::Pause, false);
+
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 5));
+  scheduler.stop();
+
+  EXPECT_EQ(removedTicks, 0);
+  EXPECT_GT(keptTicks, 0);
+  (void)kept;
+}
+
+TEST_F(TickSchedulerTest, reuse_removed_entry) {
+  TickScheduler scheduler(2, TEST_DELAY);
+  TickScheduler::GameId removed = addStartedGame(scheduler, 0);
+  addStartedGame(scheduler, 1);
+  scheduler.removeGame(removed);
+  // entry is still in wheel
+  TickScheduler::GameId added = addStartedGame(scheduler, 2);
+  EXPECT_EQ(added, 2u);
+
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 5));
+  scheduler.stop();
+
+  std::atomic<int> ticks = 0;
+  EXPECT_EQ(addStartedGame(scheduler, 3), removed);
+  scheduler.setTickCallback([&](TickScheduler::GameId id, GameLogic& game) {
+    ticks += id == removed && dynamic_cast<SnakeLogic*>(&game) != nullptr;
+  });
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 5));
+  scheduler.stop();
+  EXPECT_GT(ticks, 0);
+}
+
+// deadlines of games passed before start, they are ticked at once
+TEST_F(TickSchedulerTest, late_start) {
+  const int count = 20;
+  TickScheduler scheduler(2, TEST_DELAY);
+  std::vector<std::atomic<int>> ticks(count);
+  for (int i = 0; i < count; i++) {
+    addStartedGame(scheduler, i);
+  }
+  scheduler.setTickCallback(
+      [&ticks](TickScheduler::GameId id, GameLogic&) { ticks[id]++; });
+
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 5));
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 10));
+  scheduler.stop();
+  for (int i = 0; i < count; i++) {
+    EXPECT_GE(ticks[i], 3) << "game " << i;
+  }
+}
+
+TEST_F(TickSchedulerTest, user_input) {
+  TickScheduler scheduler(1, TEST_DELAY);
+  GameStatus status = GameStatus::INIT;
+
+  TickScheduler::GameId id = scheduler.addGame(GameType::TETRIS, 1);
+  scheduler.setTickCallback([&status](TickScheduler::GameId, GameLogic& g) {
+    status = g.getCurrentGameStatus();
+  });
+
+  scheduler.start();
+  scheduler.userInput(id, UserAction_t::Start, false);
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 5));
+  scheduler.userInput(id, UserAction_t::Pause, false);
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 3));
+  scheduler.stop();
+
+  EXPECT_EQ(status, GameStatus::PAUSE);
+}
+
+TEST_F(TickSchedulerTest, restart) {
+  TickScheduler scheduler(3, TEST_DELAY);
+  for (int i = 0; i < 50; i++) {
+    addStartedGame(scheduler, i);
+  }
+
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 3));
+  scheduler.stop();
+  uint64_t ticks = scheduler.getTickCount();
+  EXPECT_GT(ticks, 0u);
+
+  scheduler.start();
+  std::this_thread::sleep_for(milliseconds(TEST_DELAY * 3));
+  scheduler.stop();
+  EXPECT_GT(scheduler.getTickCount(), ticks);
+}
@@ -0,0 +1,26 @@
+#ifndef TEST_SCHEDULER_HPP
+#define TEST_SCHEDULER_HPP
+
+#include <gtest/gtest.h>
+
+#include "../controller/tickScheduler.hpp"
+
+namespace s21 {
+
+class TickSchedulerTest : public ::testing::Test {
+ protected:
+  // short delays instead of 1000 ms for fast tests
+  static const int TEST_DELAY = 10;
+
+  static TickScheduler::GameId addStartedGame(TickScheduler& scheduler,
+                                              int index) {
+    GameType type = index % 2 ? GameType::SNAKE : GameType::TETRIS;
+    TickScheduler::GameId id = scheduler.addGame(type, index);
+    scheduler.userInput(id, UserAction_t::Start, false);
+    return id;
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_SCHEDULER_HPP
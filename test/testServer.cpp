@@ -0,0 +1,131 @@
+#include "testServer.hpp"
+
+using namespace s21;
+
+TEST_F(GameServerTest, hello_tetris) {
+  int fd = connectClient();
+  ASSERT_GE(fd, 0);
+  ServerMessage msg;
+
+  ASSERT_TRUE(sendMessage(fd, MessageType::HELLO,
+                          static_cast<uint8_t>(GameType::TETRIS)));
+  ASSERT_TRUE(readFrame(fd, msg));
+  EXPECT_EQ(msg.type, static_cast<uint8_t>(MessageType::FRAME));
+  EXPECT_EQ(msg.frame.gameType, static_cast<uint8_t>(GameType::TETRIS));
+  EXPECT_EQ(msg.frame.status, static_cast<uint8_t>(GameStatus::INIT));
+
+  ASSERT_TRUE(sendInput(fd, UserAction_t::Start));
+  ASSERT_TRUE(readFrame(fd, msg));
+  EXPECT_EQ(msg.frame.status, static_cast<uint8_t>(GameStatus::GAME));
+  EXPECT_EQ(msg.frame.number, 2u);
+
+  int cells = 0, nextCells = 0;
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) cells += msg.frame.field[y][x];
+  }
+  for (int y = 0; y < NEXT_HEIGHT; y++) {
+    for (int x = 0; x < NEXT_WIDTH; x++) nextCells += msg.frame.next[y][x];
+  }
+  EXPECT_GT(cells, 0);  // new shape is partially above field
+  EXPECT_EQ(nextCells, 4);
+
+  close(fd);
+  EXPECT_TRUE(waitSessions(0));
+}
+
+TEST_F(GameServerTest, hello_snake_tick) {
+  int fd = connectClient();
+  ASSERT_GE(fd, 0);
+  ServerMessage msg;
+
+  ASSERT_TRUE(sendMessage(fd, MessageType::HELLO,
+                          static_cast<uint8_t>(GameType::SNAKE)));
+  ASSERT_TRUE(readFrame(fd, msg));
+  ASSERT_TRUE(sendInput(fd, UserAction_t::Start));
+  ASSERT_TRUE(readFrame(fd, msg));
+  EXPECT_EQ(msg.frame.status, static_cast<uint8_t>(GameStatus::GAME));
+  EXPECT_EQ(msg.frame.level, 1);
+
+  // next frame is sent by server tick without input
+  ASSERT_TRUE(readFrame(fd, msg));
+  EXPECT_EQ(msg.frame.number, 3u);
+
+  ASSERT_TRUE(sendMessage(fd, MessageType::BYE));
+  EXPECT_TRUE(waitSessions(0));
+  close(fd);
+}
+
+TEST_F(GameServerTest, high_score_not_loaded) {
+  // local game clears 4 lines and stores its score
+  TetrisLogic local;
+  local.userInput(UserAction_t::Start, false);
+  int** field = local.getGameInfo().field;
+  for (int y = FIELD_HEIGHT - 4; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) field[y][x] = 1;
+  }
+  for (int i = 0; i < 20; i++) local.gameTick();
+  ASSERT_GT(local.getGameInfo().high_score, 0);
+
+  int fd = connectClient();
+  ASSERT_GE(fd, 0);
+  ServerMessage msg;
+  ASSERT_TRUE(sendMessage(fd, MessageType::HELLO,
+                          static_cast<uint8_t>(GameType::TETRIS)));
+  ASSERT_TRUE(readFrame(fd, msg));
+  ASSERT_TRUE(sendInput(fd, UserAction_t::Start));
+  ASSERT_TRUE(readFrame(fd, msg));
+  EXPECT_EQ(msg.frame.status, static_cast<uint8_t>(GameStatus::GAME));
+  EXPECT_EQ(msg.frame.high_score, 0);
+
+  close(fd);
+  EXPECT_TRUE(waitSessions(0));
+}
+
+TEST_F(GameServerTest, unknown_game) {
+  int fd = connectClient();
+  ASSERT_GE(fd, 0);
+  ServerMessage msg;
+
+  ASSERT_TRUE(sendMessage(fd, MessageType::HELLO,
+                          static_cast<uint8_t>(GameType::NONE)));
+  EXPECT_FALSE(readFrame(fd, msg));
+  EXPECT_TRUE(waitSessions(0));
+  close(fd);
+}
+
+TEST_F(GameServerTest, terminate_in_menu) {
+  int fd = connectClient();
+  ASSERT_GE(fd, 0);
+  ServerMessage msg;
+
+  ASSERT_TRUE(sendMessage(fd, MessageType::HELLO,
+                          static_cast<uint8_t>(GameType::SNAKE)));
+  ASSERT_TRUE(readFrame(fd, msg));
+  ASSERT_TRUE(sendInput(fd, UserAction_t::Terminate));
+  EXPECT_FALSE(readFrame(fd, msg));
+  close(fd);
+}
+
+TEST_F(GameServerTest, many_sessions) {
+  const int count = 64;
+  int fds[count];
+  ServerMessage msg;
+
+  for (int i = 0; i < count; i++) {
+    fds[i] = connectClient();
+    ASSERT_GE(fds[i], 0);
+    GameType gameType = i % 2 ? GameType::SNAKE : GameType::TETRIS;
+    ASSERT_TRUE(sendMessage(fds[i], MessageType::HELLO,
+                            static_cast<uint8_t>(gameType)));
+    ASSERT_TRUE(sendInput(fds[i], UserAction_t::Start));
+  }
+  EXPECT_TRUE(waitSessions(count));
+
+  for (int i = 0; i < count; i++) {
+    ASSERT_TRUE(readFrame(fds[i], msg));
+    ASSERT_TRUE(readFrame(fds[i], msg));
+    EXPECT_EQ(msg.frame.status, static_cast<uint8_t>(GameStatus::GAME));
+    close(fds[i]);
+  }
+  EXPECT_TRUE(waitSessions(0));
+}
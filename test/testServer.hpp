@@ -0,0 +1,68 @@
+#ifndef TEST_SERVER_HPP
+#define TEST_SERVER_HPP
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../retro_games/tetris/tetrisLogic.hpp"
+#include "../server/gameServer.hpp"
+
+namespace s21 {
+
+class GameServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    socketPath = "/tmp/retro_games_test_" + std::to_string(getpid()) + ".sock";
+    server = std::make_unique<GameServer>(socketPath, 2);
+    ASSERT_TRUE(server->start());
+  }
+
+  void TearDown() override { server->stop(); }
+
+  int connectClient() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      close(fd);
+      fd = -1;
+    } else {
+      timeval timeout = {2, 0};
+      setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    return fd;
+  }
+
+  static bool sendMessage(int fd, MessageType type, uint8_t arg = 0,
+                          uint8_t hold = 0) {
+    ClientMessage msg = {static_cast<uint8_t>(type), arg, hold, 0};
+    return send(fd, &msg, sizeof(msg), MSG_NOSIGNAL) == sizeof(msg);
+  }
+
+  static bool sendInput(int fd, UserAction_t action) {
+    return sendMessage(fd, MessageType::INPUT, static_cast<uint8_t>(action));
+  }
+
+  static bool readFrame(int fd, ServerMessage& msg) {
+    return recv(fd, &msg, sizeof(msg), MSG_WAITALL) == sizeof(msg);
+  }
+
+  bool waitSessions(int count) {
+    for (int i = 0; i < 200 && server->getSessionCount() != count; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return server->getSessionCount() == count;
+  }
+
+  std::string socketPath;
+  std::unique_ptr<GameServer> server;
+};
+
+}  // namespace s21
+
+#endif  // TEST_SERVER_HPP
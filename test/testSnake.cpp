@@ -1,5 +1,12 @@
 #include "testSnake.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../retro_games/snake/snakeBot.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+
 using namespace s21;
 
 TEST_F(SnakeLogicTest, constructor_1) {
@@ -311,4 +318,234 @@ TEST_F(SnakeLogicTest, win_2) {
 
   EXPECT_EQ(getCurrentGameStatus(), GameStatus::WIN);
   EXPECT_EQ(updateCurrentState().pause, 1);
-}
\ No newline at end of file
+}
+TEST_F(SnakeLogicTest, save_load_state) {
+  setSeed(7);
+  userInput(UserAction_t::Start, false);
+  gameTick();
+  gameTick();
+
+  GameState_t state;
+  saveState(state);
+  SnakeLogic restored;
+  ASSERT_TRUE(restored.loadState(state));
+  EXPECT_TRUE(restored.updateCurrentState() == updateCurrentState());
+
+  // food spawned after restore is the same
+  const UserAction_t actions[] = {UserAction_t::Down, UserAction_t::Right,
+                                  UserAction_t::Down, UserAction_t::Left};
+  for (int i = 0; i < 40; i++) {
+    UserAction_t action = actions[(i / 4) % 4];
+    userInput(action, false);
+    restored.userInput(action, false);
+    GameState_t original, copy;
+    saveState(original);
+    restored.saveState(copy);
+    ASSERT_EQ(memcmp(&original, &copy, sizeof(GameState_t)), 0);
+  }
+  EXPECT_EQ(restored.updateCurrentState().score,
+            updateCurrentState().score);
+
+  TetrisLogic tetris;
+  tetris.saveState(state);
+  EXPECT_FALSE(restored.loadState(state));
+}
+
+TEST_F(SnakeLogicTest, export_observation) {
+  SnakeLogic game;
+  game.setSeed(4);
+  game.userInput(UserAction_t::Start, false);
+  game.userInput(UserAction_t::Action, false);
+
+  std::vector<uint8_t> bytes(
+      GameLogic::observationSize(ObservationLayout::BYTES));
+  std::vector<uint8_t> bits(
+      GameLogic::observationSize(ObservationLayout::BITS));
+  ASSERT_EQ(game.exportObservation(bytes.data(), bytes.size(),
+                                   ObservationLayout::BYTES),
+            bytes.size());
+  ASSERT_EQ(game.exportObservation(bits.data(), bits.size(),
+                                   ObservationLayout::BITS),
+            bits.size());
+
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    uint16_t row;
+    memcpy(&row, &bits[y * sizeof(row)], sizeof(row));
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      EXPECT_EQ(bytes[y * FIELD_WIDTH + x], gameInfo.field[y][x]);
+      EXPECT_EQ((row >> x) & 1, gameInfo.field[y][x] != 0);
+    }
+  }
+  // snake has no next piece
+  for (int i = 0; i < NEXT_HEIGHT * NEXT_WIDTH; i++) {
+    EXPECT_EQ(bytes[FIELD_HEIGHT * FIELD_WIDTH + i], 0);
+  }
+}
+
+TEST_F(SnakeLogicTest, zobrist_hash) {
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                  UserAction_t::Up, UserAction_t::Down,
+                                  UserAction_t::Action};
+  RandomGenerator random(5);
+  setSeed(5);
+  userInput(UserAction_t::Start, false);
+
+  // incremental hash is the same as hash of loaded copy
+  int eaten = 0;
+  for (int i = 0; i < 3000; i++) {
+    int score = gameInfo.score;
+    if (currentGameStatus != GameStatus::GAME) {
+      userInput(UserAction_t::Start, false);
+    } else {
+      userInput(actions[random.next(5)], false);
+    }
+    eaten += gameInfo.score > score;
+
+    GameState_t state;
+    saveState(state);
+    SnakeLogic copy;
+    ASSERT_TRUE(copy.loadState(state));
+    ASSERT_EQ(getHash(), copy.getHash()) << "move " << i;
+  }
+  EXPECT_GT(eaten, 0);
+
+  // same cells, snake turned around
+  setSnakeToCenterFieldHeadUp();
+  GameState_t state;
+  saveState(state);
+  SnakeLogic up;
+  ASSERT_TRUE(up.loadState(state));
+  setSnakeToCenterFieldHeadDown();
+  saveState(state);
+  SnakeLogic down;
+  ASSERT_TRUE(down.loadState(state));
+  EXPECT_NE(up.getHash(), down.getHash());
+}
+
+TEST(SnakeBoardTest, board_size) {
+  EXPECT_EQ(SnakeLogic(1, 1).getWidth(), MIN_FIELD_SIZE);
+  EXPECT_EQ(SnakeLogic(1, 1).getHeight(), MIN_FIELD_SIZE);
+
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                  UserAction_t::Up, UserAction_t::Down,
+                                  UserAction_t::Action};
+  const int sizes[][2] = {{5, 5}, {7, 12}, {40, 80}};
+  for (const auto& size : sizes) {
+    SnakeLogic game(size[0], size[1]);
+    RandomGenerator random(9);
+    game.setSeed(9);
+    game.userInput(UserAction_t::Start, false);
+
+    // one head, one food and body of eaten length on any board
+    for (int i = 0; i < 3000; i++) {
+      if (game.getCurrentGameStatus() != GameStatus::GAME) {
+        game.userInput(UserAction_t::Start, false);
+      } else {
+        game.userInput(actions[random.next(5)], false);
+      }
+      if (game.getCurrentGameStatus() != GameStatus::GAME) continue;
+
+      const GameInfo_t& gameInfo = game.getGameInfo();
+      int heads = 0, food = 0, body = 0;
+      for (int y = 0; y < size[1]; y++) {
+        for (int x = 0; x < size[0]; x++) {
+          int value = gameInfo.field[y][x];
+          food += value == 1;
+          heads += value > 1 && value < 6;
+          body += value >= 6;
+        }
+      }
+      ASSERT_EQ(heads, 1) << "move " << i;
+      ASSERT_EQ(food, 1) << "move " << i;
+      ASSERT_EQ(body, gameInfo.score + 3) << "move " << i;
+    }
+  }
+
+  SnakeLogic game(40, 80);
+  game.userInput(UserAction_t::Start, false);
+  UserAction_t action;
+  EXPECT_FALSE(SnakeBot().nextAction(game, action));
+}
+
+// snake goes up to first row, then along rows and down to next row at
+// walls, so it does not meet its body while rows are left
+static int playRows(SnakeLogic& game, int ticks) {
+  const GameInfo_t& gameInfo = game.getGameInfo();
+  int x = 0, y = 0;
+  int moves = 0;
+  for (; moves < ticks && game.getCurrentGameStatus() == GameStatus::GAME;
+       moves++) {
+    game.getFocus(x, y);
+    auto head = static_cast<SnakeLogic::Field>(gameInfo.field[y][x]);
+    bool isAlong = head == SnakeLogic::Field::HEAD_LEFT ||
+                   head == SnakeLogic::Field::HEAD_RIGHT;
+    if (head == SnakeLogic::Field::HEAD_UP && y > 0) {
+      game.gameTick();
+    } else if (!isAlong) {
+      game.userInput(x < gameInfo.width / 2 ? UserAction_t::Right
+                                            : UserAction_t::Left,
+                     false);
+    } else if ((head == SnakeLogic::Field::HEAD_LEFT && x == 0) ||
+               (head == SnakeLogic::Field::HEAD_RIGHT &&
+                x == gameInfo.width - 1)) {
+      game.userInput(UserAction_t::Down, false);
+    } else {
+      game.gameTick();
+    }
+  }
+  return moves;
+}
+
+TEST(SnakeBoardTest, large_board_ticks) {
+  const int sizes[][2] = {{100, 100}, {2000, 2000}};
+  for (const auto& size : sizes) {
+    int ticks = std::min(20000, size[0] * size[1] / 2);
+    SnakeLogic game(size[0], size[1]);
+    game.setSeed(4);
+    game.userInput(UserAction_t::Start, false);
+
+    int moves = playRows(game, ticks);
+    EXPECT_EQ(moves, ticks);
+    EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::GAME);
+  }
+
+  // whole small board is passed, so food was met, then bottom wall ends it
+  SnakeLogic game(100, 100);
+  game.setSeed(4);
+  game.userInput(UserAction_t::Start, false);
+  playRows(game, 2 * 100 * 100);
+  EXPECT_GT(game.getGameInfo().score, 0);
+  EXPECT_EQ(game.getCurrentGameStatus(), GameStatus::GAME_OVER);
+}
+
+TEST(SnakeBoardTest, viewport) {
+  SnakeLogic game(300, 200);
+  game.setSeed(8);
+  game.userInput(UserAction_t::Start, false);
+  playRows(game, 1000);
+
+  // window of classic size is around head, inside board
+  int headX = 0, headY = 0;
+  game.getFocus(headX, headY);
+  GameInfo_t view = game.getViewport(FIELD_WIDTH, FIELD_HEIGHT);
+  EXPECT_EQ(view.width, FIELD_WIDTH);
+  EXPECT_EQ(view.height, FIELD_HEIGHT);
+  EXPECT_EQ(view.score, game.getGameInfo().score);
+  int left = std::clamp(headX - FIELD_WIDTH / 2, 0, 300 - FIELD_WIDTH);
+  int top = std::clamp(headY - FIELD_HEIGHT / 2, 0, 200 - FIELD_HEIGHT);
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      ASSERT_EQ(view.field[y][x], game.getGameInfo().field[top + y][left + x]);
+    }
+  }
+  int head = view.field[headY - top][headX - left];
+  EXPECT_GE(head, static_cast<int>(SnakeLogic::Field::HEAD_LEFT));
+  EXPECT_LE(head, static_cast<int>(SnakeLogic::Field::HEAD_DOWN));
+
+  // board smaller than window is shown whole
+  SnakeLogic small(6, 8);
+  view = small.getViewport(FIELD_WIDTH, FIELD_HEIGHT);
+  EXPECT_EQ(view.width, 6);
+  EXPECT_EQ(view.height, 8);
+}
@@ -0,0 +1,153 @@
+#include "testSpectator.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#include "../controller/gameController.hpp"
+
+using namespace s21;
+
+TEST_F(SpectatorStreamTest, encode_decode) {
+  SpectatorEncoder encoder(10);
+  SpectatorDecoder decoder;
+  std::string stream;
+  Frame_t frame;
+
+  for (int i = 0; i < 35; i++) {
+    frame = nextFrame();
+    size_t oldSize = stream.size();
+    bool isKeyframe = encoder.encode(frame, stream);
+    EXPECT_EQ(isKeyframe, i % 10 == 0);
+    if (!isKeyframe) {
+      EXPECT_LT(stream.size() - oldSize, sizeof(Frame_t) / 4);
+    }
+
+    // feed byte by byte as reader of pipe could get it
+    for (size_t j = oldSize; j < stream.size(); j++) {
+      decoder.feed(&stream[j], 1);
+    }
+    ASSERT_TRUE(decoder.isSynced());
+    EXPECT_TRUE(sameFrames(decoder.getFrame(), frame));
+  }
+  EXPECT_EQ(decoder.getFramesCount(), 35u);
+}
+
+TEST_F(SpectatorStreamTest, late_joiner) {
+  SpectatorEncoder encoder(8);
+  std::vector<std::string> records;
+  Frame_t frame;
+
+  for (int i = 0; i < 20; i++) {
+    frame = nextFrame();
+    records.emplace_back();
+    encoder.encode(frame, records.back());
+  }
+
+  // joins after third frame, skips deltas until keyframe 8
+  SpectatorDecoder decoder;
+  for (int i = 3; i < 20; i++) {
+    decoder.feed(records[i].data(), records[i].size());
+    EXPECT_EQ(decoder.isSynced(), i >= 8);
+  }
+  EXPECT_TRUE(sameFrames(decoder.getFrame(), frame));
+  EXPECT_EQ(decoder.getFramesCount(), 12u);
+}
+
+TEST_F(SpectatorStreamTest, lost_record) {
+  SpectatorEncoder encoder(5);
+  SpectatorDecoder decoder;
+  Frame_t frame;
+
+  for (int i = 0; i < 12; i++) {
+    std::string record;
+    frame = nextFrame();
+    encoder.encode(frame, record);
+    if (i != 2) {
+      decoder.feed(record.data(), record.size());
+    }
+    EXPECT_EQ(decoder.isSynced(), i < 3 || i >= 5);  // gap found on 3
+  }
+  EXPECT_TRUE(sameFrames(decoder.getFrame(), frame));
+}
+
+TEST_F(SpectatorStreamTest, file_output) {
+  std::string path = tempPath("spectate.bin");
+  {
+    SpectatorStream stream;
+    ASSERT_TRUE(stream.open("file:" + path));
+    for (int i = 0; i < 30; i++) {
+      nextFrame();
+      stream.publish(gameInfo, getCurrentGameStatus(), GameType::TETRIS);
+    }
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string data = content.str();
+  unlink(path.c_str());
+
+  SpectatorDecoder decoder;
+  decoder.feed(data.data(), data.size());
+  Frame_t frame;
+  packFrame(gameInfo, getCurrentGameStatus(), GameType::TETRIS, frame);
+  frame.number = 30;
+  EXPECT_TRUE(sameFrames(decoder.getFrame(), frame));
+  EXPECT_LT(data.size(), 30 * sizeof(Frame_t) / 2);
+}
+
+TEST_F(SpectatorStreamTest, socket_late_join) {
+  std::string path = tempPath("spectate.sock");
+  SpectatorStream stream(100);
+  ASSERT_TRUE(stream.listen(path));
+  for (int i = 0; i < 10; i++) {
+    nextFrame();
+    stream.publish(gameInfo, getCurrentGameStatus(), GameType::TETRIS);
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+  // client is accepted on next publish and gets keyframe with 10 deltas
+  nextFrame();
+  stream.publish(gameInfo, getCurrentGameStatus(), GameType::TETRIS);
+  EXPECT_EQ(stream.getClientsCount(), 1u);
+  nextFrame();
+  stream.publish(gameInfo, getCurrentGameStatus(), GameType::TETRIS);
+
+  SpectatorDecoder decoder;
+  char buffer[4096];
+  while (decoder.getFramesCount() < 12) {
+    ssize_t count = recv(fd, buffer, sizeof(buffer), 0);
+    ASSERT_GT(count, 0);
+    decoder.feed(buffer, count);
+  }
+  close(fd);
+
+  Frame_t frame;
+  packFrame(gameInfo, getCurrentGameStatus(), GameType::TETRIS, frame);
+  frame.number = 12;
+  EXPECT_TRUE(decoder.isSynced());
+  EXPECT_TRUE(sameFrames(decoder.getFrame(), frame));
+}
+
+TEST_F(SpectatorStreamTest, controller_options) {
+  std::string path = tempPath("options.bin");
+  std::string target = "file:" + path;
+  char name[] = "retro_games";
+  char spectate[] = "--spectate";
+  char unknown[] = "--unknown";
+  char noJournal[] = "--no-journal";
+
+  GameController controller;
+  char* valid[] = {name, spectate, target.data(), noJournal};
+  EXPECT_TRUE(controller.applyOptions(4, valid));
+  char* invalid[] = {name, unknown};
+  EXPECT_FALSE(controller.applyOptions(2, invalid));
+  char* noTarget[] = {name, spectate};
+  EXPECT_FALSE(controller.applyOptions(2, noTarget));
+  unlink(path.c_str());
+}
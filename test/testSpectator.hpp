@@ -0,0 +1,43 @@
+#ifndef TEST_SPECTATOR_HPP
+#define TEST_SPECTATOR_HPP
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../controller/spectatorStream.hpp"
+#include "../retro_games/tetris/tetrisLogic.hpp"
+
+namespace s21 {
+
+class SpectatorStreamTest : public ::testing::Test, public TetrisLogic {
+ protected:
+  // next frame of running game, piece falls one row per frame
+  Frame_t nextFrame() {
+    if (getCurrentGameStatus() != GameStatus::GAME) {
+      userInput(UserAction_t::Start, false);
+    }
+    gameTick();
+    Frame_t frame;
+    packFrame(gameInfo, getCurrentGameStatus(), GameType::TETRIS, frame);
+    frame.number = ++frameNumber;
+    return frame;
+  }
+
+  static bool sameFrames(const Frame_t& a, const Frame_t& b) {
+    return memcmp(&a, &b, sizeof(Frame_t)) == 0;
+  }
+
+  std::string tempPath(const char* name) {
+    return "/tmp/retro_games_" + std::to_string(getpid()) + "_" + name;
+  }
+
+  uint32_t frameNumber = 0;
+};
+
+}  // namespace s21
+
+#endif  // TEST_SPECTATOR_HPP
@@ -1,5 +1,11 @@
 #include "testTetris.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../retro_games/tetris/tetrisBot.hpp"
+
 using namespace s21;
 
 TEST_F(TetrisLogicTest, constructor) {
@@ -383,4 +389,561 @@ TEST_F(TetrisLogicTest, win) {
   EXPECT_EQ(gameData.pause, 1);
   userInput(UserAction_t::Terminate, false);
   EXPECT_EQ(getCurrentGameStatus(), GameStatus::INIT);
-}
\ No newline at end of file
+}
+static void playSameInput(GameLogic& game, int step) {
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Action,
+                                  UserAction_t::Right, UserAction_t::Down};
+  if (step % 3 == 0) {
+    game.userInput(actions[(step / 3) % 4], false);
+  }
+  game.gameTick();
+}
+
+TEST_F(TetrisLogicTest, save_load_state) {
+  setSeed(42);
+  userInput(UserAction_t::Start, false);
+  for (int i = 0; i < 30; i++) {
+    playSameInput(*this, i);
+  }
+
+  GameState_t state;
+  saveState(state);
+  EXPECT_EQ(state.hasShapes, 1);
+
+  TetrisLogic restored;
+  ASSERT_TRUE(restored.loadState(state));
+  EXPECT_EQ(restored.getCurrentGameStatus(), getCurrentGameStatus());
+  EXPECT_TRUE(restored.updateCurrentState() == updateCurrentState());
+
+  // same inputs give same game, including new random shapes
+  for (int i = 0; i < 400; i++) {
+    playSameInput(*this, i);
+    playSameInput(restored, i);
+    GameState_t original, copy;
+    saveState(original);
+    restored.saveState(copy);
+    ASSERT_EQ(memcmp(&original, &copy, sizeof(GameState_t)), 0);
+  }
+}
+
+TEST_F(TetrisLogicTest, load_state_init) {
+  GameState_t state;
+  saveState(state);
+  EXPECT_EQ(state.hasShapes, 0);
+
+  TetrisLogic restored;
+  restored.userInput(UserAction_t::Start, false);
+  ASSERT_TRUE(restored.loadState(state));
+  EXPECT_EQ(restored.getCurrentGameStatus(), GameStatus::INIT);
+  EXPECT_EQ(restored.updateCurrentState().next, nullptr);
+
+  state.gameType = static_cast<uint8_t>(GameType::SNAKE);
+  EXPECT_FALSE(restored.loadState(state));
+  state.gameType = static_cast<uint8_t>(GameType::TETRIS);
+  state.magic = 0;
+  EXPECT_FALSE(restored.loadState(state));
+}
+
+// load into the same game reuses its memory and keeps the game
+TEST_F(TetrisLogicTest, save_load_in_place) {
+  setSeed(3);
+  userInput(UserAction_t::Start, false);
+  TetrisLogic twin;
+  twin.setSeed(3);
+  twin.userInput(UserAction_t::Start, false);
+  int** field = gameInfo.field;
+
+  GameState_t state;
+  GameState_t twinState;
+  for (int i = 0; i < 200; i++) {
+    saveState(state);
+    ASSERT_TRUE(loadState(state));
+    EXPECT_EQ(gameInfo.field, field);
+    playSameInput(*this, i);
+    playSameInput(twin, i);
+    saveState(state);
+    twin.saveState(twinState);
+    ASSERT_EQ(memcmp(&state, &twinState, sizeof(GameState_t)), 0);
+  }
+}
+
+TEST_F(TetrisLogicTest, board_features) {
+  setSeed(9);
+  userInput(UserAction_t::Start, false);
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                  UserAction_t::Action, UserAction_t::Left,
+                                  UserAction_t::Left};
+  RandomGenerator random(4);
+  TetrisBot bot(1);
+  int lines = 0;
+
+  // bot clears lines, random moves leave holes and overhangs
+  for (int i = 0; i < 5000 && !HasFailure(); i++) {
+    UserAction_t action = actions[random.next(5)];
+    if (random.next(4)) {
+      bot.nextAction(*this, action);
+    }
+    int score = gameInfo.score;
+    userInput(action, false);
+    lines += gameInfo.score > score;
+    expectBoardFeatures();
+  }
+  EXPECT_GT(lines, 0);
+}
+
+TEST_F(TetrisLogicTest, board_features_lines) {
+  userInput(UserAction_t::Start, false);
+  GameState_t state;
+  saveState(state);
+  // two full lines and a hole under the top of first column
+  for (int x = 0; x < FIELD_WIDTH; x++) {
+    state.field[FIELD_HEIGHT - 1][x] = 1;
+    state.field[FIELD_HEIGHT - 2][x] = 1;
+  }
+  state.field[FIELD_HEIGHT - 3][0] = 0;
+  state.field[FIELD_HEIGHT - 4][0] = 1;
+  state.field[FIELD_HEIGHT - 3][5] = 1;
+  ASSERT_TRUE(loadState(state));
+  expectBoardFeatures();
+  EXPECT_EQ(getBoardFeatures().totalHoles, 1);
+  EXPECT_EQ(getBoardFeatures().heights[0], 4);
+
+  for (int i = 0; i < 60; i++) {
+    gameTick();
+    expectBoardFeatures();
+  }
+}
+
+TEST_F(TetrisLogicTest, hard_drop) {
+  TetrisLogic stepped;
+  setSeed(21);
+  stepped.setSeed(21);
+  userInput(UserAction_t::Start, false);
+  stepped.userInput(UserAction_t::Start, false);
+
+  // hard drop ends where steps down end
+  for (int piece = 0; piece < 10; piece++) {
+    userInput(UserAction_t::HardDrop, false);
+    GameState_t expected;
+    saveState(expected);
+    for (int i = 0; i < FIELD_HEIGHT + 2; i++) {
+      GameState_t state;
+      stepped.saveState(state);
+      if (memcmp(&state, &expected, sizeof(GameState_t)) == 0) break;
+      stepped.userInput(UserAction_t::Down, false);
+    }
+    ASSERT_TRUE(sameState(stepped));
+  }
+}
+
+TEST_F(TetrisLogicTest, ghost_piece) {
+  userInput(UserAction_t::Start, false);
+
+  int ghostCells = 0;
+  for (int x = 0; x < FIELD_WIDTH; x++) {
+    ghostCells += gameInfo.field[FIELD_HEIGHT - 1][x] == GHOST_CELL;
+  }
+  EXPECT_GT(ghostCells, 0);
+  EXPECT_EQ(ghost.count, 4);
+
+  // ghost is not saved and is not a block
+  GameState_t state;
+  saveState(state);
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      EXPECT_NE(state.field[y][x], GHOST_CELL);
+    }
+  }
+
+  // piece lands on ghost
+  GhostPiece landing = ghost;
+  for (int i = 0; i < FIELD_HEIGHT; i++) {
+    gameTick();
+  }
+  for (int i = 0; i < landing.count; i++) {
+    EXPECT_EQ(gameInfo.field[landing.y[i]][landing.x[i]], 1);
+  }
+  expectBoardFeatures();
+}
+
+TEST_F(TetrisLogicTest, export_observation) {
+  setSeed(5);
+  userInput(UserAction_t::Start, false);
+  for (int i = 0; i < 3; i++) {
+    userInput(UserAction_t::HardDrop, false);
+  }
+
+  std::vector<uint8_t> bytes(observationSize(ObservationLayout::BYTES));
+  std::vector<uint8_t> bits(observationSize(ObservationLayout::BITS));
+  EXPECT_EQ(exportObservation(bytes.data(), bytes.size() - 1,
+                              ObservationLayout::BYTES),
+            0u);
+  ASSERT_EQ(
+      exportObservation(bytes.data(), bytes.size(), ObservationLayout::BYTES),
+      bytes.size());
+  ASSERT_EQ(
+      exportObservation(bits.data(), bits.size(), ObservationLayout::BITS),
+      bits.size());
+
+  for (int y = 0; y < FIELD_HEIGHT; y++) {
+    uint16_t row;
+    memcpy(&row, &bits[y * sizeof(row)], sizeof(row));
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      // ghost is empty in both layouts
+      int cell = gameInfo.field[y][x] == GHOST_CELL ? 0 : gameInfo.field[y][x];
+      EXPECT_EQ(bytes[y * FIELD_WIDTH + x], cell);
+      EXPECT_EQ((row >> x) & 1, cell == 1);
+    }
+  }
+  for (int y = 0; y < NEXT_HEIGHT; y++) {
+    uint8_t row = bits[FIELD_HEIGHT * sizeof(uint16_t) + y];
+    for (int x = 0; x < NEXT_WIDTH; x++) {
+      EXPECT_EQ(bytes[FIELD_HEIGHT * FIELD_WIDTH + y * NEXT_WIDTH + x],
+                gameInfo.next[y][x]);
+      EXPECT_EQ((row >> x) & 1, gameInfo.next[y][x]);
+    }
+  }
+
+  int32_t stats[OBSERVATION_STATS];
+  memcpy(stats, &bytes[bytes.size() - sizeof(stats)], sizeof(stats));
+  EXPECT_EQ(stats[0], gameInfo.score);
+  EXPECT_EQ(stats[2], gameInfo.level);
+  EXPECT_EQ(stats[5], static_cast<int32_t>(GameStatus::GAME));
+  EXPECT_EQ(memcmp(stats, &bits[bits.size() - sizeof(stats)], sizeof(stats)),
+            0);
+}
+
+TEST_F(TetrisLogicTest, zobrist_hash) {
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                  UserAction_t::Action, UserAction_t::Down,
+                                  UserAction_t::HardDrop};
+  RandomGenerator random(11);
+  TetrisBot bot;
+  setSeed(11);
+  userInput(UserAction_t::Start, false);
+
+  // incremental hash is the same as hash of loaded copy,
+  // bot clears lines, random moves fill board
+  int lines = 0;
+  for (int i = 0; i < 3000; i++) {
+    int score = gameInfo.score;
+    UserAction_t action = actions[random.next(5)];
+    if (currentGameStatus != GameStatus::GAME) {
+      userInput(UserAction_t::Start, false);
+    } else {
+      if (random.next(4)) {
+        bot.nextAction(*this, action);
+      }
+      userInput(action, false);
+    }
+    lines += gameInfo.score != score;
+
+    GameState_t state;
+    saveState(state);
+    TetrisLogic copy;
+    ASSERT_TRUE(copy.loadState(state));
+    ASSERT_EQ(getHash(), copy.getHash()) << "move " << i;
+  }
+  EXPECT_GT(lines, 0);
+
+  // piece of new game is away from walls
+  TetrisLogic game;
+  game.setSeed(3);
+  game.userInput(UserAction_t::Start, false);
+  uint64_t hash = game.getHash();
+  game.userInput(UserAction_t::Left, false);
+  EXPECT_NE(game.getHash(), hash);
+  game.userInput(UserAction_t::Right, false);
+  EXPECT_EQ(game.getHash(), hash);
+  game.userInput(UserAction_t::Down, false);
+  EXPECT_NE(game.getHash(), hash);
+}
+
+TEST_F(TetrisLogicTest, garbage_lines) {
+  setSeed(5);
+  userInput(UserAction_t::Start, false);
+  GameState_t before;
+  saveState(before);
+
+  // rows full but hole, falling piece stays where it is
+  addGarbage(2, 3);
+  GameState_t after;
+  saveState(after);
+  for (int y = FIELD_HEIGHT - 2; y < FIELD_HEIGHT; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      EXPECT_EQ(after.field[y][x], x != 3);
+    }
+  }
+  EXPECT_EQ(memcmp(&before.current, &after.current, sizeof(after.current)),
+            0);
+  expectBoardFeatures();
+  EXPECT_EQ(getBoardFeatures().heights[3], 0);
+  EXPECT_EQ(getBoardFeatures().heights[4], 2);
+
+  // cells go up, hole column with cells gets holes
+  userInput(UserAction_t::HardDrop, false);
+  saveState(before);
+  addGarbage(3, 3);
+  saveState(after);
+  for (int y = NEXT_HEIGHT; y < FIELD_HEIGHT - 3; y++) {
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      EXPECT_EQ(after.field[y][x], before.field[y + 3][x]);
+    }
+  }
+  expectBoardFeatures();
+  EXPECT_EQ(takeClearedLines(), 0);
+}
+
+TEST_F(TetrisLogicTest, garbage_top_out) {
+  setSeed(5);
+  userInput(UserAction_t::Start, false);
+  addGarbage(10, 0);
+  addGarbage(FIELD_HEIGHT - 11, 0);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME);
+
+  // top row is not taken by locked cells
+  addGarbage(1, 0);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME_OVER);
+  EXPECT_EQ(getBoardFeatures().maxHeight, FIELD_HEIGHT - 1);
+
+  // no garbage out of game
+  addGarbage(1, 0);
+  EXPECT_EQ(getBoardFeatures().maxHeight, FIELD_HEIGHT - 1);
+}
+
+TEST_F(TetrisLogicTest, garbage_with_play) {
+  setSeed(17);
+  userInput(UserAction_t::Start, false);
+  RandomGenerator random(17);
+  TetrisBot bot(1);
+  int lines = 0;
+
+  // bot clears lines, garbage comes between its moves
+  for (int i = 0; i < 3000 && currentGameStatus == GameStatus::GAME; i++) {
+    UserAction_t action = UserAction_t::Down;
+    bot.nextAction(*this, action);
+    int score = gameInfo.score;
+    userInput(action, false);
+    int cleared = takeClearedLines();
+    EXPECT_EQ(cleared > 0, gameInfo.score > score);
+    lines += cleared;
+    if (random.next(30) == 0) {
+      addGarbage(1 + random.next(2), random.next(FIELD_WIDTH));
+    }
+    if (currentGameStatus != GameStatus::GAME) break;
+
+    expectBoardFeatures();
+    GameState_t state;
+    saveState(state);
+    TetrisLogic copy;
+    ASSERT_TRUE(copy.loadState(state));
+    ASSERT_EQ(getHash(), copy.getHash()) << "move " << i;
+  }
+  EXPECT_GT(lines, 0);
+}
+
+TEST_F(TetrisLogicTest, clear_lines_moves_rows) {
+  setSeed(4);
+  userInput(UserAction_t::Start, false);
+  std::vector<int*> rows(gameInfo.field, gameInfo.field + FIELD_HEIGHT);
+  std::sort(rows.begin(), rows.end());
+  TetrisBot bot(1);
+  int lines = 0;
+
+  // rows are only reordered, hash and features stay as by full count
+  for (int i = 0; i < 1500 && currentGameStatus == GameStatus::GAME; i++) {
+    UserAction_t action = UserAction_t::Down;
+    bot.nextAction(*this, action);
+    GameState_t before;
+    saveState(before);
+    int* bottom = gameInfo.field[FIELD_HEIGHT - 1];
+    userInput(action, false);
+    int cleared = takeClearedLines();
+    lines += cleared;
+    if (currentGameStatus != GameStatus::GAME) break;
+
+    std::vector<int*> moved(gameInfo.field, gameInfo.field + FIELD_HEIGHT);
+    std::sort(moved.begin(), moved.end());
+    ASSERT_EQ(moved, rows) << "move " << i;
+    const uint8_t* last = before.field[FIELD_HEIGHT - 1];
+    if (cleared > 0 && std::count(last, last + FIELD_WIDTH, 0) > NEXT_WIDTH) {
+      // bottom row is not filled by piece, it stays the same buffer
+      EXPECT_EQ(gameInfo.field[FIELD_HEIGHT - 1], bottom);
+    }
+    expectBoardFeatures();
+    GameState_t state;
+    saveState(state);
+    TetrisLogic copy;
+    ASSERT_TRUE(copy.loadState(state));
+    ASSERT_EQ(getHash(), copy.getHash()) << "move " << i;
+  }
+  EXPECT_GT(lines, 0);
+}
+
+TEST(TetrisPreviewTest, seven_bag) {
+  // large board, random drops do not top out
+  TetrisLogic game(40, 80);
+  game.setSeed(11);
+  game.userInput(UserAction_t::Start, false);
+  std::vector<int> types;
+  uint8_t pieces[PREVIEW_SIZE];
+  for (int i = 0; i < 140; i++) {
+    ASSERT_EQ(game.getPreview(pieces), 1);
+    types.push_back(pieces[0] & ((1 << PIECE_TURNS_SHIFT) - 1));
+    game.userInput(UserAction_t::HardDrop, false);
+    ASSERT_EQ(game.getCurrentGameStatus(), GameStatus::GAME);
+  }
+
+  // first piece fell at start, so each bag ends one piece before
+  for (size_t start = PIECE_TYPES - 1; start + PIECE_TYPES <= types.size();
+       start += PIECE_TYPES) {
+    int bag = 0;
+    for (int i = 0; i < PIECE_TYPES; i++) {
+      bag |= 1 << types[start + i];
+    }
+    EXPECT_EQ(bag, ((1 << PIECE_TYPES) - 1) << 1) << "bag at " << start;
+  }
+}
+
+TEST_F(TetrisLogicTest, preview_queue) {
+  setPreviewSize(100);
+  EXPECT_EQ(getPreviewSize(), PREVIEW_SIZE);
+  setPreviewSize(0);
+  EXPECT_EQ(getPreviewSize(), 1);
+  uint8_t pieces[PREVIEW_SIZE];
+  EXPECT_EQ(getPreview(pieces), 0);
+
+  setPreviewSize(4);
+  setSeed(8);
+  userInput(UserAction_t::Start, false);
+  for (int i = 0; i < 20 && currentGameStatus == GameStatus::GAME; i++) {
+    uint8_t before[PREVIEW_SIZE];
+    ASSERT_EQ(getPreview(before), 4);
+    GameState_t::Shape_t next = pieceShape(before[0]);
+    GameState_t state;
+    saveState(state);
+    EXPECT_EQ(memcmp(next.grid, state.next.grid, sizeof(next.grid)), 0);
+
+    // next piece falls, queue moves by one
+    userInput(UserAction_t::HardDrop, false);
+    if (currentGameStatus != GameStatus::GAME) break;
+    saveState(state);
+    EXPECT_EQ(memcmp(next.grid, state.current.grid, sizeof(next.grid)), 0);
+    ASSERT_EQ(getPreview(pieces), 4);
+    EXPECT_EQ(memcmp(pieces, before + 1, 3), 0);
+  }
+}
+
+TEST_F(TetrisLogicTest, preview_no_allocation) {
+  setSeed(2);
+  userInput(UserAction_t::Start, false);
+  Shape* current = currentShape;
+  Shape* next = nextShape;
+  GameState_t state;
+  saveState(state);
+
+  // spawns and loads fill the same shapes
+  for (int i = 0; i < 20 && currentGameStatus == GameStatus::GAME; i++) {
+    userInput(UserAction_t::HardDrop, false);
+    EXPECT_EQ(currentShape, current);
+    EXPECT_EQ(nextShape, next);
+  }
+  ASSERT_TRUE(loadState(state));
+  EXPECT_EQ(currentShape, current);
+  EXPECT_EQ(nextShape, next);
+}
+
+TEST_F(TetrisLogicTest, preview_save_load) {
+  setPreviewSize(5);
+  setSeed(21);
+  userInput(UserAction_t::Start, false);
+  for (int i = 0; i < 30; i++) {
+    playSameInput(*this, i);
+  }
+  GameState_t state;
+  saveState(state);
+  EXPECT_EQ(state.previewSize, 5);
+
+  // queue and bag come with state, whatever preview of engine
+  TetrisLogic restored;
+  ASSERT_TRUE(restored.loadState(state));
+  EXPECT_EQ(restored.getPreviewSize(), 5);
+  EXPECT_TRUE(sameState(restored));
+  for (int i = 0; i < 300; i++) {
+    playSameInput(*this, i);
+    playSameInput(restored, i);
+    ASSERT_TRUE(sameState(restored)) << "input " << i;
+  }
+
+  // new game keeps preview of loaded one
+  TetrisLogic fresh;
+  fresh.setPreviewSize(3);
+  fresh.saveState(state);
+  EXPECT_EQ(state.previewSize, 3);
+  ASSERT_TRUE(restored.loadState(state));
+  restored.userInput(UserAction_t::Start, false);
+  uint8_t pieces[PREVIEW_SIZE];
+  EXPECT_EQ(restored.getPreview(pieces), 3);
+}
+
+TEST(TetrisBoardTest, board_size) {
+  EXPECT_EQ(TetrisLogic(2, 3).getWidth(), MIN_FIELD_SIZE);
+  EXPECT_EQ(TetrisLogic(2, 3).getHeight(), MIN_FIELD_SIZE);
+  EXPECT_EQ(TetrisLogic(1000, 30).getWidth(), MAX_FIELD_WIDTH);
+  EXPECT_TRUE(TetrisLogic().isClassicBoard());
+
+  const UserAction_t actions[] = {UserAction_t::Left, UserAction_t::Right,
+                                  UserAction_t::Action, UserAction_t::Down,
+                                  UserAction_t::HardDrop};
+  const int sizes[][2] = {{8, 16}, {40, 80}};
+  for (const auto& size : sizes) {
+    TetrisLogic game(size[0], size[1]);
+    RandomGenerator random(7);
+    game.setSeed(7);
+    game.userInput(UserAction_t::Start, false);
+
+    // pieces stay inside board, features follow its height
+    int games = 0;
+    for (int i = 0; i < 5000; i++) {
+      if (game.getCurrentGameStatus() != GameStatus::GAME) {
+        game.userInput(UserAction_t::Start, false);
+        games++;
+      } else {
+        game.userInput(actions[random.next(5)], false);
+      }
+      const GameInfo_t& gameInfo = game.getGameInfo();
+      ASSERT_EQ(gameInfo.width, size[0]);
+      ASSERT_EQ(gameInfo.height, size[1]);
+      for (int x = 0; x < size[0]; x++) {
+        ASSERT_LE(game.getBoardFeatures().heights[x], size[1]);
+      }
+    }
+    EXPECT_GT(games, 0);
+    EXPECT_FALSE(game.isClassicBoard());
+
+    // fixed size formats are only for classic board
+    GameState_t state;
+    game.saveState(state);
+    EXPECT_NE(state.magic, static_cast<uint32_t>(STATE_MAGIC));
+    EXPECT_FALSE(TetrisLogic().loadState(state));
+    uint8_t buffer[1024];
+    EXPECT_EQ(game.exportObservation(buffer, sizeof(buffer),
+                                     ObservationLayout::BYTES),
+              0u);
+  }
+}
+
+TEST(TetrisBoardTest, hash_on_large_board) {
+  TetrisLogic game(40, 80);
+  game.setSeed(3);
+  game.userInput(UserAction_t::Start, false);
+  uint64_t hash = game.getHash();
+  game.userInput(UserAction_t::Left, false);
+  EXPECT_NE(game.getHash(), hash);
+  game.userInput(UserAction_t::Right, false);
+  EXPECT_EQ(game.getHash(), hash);
+
+  // locked cells out of classic board are keyed too
+  game.userInput(UserAction_t::HardDrop, false);
+  EXPECT_NE(game.getHash(), hash);
+}
@@ -3,11 +3,46 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "../retro_games/tetris/tetrisLogic.hpp"
 
 namespace s21 {
 
-class TetrisLogicTest : public ::testing::Test, public TetrisLogic {};
+class TetrisLogicTest : public ::testing::Test, public TetrisLogic {
+ protected:
+  // features by full scan of board without falling piece
+  void expectBoardFeatures() {
+    GameState_t state;
+    saveState(state);
+    const GameState_t::Shape_t& shape = state.current;
+    for (int i = 0; i < shape.height && state.hasShapes; i++) {
+      for (int j = 0; j < shape.width; j++) {
+        int y = shape.y - (shape.height - 1 - i);
+        if (shape.grid[i][j] && y >= 0) state.field[y][shape.x + j] = 0;
+      }
+    }
+
+    int totalHoles = 0;
+    for (int x = 0; x < FIELD_WIDTH; x++) {
+      int y = 0;
+      while (y < FIELD_HEIGHT && !state.field[y][x]) y++;
+      EXPECT_EQ(boardFeatures.heights[x], FIELD_HEIGHT - y);
+      int holes = 0;
+      for (; y < FIELD_HEIGHT; y++) holes += !state.field[y][x];
+      EXPECT_EQ(boardFeatures.holes[x], holes);
+      totalHoles += holes;
+    }
+    EXPECT_EQ(boardFeatures.totalHoles, totalHoles);
+  }
+
+  bool sameState(const GameLogic& other) const {
+    GameState_t a, b;
+    saveState(a);
+    other.saveState(b);
+    return memcmp(&a, &b, sizeof(GameState_t)) == 0;
+  }
+};
 
 }  // namespace s21
 
@@ -0,0 +1,144 @@
+#include "testTournament.hpp"
+
+#include <set>
+#include <sstream>
+
+using namespace s21;
+
+TEST_F(TournamentTest, round_robin) {
+  Tournament tournament(tetrisPolicies(), tetrisOptions(1));
+  tournament.run();
+
+  // every pair on every seed, sides change by seed
+  const std::vector<TournamentGame>& games = tournament.getGames();
+  ASSERT_EQ(games.size(), 6u);
+  EXPECT_EQ(games[0].policies[0], 0);
+  EXPECT_EQ(games[0].policies[1], 1);
+  EXPECT_EQ(games[1].policies[0], 1);
+  EXPECT_EQ(games[1].policies[1], 0);
+  EXPECT_EQ(games[1].seed, 2u);
+
+  double elo = 0;
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(tournament.getStanding(i).games, 4);
+    elo += tournament.getStanding(i).elo;
+  }
+  EXPECT_NEAR(elo, 3 * ELO_START, 1e-6);
+
+  // blind bot loses to both
+  const PolicyStanding& blind = tournament.getStanding(1);
+  EXPECT_EQ(blind.losses, 4);
+  EXPECT_EQ(blind.points, 0);
+  EXPECT_LT(blind.elo, ELO_START);
+  EXPECT_EQ(tournament.getRanking().back(), 1);
+  EXPECT_GT(tournament.getStanding(0).meanLines(), 0);
+  EXPECT_GT(tournament.getStanding(0).meanTicks(),
+            tournament.getStanding(1).meanTicks());
+}
+
+TEST_F(TournamentTest, same_result_by_threads) {
+  Tournament single(tetrisPolicies(), tetrisOptions(1));
+  Tournament parallel(tetrisPolicies(), tetrisOptions(4));
+  single.run();
+  parallel.run();
+
+  ASSERT_EQ(single.getGames().size(), parallel.getGames().size());
+  for (size_t i = 0; i < single.getGames().size(); i++) {
+    const TournamentGame& first = single.getGames()[i];
+    const TournamentGame& second = parallel.getGames()[i];
+    EXPECT_EQ(first.winner, second.winner);
+    for (int j = 0; j < 2; j++) {
+      EXPECT_EQ(first.policies[j], second.policies[j]);
+      EXPECT_EQ(first.score[j], second.score[j]);
+      EXPECT_EQ(first.ticks[j], second.ticks[j]);
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(single.getStanding(i).elo, parallel.getStanding(i).elo);
+  }
+}
+
+TEST_F(TournamentTest, snake_game) {
+  TournamentGame game = Tournament::playGame(
+      GameType::SNAKE, snakePolicy("path"), idlePolicy("idle"), 1, 200);
+  EXPECT_EQ(game.winner, 0);
+  EXPECT_GT(game.score[0], 0);
+  EXPECT_EQ(game.score[1], 0);
+  EXPECT_EQ(game.ticks[1], 0);
+  EXPECT_LE(game.ticks[0], 200);
+
+  game = Tournament::playGame(GameType::SNAKE, idlePolicy("idle"),
+                              idlePolicy("idle"), 1, 200);
+  EXPECT_EQ(game.winner, -1);
+}
+
+TEST_F(TournamentTest, swiss) {
+  std::vector<TournamentPolicy> policies = {
+      snakePolicy("path"), idlePolicy("idle"), snakePolicy("path 2"),
+      idlePolicy("idle 2"), snakePolicy("path 3")};
+  TournamentOptions options;
+  options.game = GameType::SNAKE;
+  options.format = TournamentFormat::SWISS;
+  options.seeds = {1};
+  options.maxTicks = 200;
+  Tournament tournament(std::move(policies), options);
+  tournament.run();
+
+  // log2 of 5 policies gives 3 rounds of 2 games and a bye
+  const std::vector<TournamentGame>& games = tournament.getGames();
+  ASSERT_EQ(games.size(), 6u);
+  std::set<std::pair<int, int>> pairs;
+  for (size_t round = 0; round < 3; round++) {
+    std::set<int> players;
+    for (size_t i = round * 2; i < round * 2 + 2; i++) {
+      EXPECT_EQ(games[i].round, static_cast<int>(round));
+      auto [first, second] = games[i].policies;
+      EXPECT_TRUE(players.insert(first).second);
+      EXPECT_TRUE(players.insert(second).second);
+      EXPECT_TRUE(pairs.emplace(std::min(first, second),
+                                std::max(first, second))
+                      .second);
+    }
+  }
+  int byes = 0;
+  for (int i = 0; i < 5; i++) {
+    EXPECT_LE(tournament.getStanding(i).byes, 1);
+    byes += tournament.getStanding(i).byes;
+  }
+  EXPECT_EQ(byes, 3);
+
+  // bye of the first round goes to the last policy
+  EXPECT_EQ(tournament.getStanding(4).byes, 1);
+  EXPECT_EQ(tournament.getRanking().back() % 2, 1);
+}
+
+TEST_F(TournamentTest, reports) {
+  std::vector<TournamentPolicy> policies = {snakePolicy("a,\"b\""),
+                                            idlePolicy("idle")};
+  TournamentOptions options;
+  options.game = GameType::SNAKE;
+  options.seeds = {1, 2};
+  options.maxTicks = 100;
+  Tournament tournament(std::move(policies), options);
+  tournament.run();
+
+  std::ostringstream csv;
+  tournament.writeCsv(csv);
+  std::istringstream lines(csv.str());
+  std::string line;
+  std::getline(lines, line);
+  EXPECT_EQ(line.rfind("rank,policy,elo,points,games,wins", 0), 0u);
+  std::getline(lines, line);
+  EXPECT_EQ(line.rfind("1,\"a,\"\"b\"\"\",", 0), 0u);
+  std::getline(lines, line);
+  EXPECT_EQ(line.rfind("2,idle,", 0), 0u);
+  EXPECT_FALSE(std::getline(lines, line));
+
+  std::ostringstream json;
+  tournament.writeJson(json);
+  std::string text = json.str();
+  EXPECT_NE(text.find("\"game\": \"snake\""), std::string::npos);
+  EXPECT_NE(text.find("\"seeds\": [1, 2]"), std::string::npos);
+  EXPECT_NE(text.find("\"policy\": \"a,\\\"b\\\"\""), std::string::npos);
+  EXPECT_NE(text.find("\"winner\": \"a,\\\"b\\\"\""), std::string::npos);
+}
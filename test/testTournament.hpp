@@ -0,0 +1,60 @@
+#ifndef TEST_TOURNAMENT_HPP
+#define TEST_TOURNAMENT_HPP
+
+#include <gtest/gtest.h>
+
+#include "../controller/tournament.hpp"
+#include "../retro_games/snake/snakeBot.hpp"
+#include "../retro_games/tetris/tetrisBot.hpp"
+
+namespace s21 {
+
+// bot which never moves
+class IdleBot : public GameBot {
+ public:
+  bool nextAction(const GameLogic& game, UserAction_t& action) override {
+    (void)game;
+    (void)action;
+    return false;
+  }
+};
+
+// policies of tests, scores of games are not saved
+class TournamentTest : public ::testing::Test {
+ protected:
+  void SetUp() override { GameLogic::setHighScoreStorage(false); }
+  void TearDown() override { GameLogic::setHighScoreStorage(true); }
+
+  static TournamentPolicy tetrisPolicy(const std::string& name,
+                                       TetrisWeights weights) {
+    return {name, [weights]() {
+              return std::make_unique<TetrisBot>(1, weights);
+            }};
+  }
+
+  static TournamentPolicy snakePolicy(const std::string& name) {
+    return {name, []() { return std::make_unique<SnakeBot>(); }};
+  }
+
+  static TournamentPolicy idlePolicy(const std::string& name) {
+    return {name, []() { return std::make_unique<IdleBot>(); }};
+  }
+
+  // bot with zero weights takes the first placement and tops out soon
+  static std::vector<TournamentPolicy> tetrisPolicies() {
+    return {tetrisPolicy("default", {}), tetrisPolicy("blind", {0, 0, 0, 0}),
+            tetrisPolicy("flat", {-0.8, 0.76, -0.36, -0.35})};
+  }
+
+  static TournamentOptions tetrisOptions(int threads) {
+    TournamentOptions options;
+    options.seeds = {1, 2};
+    options.maxTicks = 300;
+    options.threads = threads;
+    return options;
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_TOURNAMENT_HPP
@@ -0,0 +1,198 @@
+#include "testVersus.hpp"
+
+#include <cstring>
+
+#include "../retro_games/tetris/tetrisBot.hpp"
+
+using namespace s21;
+
+TEST_F(TetrisVersusTest, start) {
+  EXPECT_EQ(getBoardsCount(), 3);
+  EXPECT_TRUE(isFinished());
+  setSeed(7);
+  setPreviewSize(4);
+  userInput(UserAction_t::Start, false);
+  EXPECT_FALSE(isFinished());
+  EXPECT_EQ(getWinner(), -1);
+
+  // all boards get the same pieces
+  GameState_t player;
+  saveState(player);
+  for (int i = 1; i < getBoardsCount(); i++) {
+    GameState_t state;
+    getBoard(i).saveState(state);
+    EXPECT_EQ(getBoard(i).getCurrentGameStatus(), GameStatus::GAME);
+    EXPECT_EQ(memcmp(&state.current, &player.current, sizeof(state.current)),
+              0);
+    EXPECT_EQ(memcmp(&state.next, &player.next, sizeof(state.next)), 0);
+  }
+
+  // and the same queue of preview
+  uint8_t pieces[PREVIEW_SIZE];
+  ASSERT_EQ(getPreview(pieces), 4);
+  for (int i = 1; i < getBoardsCount(); i++) {
+    uint8_t other[PREVIEW_SIZE];
+    ASSERT_EQ(getBoard(i).getPreview(other), 4);
+    EXPECT_EQ(memcmp(pieces, other, 4), 0);
+  }
+
+  // count of boards is limited
+  EXPECT_EQ(TetrisVersus(1).getBoardsCount(), 2);
+  EXPECT_EQ(TetrisVersus(100).getBoardsCount(), MAX_VERSUS_BOARDS);
+}
+
+TEST_F(TetrisVersusTest, garbage_to_next_board) {
+  startWithLines(4);
+  userInput(UserAction_t::HardDrop, false);
+  EXPECT_EQ(getGameInfo().score, 1500);
+  EXPECT_EQ(getSentLines(0), 4);
+  EXPECT_EQ(lockedHeight(1), 4);
+  EXPECT_EQ(lockedHeight(2), 0);
+
+  // one hole in each row of garbage
+  const BoardFeatures& features = getBoard(1).getBoardFeatures();
+  int full = 0;
+  for (int x = 0; x < FIELD_WIDTH; x++) {
+    full += features.heights[x] == 4;
+  }
+  EXPECT_EQ(full, FIELD_WIDTH - 1);
+}
+
+TEST_F(TetrisVersusTest, garbage_by_lines) {
+  // single line sends nothing, two lines send one row
+  startWithLines(1);
+  userInput(UserAction_t::HardDrop, false);
+  EXPECT_EQ(getSentLines(0), 0);
+  EXPECT_EQ(lockedHeight(1), 0);
+
+  startWithLines(2);
+  userInput(UserAction_t::HardDrop, false);
+  EXPECT_EQ(getSentLines(0), 1);
+  EXPECT_EQ(lockedHeight(1), 1);
+
+  startWithLines(3);
+  userInput(UserAction_t::HardDrop, false);
+  EXPECT_EQ(getSentLines(0), 2);
+}
+
+TEST_F(TetrisVersusTest, garbage_skips_board_out) {
+  startWithLines(2);
+  knockOut(1);
+  EXPECT_EQ(getBoard(1).getCurrentGameStatus(), GameStatus::GAME_OVER);
+  userInput(UserAction_t::HardDrop, false);
+  EXPECT_EQ(lockedHeight(2), 1);
+  EXPECT_FALSE(isFinished());
+}
+
+TEST_F(TetrisVersusTest, player_wins) {
+  startWithLines(0);
+  knockOut(1);
+  gameTick();
+  EXPECT_FALSE(isFinished());
+  knockOut(2);
+  gameTick();
+  EXPECT_TRUE(isFinished());
+  EXPECT_EQ(getWinner(), 0);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::WIN);
+
+  // new match on start
+  userInput(UserAction_t::Start, false);
+  EXPECT_FALSE(isFinished());
+  EXPECT_EQ(getBoard(1).getCurrentGameStatus(), GameStatus::GAME);
+}
+
+TEST_F(TetrisVersusTest, match_goes_on_after_player) {
+  startWithLines(0);
+  knockOut(0);
+  gameTick();
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME_OVER);
+  EXPECT_FALSE(isFinished());
+
+  // the others play until one is left
+  uint64_t hash = getBoard(1).getHash();
+  gameTick();
+  EXPECT_NE(getBoard(1).getHash(), hash);
+  knockOut(1);
+  gameTick();
+  EXPECT_TRUE(isFinished());
+  EXPECT_EQ(getWinner(), 2);
+  EXPECT_EQ(getCurrentGameStatus(), GameStatus::GAME_OVER);
+}
+
+TEST_F(TetrisVersusTest, pause_stops_match) {
+  startWithLines(0);
+  userInput(UserAction_t::Pause, false);
+  uint64_t hash = getBoard(1).getHash();
+  for (int i = 0; i < 10; i++) {
+    gameTick();
+  }
+  EXPECT_EQ(getBoard(1).getHash(), hash);
+  userInput(UserAction_t::Pause, false);
+  gameTick();
+  EXPECT_NE(getBoard(1).getHash(), hash);
+}
+
+TEST_F(TetrisVersusTest, pause_of_two_boards) {
+  TetrisVersus match(2);
+  match.setSeed(3);
+  match.userInput(UserAction_t::Start, false);
+  match.gameTick();
+  match.userInput(UserAction_t::Pause, false);
+  EXPECT_FALSE(match.isFinished());
+  EXPECT_EQ(match.getWinner(), -1);
+  EXPECT_EQ(match.getCurrentGameStatus(), GameStatus::PAUSE);
+
+  match.userInput(UserAction_t::Pause, false);
+  EXPECT_EQ(match.getCurrentGameStatus(), GameStatus::GAME);
+  int x = 0;
+  int y = 0;
+  match.getFocus(x, y);
+  match.gameTick();
+  int fallenX = 0;
+  int fallenY = 0;
+  match.getFocus(fallenX, fallenY);
+  EXPECT_EQ(fallenY, y + 1);
+  EXPECT_FALSE(match.isFinished());
+}
+
+TEST_F(TetrisVersusTest, match_is_not_restored) {
+  startWithLines(0);
+  GameState_t state;
+  saveState(state);
+  EXPECT_EQ(state.magic, static_cast<uint32_t>(STATE_MAGIC));
+  EXPECT_FALSE(loadState(state));
+
+  std::vector<GameInfo_t> views = getOpponentViews(FIELD_WIDTH, FIELD_HEIGHT);
+  ASSERT_EQ(views.size(), 2u);
+  EXPECT_EQ(views[0].pause, 0);
+  knockOut(2);
+  views = getOpponentViews(FIELD_WIDTH, FIELD_HEIGHT);
+  EXPECT_EQ(views[1].pause, 1);
+}
+
+// match of bots on all boards runs by ticks alone
+static void playMatch(TetrisVersus& match, uint64_t seed, int ticks) {
+  match.setBot(0, std::make_unique<TetrisBot>(1));
+  match.setSeed(seed);
+  match.userInput(UserAction_t::Start, false);
+  for (int i = 0; i < ticks && !match.isFinished(); i++) {
+    match.gameTick();
+  }
+}
+
+TEST_F(TetrisVersusTest, same_seed_same_match) {
+  TetrisVersus first(4);
+  TetrisVersus second(4);
+  const int ticks = 400;
+  playMatch(first, 9, ticks);
+  playMatch(second, 9, ticks);
+
+  int sent = 0;
+  for (int i = 0; i < first.getBoardsCount(); i++) {
+    EXPECT_EQ(first.getBoard(i).getHash(), second.getBoard(i).getHash());
+    EXPECT_EQ(first.getSentLines(i), second.getSentLines(i));
+    sent += first.getSentLines(i);
+  }
+  EXPECT_EQ(first.getWinner(), second.getWinner());
+  EXPECT_GT(sent, 0);
+}
@@ -0,0 +1,45 @@
+#ifndef TEST_VERSUS_HPP
+#define TEST_VERSUS_HPP
+
+#include <gtest/gtest.h>
+
+#include "../retro_games/tetris/tetrisVersus.hpp"
+
+namespace s21 {
+
+// match of player and two bots, scores of test are not saved
+class TetrisVersusTest : public ::testing::Test, public TetrisVersus {
+ protected:
+  TetrisVersusTest() : TetrisVersus(3) {}
+  void SetUp() override { GameLogic::setHighScoreStorage(false); }
+  void TearDown() override { GameLogic::setHighScoreStorage(true); }
+
+  // new match, bottom lines of board 0 are full
+  void startWithLines(int lines) {
+    userInput(UserAction_t::Terminate, false);
+    setSeed(1);
+    userInput(UserAction_t::Start, false);
+    GameState_t state;
+    saveState(state);
+    for (int y = FIELD_HEIGHT - lines; y < FIELD_HEIGHT; y++) {
+      for (int x = 0; x < FIELD_WIDTH; x++) {
+        state.field[y][x] = 1;
+      }
+    }
+    TetrisLogic::loadState(state);
+  }
+
+  // locked cells of board by its features
+  int lockedHeight(int index) const {
+    return getBoard(index).getBoardFeatures().maxHeight;
+  }
+
+  void knockOut(int index) {
+    board(index).addGarbage(FIELD_HEIGHT, 0);
+    board(index).addGarbage(FIELD_HEIGHT, 0);
+  }
+};
+
+}  // namespace s21
+
+#endif  // TEST_VERSUS_HPP
@@ -0,0 +1,169 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "../controller/tournament.hpp"
+#include "../retro_games/snake/snakeBot.hpp"
+#include "../retro_games/tetris/tetrisBot.hpp"
+
+using namespace s21;
+
+#define DEFAULT_SEEDS 8
+
+static TournamentPolicy tetrisPolicy(const std::string& name,
+                                     TetrisWeights weights) {
+  // bot of one thread, games run in parallel instead
+  return {name,
+          [weights]() { return std::make_unique<TetrisBot>(1, weights); }};
+}
+
+static TournamentPolicy snakePolicy(const std::string& name,
+                                    SnakeBot::Mode mode) {
+  return {name, [mode]() { return std::make_unique<SnakeBot>(mode); }};
+}
+
+// "<name>" or "<name>=<height>,<lines>,<holes>,<bumpiness>"
+static bool parseTetrisPolicy(const std::string& text,
+                              std::vector<TournamentPolicy>& policies) {
+  size_t equal = text.find('=');
+  TetrisWeights weights;
+  bool isValid = equal != 0 && !text.empty();
+  if (isValid && equal != std::string::npos) {
+    isValid = sscanf(text.c_str() + equal + 1, "%lf,%lf,%lf,%lf",
+                     &weights.height, &weights.lines, &weights.holes,
+                     &weights.bumpiness) == 4;
+  }
+  if (isValid) {
+    policies.push_back(tetrisPolicy(text.substr(0, equal), weights));
+  }
+  return isValid;
+}
+
+static bool parseSnakePolicy(const std::string& text,
+                             std::vector<TournamentPolicy>& policies) {
+  bool isValid = text == "path" || text == "cycle";
+  if (isValid) {
+    policies.push_back(snakePolicy(text, text == "path"
+                                             ? SnakeBot::Mode::PATH
+                                             : SnakeBot::Mode::CYCLE));
+  }
+  return isValid;
+}
+
+static void addDefaultPolicies(GameType game,
+                               std::vector<TournamentPolicy>& policies) {
+  if (game == GameType::TETRIS) {
+    policies.push_back(tetrisPolicy("default", {}));
+    policies.push_back(tetrisPolicy("flat", {-0.8, 0.76, -0.36, -0.35}));
+    policies.push_back(tetrisPolicy("no_holes", {-0.51, 0.76, -0.9, -0.18}));
+    policies.push_back(tetrisPolicy("lines", {-0.3, 1.5, -0.3, -0.1}));
+  } else {
+    policies.push_back(snakePolicy("path", SnakeBot::Mode::PATH));
+    policies.push_back(snakePolicy("cycle", SnakeBot::Mode::CYCLE));
+  }
+}
+
+static bool writeReport(const Tournament& tournament, const char* path,
+                        bool isJson) {
+  std::ofstream file(path);
+  if (isJson) {
+    tournament.writeJson(file);
+  } else {
+    tournament.writeCsv(file);
+  }
+  return static_cast<bool>(file);
+}
+
+static void printStandings(const Tournament& tournament) {
+  std::cout << std::fixed << std::setprecision(1);
+  for (int index : tournament.getRanking()) {
+    const PolicyStanding& s = tournament.getStanding(index);
+    std::cout << std::setw(12) << s.name << "  elo " << s.elo << "  "
+              << s.wins << "/" << s.draws << "/" << s.losses << "  score "
+              << s.meanScore() << " +- " << s.scoreDeviation() << "  lines "
+              << s.meanLines() << "  ticks " << s.meanTicks() << std::endl;
+  }
+}
+
+int main(int argc, char** argv) {
+  TournamentOptions options;
+  std::vector<TournamentPolicy> policies;
+  int seeds = DEFAULT_SEEDS;
+  const char* csvPath = nullptr;
+  const char* jsonPath = nullptr;
+  bool isValid = argc > 1 && (!strcmp(argv[1], "tetris") ||
+                              !strcmp(argv[1], "snake"));
+  if (isValid) {
+    options.game = strcmp(argv[1], "tetris") ? GameType::SNAKE
+                                             : GameType::TETRIS;
+  }
+  for (int i = 2; i < argc && isValid; i += 2) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      isValid = false;
+    } else if (!strcmp(argv[i], "--swiss")) {
+      options.format = TournamentFormat::SWISS;
+      options.rounds = atoi(value);
+    } else if (!strcmp(argv[i], "--seeds")) {
+      seeds = atoi(value);
+      isValid = seeds > 0;
+    } else if (!strcmp(argv[i], "--ticks")) {
+      options.maxTicks = atoi(value);
+      isValid = options.maxTicks > 0;
+    } else if (!strcmp(argv[i], "--threads")) {
+      options.threads = atoi(value);
+    } else if (!strcmp(argv[i], "--policy")) {
+      isValid = options.game == GameType::TETRIS
+                    ? parseTetrisPolicy(value, policies)
+                    : parseSnakePolicy(value, policies);
+    } else if (!strcmp(argv[i], "--csv")) {
+      csvPath = value;
+    } else if (!strcmp(argv[i], "--json")) {
+      jsonPath = value;
+    } else {
+      isValid = false;
+    }
+  }
+  if (!isValid) {
+    std::cerr << "usage: " << argv[0]
+              << " <tetris|snake> [--swiss <rounds>] [--seeds <count>]"
+                 " [--ticks <count>] [--threads <count>] [--csv <file>]"
+                 " [--json <file>] [--policy <policy>]...\n"
+                 "  tetris policy: <name>[=<height>,<lines>,<holes>,"
+                 "<bumpiness>]\n"
+                 "  snake policy: path|cycle"
+              << std::endl;
+    return 1;
+  }
+  if (policies.empty()) {
+    addDefaultPolicies(options.game, policies);
+  }
+  // the same seeds on every run, so reports can be compared
+  for (int i = 1; i <= seeds; i++) {
+    options.seeds.push_back(i);
+  }
+
+  GameLogic::setHighScoreStorage(false);
+  Tournament tournament(std::move(policies), options);
+  auto start = std::chrono::steady_clock::now();
+  tournament.run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  printStandings(tournament);
+  std::cout << tournament.getGames().size() << " games, " << elapsed.count()
+            << " s" << std::endl;
+  bool isWritten = true;
+  if (csvPath && !writeReport(tournament, csvPath, false)) {
+    std::cerr << "failed to write " << csvPath << std::endl;
+    isWritten = false;
+  }
+  if (jsonPath && !writeReport(tournament, jsonPath, true)) {
+    std::cerr << "failed to write " << jsonPath << std::endl;
+    isWritten = false;
+  }
+  return isWritten ? 0 : 1;
+}
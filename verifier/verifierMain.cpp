@@ -0,0 +1,49 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+#include "../controller/replayVerifier.hpp"
+
+using namespace s21;
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0]
+              << " <replays directory>|<replay file> [threads]" << std::endl;
+    return 1;
+  }
+  int threads = argc > 2 ? atoi(argv[2]) : 0;
+
+  GameLogic::setHighScoreStorage(false);
+  ReplayVerifier verifier(threads);
+  std::vector<std::string> paths;
+  std::vector<ReplayResult> results;
+  auto start = std::chrono::steady_clock::now();
+  if (std::filesystem::is_regular_file(argv[1])) {
+    // one long replay is split between threads by keyframes
+    paths.push_back(argv[1]);
+    results.push_back(verifier.verifySplit(argv[1]));
+  } else {
+    paths = ReplayVerifier::listReplays(argv[1]);
+    results = verifier.verify(paths);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  int failed = 0;
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i].verdict == ReplayVerdict::DIVERGED) {
+      std::cout << "diverged " << paths[i] << ": recorded score "
+                << results[i].recordedScore << ", replayed "
+                << results[i].score << std::endl;
+    } else if (results[i].verdict == ReplayVerdict::UNREADABLE) {
+      std::cout << "unreadable " << paths[i] << std::endl;
+    }
+    failed += results[i].verdict != ReplayVerdict::MATCH;
+  }
+
+  std::cout << results.size() << " replays, " << failed << " failed, "
+            << elapsed.count() << " s" << std::endl;
+  return failed ? 1 : 0;
+}